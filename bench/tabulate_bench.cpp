@@ -0,0 +1,495 @@
+/*
+ * Benchmarks of the tabulate renderer used by jamictl
+ *
+ * Every scenario runs at 10, 100, ... rows up to --max-rows (1M by default)
+ * and one JSON object is printed per run, e.g.:
+ *
+ *   tabulate_bench --max-rows 100000 print_table word_wrap > bench.json
+ */
+#include "tabulate.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// operator delete below frees what operator new got from malloc
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Allocation counters, every heap allocation of the process goes through
+// the replaced global operator new below
+static std::atomic<size_t> allocationCount {0};
+static std::atomic<size_t> allocatedBytes {0};
+
+void*
+operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+using Cells = std::vector<std::string>;
+
+// Input of a scenario, built before the measured part starts
+struct Input
+{
+    tabulate::Table table;
+    tabulate::Table nested;
+    std::shared_ptr<tabulate::TableInternal> internal;
+    std::vector<Cells> rows; // cells to add, built beforehand
+    std::string expected; // output the run has to reproduce
+};
+
+struct Scenario
+{
+    const char* name;
+    // Builds the input for the given number of rows
+    std::function<void(Input&, size_t)> setup;
+    // Measured part, returns the number of bytes produced
+    std::function<size_t(Input&, size_t)> run;
+};
+
+std::string
+hexId(size_t seed)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string result(40, '0');
+    for (auto& c : result) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        c = digits[(seed >> 33) & 0xf];
+    }
+    return result;
+}
+
+Cells
+contactRow(size_t i)
+{
+    return {std::to_string(i), hexId(i), "user" + std::to_string(i), "Contact " + std::to_string(i)};
+}
+
+// Cell of contactRow(), computed on its own
+std::string
+contactCell(size_t i, size_t column)
+{
+    switch (column) {
+    case 0:
+        return std::to_string(i);
+    case 1:
+        return hexId(i);
+    case 2:
+        return "user" + std::to_string(i);
+    default:
+        return "Contact " + std::to_string(i);
+    }
+}
+
+Cells
+wrapRow(size_t i)
+{
+    return {std::to_string(i),
+            "a fairly long conversation preview that does not fit in its column and has to be "
+            "word wrapped over several lines, message #"
+                + std::to_string(i)};
+}
+
+Cells
+multiByteRow(size_t i)
+{
+    return {std::to_string(i), "Zoë Ångström ✓", "日本語のテキスト " + std::to_string(i), "🎉 émoji"};
+}
+
+template<typename Rows>
+void
+fillTable(tabulate::Table& table, size_t rows, Rows makeRow)
+{
+    for (size_t i = 0; i < rows; ++i) {
+        auto cells = makeRow(i);
+        table.add_row({cells.begin(), cells.end()});
+    }
+}
+
+template<typename Rows>
+std::shared_ptr<tabulate::TableInternal>
+fillInternal(size_t rows, Rows makeRow)
+{
+    auto table = tabulate::TableInternal::create();
+    for (size_t i = 0; i < rows; ++i)
+        table->add_row(makeRow(i));
+    return table;
+}
+
+// Stream buffer counting the bytes written to it, which are dropped
+class CountingBuffer : public std::streambuf
+{
+public:
+    size_t count = 0;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize size) override
+    {
+        count += size;
+        return size;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        ++count;
+        return c;
+    }
+};
+
+size_t
+printInternal(Input& input, size_t)
+{
+    std::string buffer;
+    tabulate::Printer::print_table(buffer, *input.internal);
+    return buffer.size();
+}
+
+template<typename Exporter>
+Scenario
+exporterScenario(const char* name)
+{
+    return {name,
+            [](Input& input, size_t rows) { fillTable(input.table, rows, contactRow); },
+            [](Input& input, size_t) {
+                Exporter exporter;
+                return exporter.dump(input.table).size();
+            }};
+}
+
+// Stress test of concurrent rendering: every thread builds and prints a
+// table of its own while all of them print and export the same table, with a
+// nested table, whose formats are left to be resolved by the first print
+Scenario
+concurrentScenario()
+{
+    return {"concurrent",
+            [](Input& input, size_t rows) {
+                input.nested.add_row({"nested", "table"});
+                input.nested[0].format().font_color(tabulate::Color::green);
+                fillTable(input.table, rows, contactRow);
+                input.table.add_row({"", "", "", input.nested});
+                input.table[0].format().font_style({tabulate::FontStyle::bold});
+                input.table.column(1).format().width(20);
+
+                input.expected = input.table.str() + tabulate::MarkdownExporter().dump(input.table);
+                input.table.format().font_align(tabulate::FontAlign::left);
+                input.nested.format().font_align(tabulate::FontAlign::left);
+            },
+            [](Input& input, size_t rows) {
+                auto numThreads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+                std::atomic<size_t> bytes {0};
+                std::atomic<bool> failed {false};
+                std::vector<std::thread> threads;
+                for (unsigned t = 0; t < numThreads; ++t) {
+                    threads.emplace_back([&input, &bytes, &failed, rows, numThreads]() {
+                        tabulate::Table own;
+                        fillTable(own, rows / numThreads + 1, wrapRow);
+                        own.column(1).format().width(30);
+                        auto output = own.str();
+
+                        auto shared = input.table.str()
+                                      + tabulate::MarkdownExporter().dump(input.table);
+                        if (shared != input.expected)
+                            failed = true;
+                        bytes += output.size() + shared.size();
+                    });
+                }
+                for (auto& thread : threads)
+                    thread.join();
+
+                if (failed) {
+                    std::cerr << "concurrent: a thread rendered the shared table differently"
+                              << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+                return bytes.load();
+            }};
+}
+
+// Prints a printed table again after renaming the contact of the row in its
+// middle, which leaves the widths of the columns as they were
+size_t
+reprintTable(Input& input, size_t rows)
+{
+    input.table[rows / 2][3].set_text("Renamed");
+    return input.table.str().size();
+}
+
+std::vector<Scenario>
+scenarios()
+{
+    return {
+        {"add_row",
+         [](Input&, size_t) {},
+         [](Input& input, size_t rows) {
+             fillTable(input.table, rows, contactRow);
+             return size_t(0);
+         }},
+        {"add_rows",
+         [](Input& input, size_t rows) {
+             for (size_t i = 0; i < rows; ++i)
+                 input.rows.push_back(contactRow(i));
+         },
+         [](Input& input, size_t rows) {
+             input.table.reserve(rows, 4).add_rows(input.rows);
+             return size_t(0);
+         }},
+        {"compute_cell_dimensions",
+         [](Input& input, size_t rows) { input.internal = fillInternal(rows, contactRow); },
+         [](Input& input, size_t) {
+             return tabulate::Printer::compute_cell_dimensions(*input.internal).first.size();
+         }},
+        {"print_table",
+         [](Input& input, size_t rows) { input.internal = fillInternal(rows, contactRow); },
+         printInternal},
+        {"word_wrap",
+         [](Input& input, size_t rows) {
+             input.internal = fillInternal(rows, wrapRow);
+             input.internal->column(1).format().width(40);
+         },
+         printInternal},
+        {"truncate",
+         [](Input& input, size_t rows) {
+             input.internal = fillInternal(rows, wrapRow);
+             input.internal->column(1).format().width(40).overflow(tabulate::Overflow::truncate);
+         },
+         printInternal},
+        {"multi_byte",
+         [](Input& input, size_t rows) {
+             input.internal = fillInternal(rows, multiByteRow);
+             input.internal->format().multi_byte_characters(true);
+         },
+         printInternal},
+        {"nested",
+         [](Input& input, size_t rows) {
+             for (size_t i = 0; i < rows; ++i) {
+                 tabulate::Table contacts;
+                 contacts.add_row({"user" + std::to_string(i), hexId(i)});
+                 input.table.add_row({std::to_string(i), contacts});
+             }
+         },
+         [](Input& input, size_t) { return input.table.str().size(); }},
+        {"model_table",
+         [](Input&, size_t) {},
+         [](Input& input, size_t rows) {
+             input.table.add_rows(tabulate::make_table_model(rows, 4, contactCell));
+             return input.table.str().size();
+         }},
+        {"model_stream",
+         [](Input&, size_t) {},
+         [](Input&, size_t rows) {
+             CountingBuffer buffer;
+             std::ostream stream(&buffer);
+             {
+                 // Wide enough for the ids of up to 1M rows, nothing is sampled
+                 tabulate::TableStream table(stream);
+                 table.column_widths({9, 42, 13, 16});
+                 table.add_rows(tabulate::make_table_model(rows, 4, contactCell));
+             }
+             return buffer.count;
+         }},
+        {"model_viewport",
+         [](Input&, size_t) {},
+         [](Input& input, size_t rows) {
+             // Pages through the model as the pager does, a screen every
+             // hundredth of the table, holding the rows on the screen only
+             auto model = tabulate::make_table_model(rows, 4, contactCell);
+             tabulate::Viewport viewport(input.table, model, 23);
+             CountingBuffer buffer;
+             std::ostream stream(&buffer);
+             for (size_t i = 0; i < 100; ++i) {
+                 viewport.scroll_to(viewport.num_lines() * i / 100);
+                 viewport.print(stream);
+             }
+             return buffer.count;
+         }},
+        {"reprint",
+         [](Input& input, size_t rows) {
+             fillTable(input.table, rows, contactRow);
+             input.table.str();
+         },
+         reprintTable},
+        {"cached_reprint",
+         [](Input& input, size_t rows) {
+             fillTable(input.table.cache_rows(), rows, contactRow);
+             input.table.str();
+         },
+         reprintTable},
+        exporterScenario<tabulate::MarkdownExporter>("markdown_exporter"),
+        exporterScenario<tabulate::LatexExporter>("latex_exporter"),
+        exporterScenario<tabulate::AsciiDocExporter>("asciidoc_exporter"),
+        exporterScenario<tabulate::CsvExporter>("csv_exporter"),
+        exporterScenario<tabulate::TsvExporter>("tsv_exporter"),
+        exporterScenario<tabulate::JsonExporter>("json_exporter"),
+        exporterScenario<tabulate::NdjsonExporter>("ndjson_exporter"),
+        concurrentScenario(),
+    };
+}
+
+// Peak resident set size of the process so far, in kilobytes
+long
+peakRss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Runs in a process of its own, see main()
+void
+runScenario(const Scenario& scenario, size_t rows)
+{
+    Input input;
+    scenario.setup(input, rows);
+
+    auto allocations = allocationCount.load();
+    auto bytes = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    auto output = scenario.run(input, rows);
+    auto end = std::chrono::steady_clock::now();
+    allocations = allocationCount.load() - allocations;
+    bytes = allocatedBytes.load() - bytes;
+
+    std::printf("\n  {\"name\": \"%s\", \"rows\": %zu, \"seconds\": %.6f, \"allocations\": %zu, "
+                "\"allocated_bytes\": %zu, \"output_bytes\": %zu, \"peak_rss_kb\": %ld}",
+                scenario.name,
+                rows,
+                std::chrono::duration<double>(end - start).count(),
+                allocations,
+                bytes,
+                output,
+                peakRss());
+    std::fflush(stdout);
+}
+
+// Runs a scenario in a child process, whose peak RSS starts from the little
+// the parent uses instead of the peak of every earlier run
+bool
+forkScenario(const Scenario& scenario, size_t rows)
+{
+    std::fflush(stdout);
+    auto pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        runScenario(scenario, rows);
+        _exit(0);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::cerr << scenario.name << " failed at " << rows << " rows" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    size_t maxRows = 1000000;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-rows" && i + 1 < argc) {
+            maxRows = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << "usage: " << argv[0] << " [--max-rows N] [scenario...]" << std::endl
+                      << "scenarios:";
+            for (auto& scenario : scenarios())
+                std::cout << " " << scenario.name;
+            std::cout << std::endl;
+            return 0;
+        } else {
+            names.push_back(arg);
+        }
+    }
+
+    auto all = scenarios();
+    for (auto& name : names) {
+        auto known = std::any_of(all.begin(), all.end(), [&](const Scenario& scenario) {
+            return name == scenario.name;
+        });
+        if (!known) {
+            std::cerr << "unknown scenario: " << name << ", see " << argv[0] << " --help"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // Every run is measured in a process of its own, see forkScenario()
+    bool ok = true;
+    bool first = true;
+    std::printf("[");
+    for (size_t rows = 10; rows <= maxRows && ok; rows *= 10) {
+        for (auto& scenario : all) {
+            bool selected = names.empty();
+            for (auto& name : names)
+                selected |= name == scenario.name;
+            if (!selected)
+                continue;
+            if (!first)
+                std::printf(",");
+            first = false;
+            ok = forkScenario(scenario, rows);
+            if (!ok)
+                break;
+        }
+    }
+    std::printf("\n]\n");
+    return ok ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 #include <QObject>
 #include <qmap.h>
 #include <qobject.h>
@@ -16,6 +17,7 @@
 
 #include "api/call.h"
 #include "dringctrl.h"
+#include "pager.h"
 #include "tabulate.hpp"
 
 typedef struct AddedAccountInfo_
@@ -27,6 +29,84 @@ typedef struct AddedAccountInfo_
 
 AddedAccountInfo addedAccountInfo;
 
+// Listings measure their cells in display columns, so that aliases and
+// messages in CJK or with emoji line up and are truncated to the width of
+// their column, and those with borders start with a header row
+template<typename Listing, typename... Headers>
+static void
+setUpListing(Listing& listing, const Headers&... headers)
+{
+    listing.target().format().multi_byte_characters(true);
+    if (Listing::schema::theme == tabulate::BorderTheme::ascii)
+        listing.add_header(headers...);
+}
+
+// On a terminal, a listing too tall for it is paged unless page is false,
+// e.g., when it stays on screen for a prompt, otherwise it is streamed out,
+// its columns as wide as their widest cell, like scripts parse it
+// The cells of the rows are read from cell(row, column), with a column for
+// each column of the schema, and so each header. Callers pass a snapshot of
+// the listing, see ListingRows, which is its only full copy: the pager reads
+// the rows in its window from it, the stream reads it once to measure the
+// columns and once more to print it, a batch of rows at a time
+template<tabulate::BorderTheme Theme, typename... Columns, typename Cell, typename... Headers>
+static void
+showListing(size_t rows, const Cell& cell, bool page, const Headers&... headers)
+{
+    using Schema = tabulate::TableSchema<Theme, Columns...>;
+    auto model   = tabulate::make_table_model<Schema>(rows, cell);
+
+    if (page && Pager::available()) {
+        tabulate::TypedTable<Schema> listing;
+        setUpListing(listing, headers...);
+        Pager::show(listing.target(), model);
+        return;
+    }
+
+    tabulate::TypedTable<Schema, tabulate::TableStream> listing(std::cout);
+    setUpListing(listing, headers...);
+    listing.add_measured_rows(model);
+    listing.target().close();
+    std::cout << std::flush;
+}
+
+// Prints a listing, as a table with a header row or as plain columns
+// Columns are the columns of the schema of the listing, e.g., tabulate::Field
+// to align or truncate some of them
+template<typename... Columns, typename Cell, typename... Headers>
+static void
+printTypedListing(size_t rows, const Cell& cell, bool istable, bool page, const Headers&... headers)
+{
+    if (istable)
+        showListing<tabulate::BorderTheme::ascii, Columns...>(rows, cell, page, headers...);
+    else
+        showListing<tabulate::BorderTheme::none, Columns...>(rows, cell, page, headers...);
+}
+
+// Left aligned text column of a listing
+template<typename Header>
+using TextColumn = std::string;
+
+// Prints a listing of left aligned text columns, one per header
+template<typename Cell, typename... Headers>
+static void
+printListing(size_t rows, const Cell& cell, bool istable, bool page, const Headers&... headers)
+{
+    printTypedListing<TextColumn<Headers>...>(rows, cell, istable, page, headers...);
+}
+
+// Cells of a listing, copied out of lrc and of Dringctrl before it is shown
+// The pager reads the cells again on every redraw and search, on the thread
+// of the REPL, while the Qt thread can change or erase what they came from
+using ListingRows = std::vector<std::vector<std::string>>;
+
+// Cell function of a listing of rows, which must outlive the listing
+static auto
+listingCell(const ListingRows& rows)
+{
+    return [&rows](size_t row, size_t column) { return rows[row][column]; };
+}
+
 Dringctrl::Dringctrl(const char* prompt)
     : accountInfo_(nullptr)
 {
@@ -138,49 +218,40 @@ Dringctrl::createRingAccount(std::string display_name, std::string username, std
 }
 
 void
-Dringctrl::printAccounts(bool istable)
+Dringctrl::printAccounts(bool istable, bool page)
 {
-    tabulate::Table table;
-
     auto accounts = lrc_->getAccountModel().getAccountList();
     if (accounts.size() == 0)
         std::cout << "No accounts" << std::endl;
 
-    if (istable) {
-        table.add_row({"index", "accountId", "hash", "alias", "username"});
-        for (auto& cell : table[0]) {
-            cell.format()
-                .font_style({tabulate::FontStyle::underline})
-                .font_align(tabulate::FontAlign::center);
-        }
-    }
-    int i = 0;
-    for (auto account : accounts) {
-        const lrc::api::account::Info& accountInfo = lrc_->getAccountModel().getAccountInfo(account);
+    // getAccountInfo() throws for an account removed while the listing is
+    // shown, the accounts are read once beforehand
+    ListingRows rows;
+    rows.reserve(accounts.size());
+    for (const auto& account : accounts) {
+        const lrc::api::account::Info& accountInfo = lrc_->getAccountModel().getAccountInfo(
+            account);
 
         std::string indicator;
         if (accountInfo_)
             indicator = (!accountInfo_->id.compare(accountInfo.id)) ? "*" : " ";
 
-        table.add_row({std::to_string(i++) + indicator,
-                       accountInfo.id.toStdString(),
-                       accountInfo.profileInfo.uri.toStdString(),
-                       accountInfo.profileInfo.alias.toStdString(),
-                       accountInfo.registeredName.toStdString()});
+        rows.push_back({std::to_string(rows.size()) + indicator,
+                        accountInfo.id.toStdString(),
+                        accountInfo.profileInfo.uri.toStdString(),
+                        accountInfo.profileInfo.alias.toStdString(),
+                        accountInfo.registeredName.toStdString()});
     }
 
-    if (!istable)
-        table.format()
-            .corner_top_left("")
-            .corner_top_right("")
-            .corner_bottom_left("")
-            .corner_bottom_right("")
-            .border_top("")
-            .border_bottom("")
-            .border_left("")
-            .border_right("");
-
-    std::cout << table << std::endl;
+    printListing(rows.size(),
+                 listingCell(rows),
+                 istable,
+                 page,
+                 "index",
+                 "accountId",
+                 "hash",
+                 "alias",
+                 "username");
 }
 
 int
@@ -324,44 +395,25 @@ Dringctrl::call(std::string contact, bool audioOnly)
 void
 Dringctrl::getAllContacts(bool istable)
 {
-    tabulate::Table table;
-
-    if (istable) {
-        table.add_row({"username", "hash"});
-        for (auto& cell : table[0]) {
-            cell.format()
-                .font_style({tabulate::FontStyle::underline})
-                .font_align(tabulate::FontAlign::center);
-        }
-    }
-
-    auto contacts = accountInfo_->contactModel->getAllContacts();
+    const auto contacts = accountInfo_->contactModel->getAllContacts();
 
     if (contacts.size() == 0) {
         std::cout << "no contacts" << std::endl;
         return;
     }
 
-    for (auto contact : contacts) {
+    // Each contact with an uri is read from the contact model by its uri once,
+    // before the listing is shown
+    ListingRows rows;
+    for (const auto& contact : contacts) {
+        if (contact.profileInfo.uri.isEmpty())
+            continue;
         auto contactInfo = accountInfo_->contactModel->getContact(contact.profileInfo.uri);
-
-        if (!contactInfo.profileInfo.uri.isEmpty())
-            table.add_row({contactInfo.registeredName.toStdString(),
-                           contactInfo.profileInfo.uri.toStdString()});
+        rows.push_back(
+            {contactInfo.registeredName.toStdString(), contactInfo.profileInfo.uri.toStdString()});
     }
 
-    if (!istable)
-        table.format()
-            .corner_top_left("")
-            .corner_top_right("")
-            .corner_bottom_left("")
-            .corner_bottom_right("")
-            .border_top("")
-            .border_bottom("")
-            .border_left("")
-            .border_right("");
-
-    std::cout << table << std::endl;
+    printListing(rows.size(), listingCell(rows), istable, true, "username", "hash");
 }
 
 void
@@ -451,53 +503,41 @@ Dringctrl::printConversations(bool istable)
         return;
     }
 
-    auto conversations = accountInfo_->conversationModel->allFilteredConversations();
+    // lrc refilters and changes its conversations on the Qt thread while the
+    // listing is shown, the five cells of each one are copied first
+    const auto conversations = accountInfo_->conversationModel->allFilteredConversations();
     if (conversations.size() == 0)
         std::cout << "No conversations" << std::endl;
 
-    tabulate::Table table;
-
-    if (istable) {
-        table.add_row({"uid", "hash", "username", "alias", "lastInteraction"});
-        for (auto& cell : table[0]) {
-            cell.format()
-                .font_style({tabulate::FontStyle::underline})
-                .font_align(tabulate::FontAlign::center);
-        }
+    ListingRows rows;
+    rows.reserve(conversations.size());
+    for (const auto& conversation : conversations) {
+        const auto& contactUri = conversation.participants.front();
+        auto contactInfo       = accountInfo_->contactModel->getContact(contactUri);
+        auto lastMessage       = conversation.interactions.empty()
+                                     ? std::string()
+                                     : conversation.interactions.at(conversation.lastMessageUid)
+                                           .body.toStdString();
+        rows.push_back({conversation.uid.toStdString(),
+                        contactUri.toStdString(),
+                        contactInfo.registeredName.toStdString(),
+                        contactInfo.profileInfo.alias.toStdString(),
+                        lastMessage});
     }
 
-    for (auto conversation : conversations) {
-        auto contactUri  = conversation.participants.front().toStdString();
-        auto contactInfo = accountInfo_->contactModel->getContact(contactUri.c_str());
-        auto lastMessage = conversation.interactions.empty()
-                               ? ""
-                               : conversation.interactions.at(conversation.lastMessageUid)
-                                     .body.toStdString();
-
-        if (lastMessage.size() > 40) {
-            lastMessage.resize(40);
-            lastMessage.append("...");
-        }
-
-        table.add_row({conversation.uid.toStdString(),
-                       contactUri,
-                       contactInfo.registeredName.toStdString(),
-                       contactInfo.profileInfo.alias.toStdString(),
-                       lastMessage});
-    }
-
-    if (!istable)
-        table.format()
-            .corner_top_left("")
-            .corner_top_right("")
-            .corner_bottom_left("")
-            .corner_bottom_right("")
-            .border_top("")
-            .border_bottom("")
-            .border_left("")
-            .border_right("");
-
-    std::cout << table << std::endl;
+    // Long messages are cut to the width of their column, ending with an
+    // ellipsis, without splitting a character
+    using LastMessage = tabulate::Field<std::string, tabulate::FontAlign::left, 45>;
+    printTypedListing<std::string, std::string, std::string, std::string, LastMessage>(
+        rows.size(),
+        listingCell(rows),
+        istable,
+        true,
+        "uid",
+        "hash",
+        "username",
+        "alias",
+        "lastInteraction");
 }
 
 void
@@ -513,34 +553,12 @@ Dringctrl::printCalls(bool istable)
         return;
     }
 
-    tabulate::Table table;
-
-    if (istable) {
-        table.add_row({"index", "callId", "contact"});
-        for (auto& cell : table[0]) {
-            cell.format()
-                .font_style({tabulate::FontStyle::underline})
-                .font_align(tabulate::FontAlign::center);
-        }
-    }
-
-    int i = 0;
-    for (auto call : calls) {
-        table.add_row({std::to_string(i), call.first, call.second});
-    }
+    // slotCallEnded erases calls while the listing is shown
+    ListingRows rows;
+    for (const auto& call : calls)
+        rows.push_back({std::to_string(rows.size()), call.first, call.second});
 
-    if (!istable)
-        table.format()
-            .corner_top_left("")
-            .corner_top_right("")
-            .corner_bottom_left("")
-            .corner_bottom_right("")
-            .border_top("")
-            .border_bottom("")
-            .border_left("")
-            .border_right("");
-
-    std::cout << table << std::endl;
+    printListing(rows.size(), listingCell(rows), istable, true, "index", "callId", "contact");
 }
 
 void
@@ -21,7 +21,7 @@ public:
     void createRingAccount(std::string display_name, std::string username, std::string password);
     void getAllContacts(bool istable);
     std::string log(int index);
-    void printAccounts(bool istable);
+    void printAccounts(bool istable, bool page = true);
     void printConversations(bool istable);
     void printCalls(bool istable);
     void acceptCall();
@@ -102,7 +102,8 @@ Jamictl::chooseAccount()
 {
     while (true) {
         std::cout << "Choose the account to connect to " << std::endl;
-        dringctrl.printAccounts(false);
+        // Not paged, the list stays on screen for the prompt
+        dringctrl.printAccounts(false, false);
 
         std::string prompt = "[0-" + std::to_string(dringctrl.totalAccounts() - 1) + "]: ";
         std::string line   = readLine(prompt.c_str());
@@ -0,0 +1,186 @@
+#include "pager.h"
+
+#include <iostream>
+#include <string>
+
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+static const char* const HELP
+    = "j/k: line  space/b: page  g/G: top/bottom  /: search  n/N: next/previous  q: quit";
+
+static size_t
+terminalHeight()
+{
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 1)
+        return size.ws_row;
+    return 24;
+}
+
+// Reads a key, escape sequences such as arrow keys are returned whole
+static std::string
+readKey()
+{
+    // Several keys can be read at once, e.g., when text is pasted
+    static std::string pending;
+    if (pending.empty()) {
+        char buffer[64];
+        auto size = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (size <= 0)
+            return "q";
+        pending.assign(buffer, size);
+    }
+
+    size_t length = 1;
+    if (pending[0] == '\033')
+        length = pending.size();
+    else
+        while (length < pending.size() && (static_cast<unsigned char>(pending[length]) & 0xC0) == 0x80)
+            ++length;
+
+    auto key = pending.substr(0, length);
+    pending.erase(0, length);
+    return key;
+}
+
+// Reads the text to search for on the status line, empty if cancelled
+static std::string
+readSearch()
+{
+    std::string text;
+    while (true) {
+        std::cout << "\r\033[K/" << text << std::flush;
+        auto key = readKey();
+        if (key == "\r" || key == "\n")
+            return text;
+        if (key == "\033" || key == "\003")
+            return "";
+        if (key == "\177" || key == "\b") {
+            // Drop the last character, with its continuation bytes
+            while (!text.empty() && (static_cast<unsigned char>(text.back()) & 0xC0) == 0x80)
+                text.pop_back();
+            if (!text.empty())
+                text.pop_back();
+        } else if (key[0] != '\033' && static_cast<unsigned char>(key[0]) >= ' ') {
+            text += key;
+        }
+    }
+}
+
+// Raw mode on the alternate screen for as long as it exists, the terminal is
+// left as it was found when it is destroyed
+class PagerScreen
+{
+public:
+    PagerScreen()
+    {
+        tcgetattr(STDIN_FILENO, &saved_);
+        // Without ISIG, ^C is read as a key and quits like q does, instead of
+        // killing jamictl with the terminal left in raw mode on the alternate
+        // screen
+        auto raw = saved_;
+        raw.c_lflag &= ~(ICANON | ECHO | ISIG);
+        raw.c_cc[VMIN]  = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+
+        // Alternate screen, with lines wider than the terminal cut instead of
+        // wrapped so that every line of the table takes a single row
+        std::cout << "\033[?1049h\033[H\033[?7l";
+    }
+
+    ~PagerScreen()
+    {
+        std::cout << "\033[?7h\033[?1049l" << std::flush;
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_);
+    }
+
+    PagerScreen(const PagerScreen&) = delete;
+    PagerScreen& operator=(const PagerScreen&) = delete;
+
+private:
+    struct termios saved_;
+};
+
+bool
+Pager::available()
+{
+    return isatty(STDIN_FILENO) && isatty(STDOUT_FILENO);
+}
+
+void
+Pager::show(tabulate::Table& table)
+{
+    tabulate::Viewport viewport(table, terminalHeight() - 1);
+    show(viewport);
+}
+
+void
+Pager::show(tabulate::Table& table, const tabulate::TableModel& model)
+{
+    tabulate::Viewport viewport(table, model, terminalHeight() - 1);
+    show(viewport);
+}
+
+void
+Pager::show(tabulate::Viewport& viewport)
+{
+    // The window leaves the last line of the terminal to the status line
+    auto height = viewport.height() + 1;
+    if (viewport.num_lines() < height) {
+        viewport.set_height(viewport.num_lines());
+        viewport.print(std::cout);
+        std::cout << std::endl;
+        return;
+    }
+
+    // Restored on the way out, exceptions from the model or the layout
+    // included
+    PagerScreen screen;
+
+    tabulate::LiveView view(std::cout);
+    std::string search, status = HELP;
+    while (true) {
+        view.render(viewport);
+        std::cout << "\r\033[K" << status << std::flush;
+        status = HELP;
+
+        auto key = readKey();
+        if (key == "q" || key == "\033" || key == "\003")
+            break;
+
+        long page = static_cast<long>(viewport.height());
+        if (key == "j" || key == "\033[B" || key == "\r" || key == "\n")
+            viewport.scroll(1);
+        else if (key == "k" || key == "\033[A")
+            viewport.scroll(-1);
+        else if (key == " " || key == "f" || key == "\033[6~")
+            viewport.scroll(page);
+        else if (key == "b" || key == "\033[5~")
+            viewport.scroll(-page);
+        else if (key == "g" || key == "\033[H")
+            viewport.scroll_to(0);
+        else if (key == "G" || key == "\033[F")
+            viewport.scroll_to(viewport.num_lines());
+        else if (key == "/" || key == "n" || key == "N") {
+            if (key == "/")
+                search = readSearch();
+            if (search.empty())
+                continue;
+            auto found = key == "N" ? viewport.find_previous(search) : viewport.find(search);
+            if (!found)
+                status = "Pattern not found: " + search;
+        }
+
+        // Follow the terminal if it was resized
+        auto newHeight = terminalHeight();
+        if (newHeight != height) {
+            height = newHeight;
+            viewport.set_height(height - 1);
+            view.reset();
+            std::cout << "\033[H\033[J";
+        }
+    }
+}
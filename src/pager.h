@@ -0,0 +1,22 @@
+#pragma once
+
+#include "tabulate.hpp"
+
+// Shows tables taller than the terminal one screen at a time
+class Pager
+{
+public:
+    // Whether standard input and output are a terminal the user can page on
+    static bool available();
+
+    // Prints table, or lets the user browse it if it does not fit on the
+    // terminal: only the lines on the screen are rendered
+    static void show(tabulate::Table& table);
+
+    // Same for the rows of table followed by the rows of model, which are
+    // read from it as they are shown instead of being held in table
+    static void show(tabulate::Table& table, const tabulate::TableModel& model);
+
+private:
+    static void show(tabulate::Viewport& viewport);
+};
@@ -45,6 +45,8 @@ class AsciiDocExporter : public Exporter {
   static const char new_line = '\n';
 
 public:
+  using Exporter::dump;
+
   std::string dump(Table &table) override {
     std::stringstream ss;
     ss << add_alignment_header(table);
@@ -72,20 +74,11 @@ public:
 private:
   std::string add_formatted_cell(Cell &cell) const {
     std::stringstream ss;
-    auto format = cell.format();
+    const Format &format = cell.resolved_format();
     std::string cell_string = cell.get_text();
 
-    auto font_style = format.font_style_.value();
-
-    bool format_bold = false;
-    bool format_italic = false;
-    std::for_each(font_style.begin(), font_style.end(), [&](FontStyle &style) {
-      if (style == FontStyle::bold) {
-        format_bold = true;
-      } else if (style == FontStyle::italic) {
-        format_italic = true;
-      }
-    });
+    bool format_bold = (format.font_style_ & font_style_bit(FontStyle::bold)) != 0;
+    bool format_italic = (format.font_style_ & font_style_bit(FontStyle::italic)) != 0;
 
     if (format_bold) {
       ss << '*';
@@ -111,13 +104,13 @@ private:
     size_t column_count = table[0].size();
     size_t column_index = 0;
     for (auto &cell : table[0]) {
-      auto format = cell.format();
+      const Format &format = cell.resolved_format();
 
-      if (format.font_align_.value() == FontAlign::left) {
+      if (format.font_align_ == FontAlign::left) {
         ss << '<';
-      } else if (format.font_align_.value() == FontAlign::center) {
+      } else if (format.font_align_ == FontAlign::center) {
         ss << '^';
-      } else if (format.font_align_.value() == FontAlign::right) {
+      } else if (format.font_align_ == FontAlign::right) {
         ss << '>';
       }
 
@@ -0,0 +1,132 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#if !defined(TABULATE_DISABLE_THREADS)
+#include <system_error>
+#include <thread>
+#endif
+
+namespace tabulate {
+
+// Contiguous rows [first, last) of a table laid out or rendered by one thread
+struct RowBand {
+  size_t first;
+  size_t last;
+};
+
+// Rows per band below which a table is not worth splitting
+static const size_t min_band_rows = 4096;
+
+namespace details {
+
+inline std::atomic<size_t> &max_bands_override() {
+  static std::atomic<size_t> max_bands{0};
+  return max_bands;
+}
+
+} // namespace details
+
+// Splits tables into up to max_bands bands instead of one per core, e.g., so
+// that tests render tables in bands on single core machines too. Bands still
+// hold at least min_band_rows rows, and a max_bands of 0 goes back to one
+// band per core. With TABULATE_DISABLE_THREADS defined, bands are rendered
+// one after the other
+inline void set_max_bands(size_t max_bands) { details::max_bands_override() = max_bands; }
+
+// Splits the rows of a table into one band per core, each band holding at
+// least min_band_rows rows. Small tables, single core machines and builds
+// with TABULATE_DISABLE_THREADS defined get a single band, unless
+// set_max_bands() was called
+inline std::vector<RowBand> split_rows(size_t num_rows) {
+  size_t max_bands = details::max_bands_override();
+  if (max_bands == 0) {
+    max_bands = 1;
+#if !defined(TABULATE_DISABLE_THREADS)
+    static const size_t num_cores = std::max(1u, std::thread::hardware_concurrency());
+    max_bands = num_cores;
+#endif
+  }
+  auto num_bands = std::max<size_t>(1, std::min(max_bands, num_rows / min_band_rows));
+  std::vector<RowBand> bands;
+  bands.reserve(num_bands);
+  for (size_t i = 0; i < num_bands; ++i)
+    bands.push_back({num_rows * i / num_bands, num_rows * (i + 1) / num_bands});
+  return bands;
+}
+
+// Calls fn(band) for every band index, the first band on the calling thread
+// and every other one on a thread of its own, and returns once all are done.
+// Bands run on the calling thread too when no thread can be started. The
+// first exception thrown by fn is rethrown
+template <typename Function> void for_each_band(size_t num_bands, Function fn) {
+  std::vector<std::exception_ptr> errors(num_bands);
+  auto run = [&](size_t band) {
+    try {
+      fn(band);
+    } catch (...) {
+      errors[band] = std::current_exception();
+    }
+  };
+
+#if !defined(TABULATE_DISABLE_THREADS)
+  std::vector<std::thread> threads;
+  threads.reserve(num_bands);
+  for (size_t band = 1; band < num_bands; ++band) {
+    try {
+      threads.emplace_back(run, band);
+    } catch (const std::system_error &) {
+      run(band);
+    }
+  }
+  run(0);
+  for (auto &thread : threads)
+    thread.join();
+#else
+  for (size_t band = 0; band < num_bands; ++band)
+    run(band);
+#endif
+
+  for (auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+} // namespace tabulate
@@ -32,46 +32,46 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <iostream>
-#include <memory>
+#include <cstddef>
 #include <string>
 #include <tabulate/format.hpp>
 #include <tabulate/utf8.hpp>
 
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-#include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
-
-#include <vector>
-
 namespace tabulate {
 
+// A cell of a table
+// Cells are views over the storage of their table; the text and the format
+// of every cell live in TableInternal
 class Cell {
 public:
-  explicit Cell(std::shared_ptr<class Row> parent) : parent_(parent) {}
+  Cell(class TableInternal &table, size_t index) : table_(&table), index_(index) {}
 
-  void set_text(const std::string &text) { data_ = text; }
+  void set_text(const std::string &text);
 
-  const std::string &get_text() { return data_; }
+  std::string get_text() const;
 
-  size_t size() {
-    return get_sequence_length(data_, locale(), is_multi_byte_character_support_enabled());
+  size_t size() const {
+    return get_sequence_length(get_text(), locale(), is_multi_byte_character_support_enabled());
   }
 
-  std::string locale() { return *format().locale_; }
+  std::string locale() const { return resolved_format().locale_.str(); }
 
+  // Cell-level formatting
+  // Only the properties set here override the column, row and table formats
   Format &format();
 
-  bool is_multi_byte_character_support_enabled();
+  // Cell-level formatting, read only: unlike format(), the cell is left
+  // without a format of its own if it has none
+  const Format &format() const;
+
+  // Effective formatting of the cell, i.e., cell > column > row > table
+  const Format &resolved_format() const;
+
+  bool is_multi_byte_character_support_enabled() const;
 
 private:
-  std::string data_;
-  std::weak_ptr<class Row> parent_;
-  optional<Format> format_;
+  class TableInternal *table_;
+  size_t index_; // position of the cell in the cell storage of table_
 };
 
 } // namespace tabulate
@@ -36,5 +36,5 @@ SOFTWARE.
 
 namespace tabulate {
 
-enum class Color { none, grey, red, green, yellow, blue, magenta, cyan, white };
+enum class Color : unsigned char { none, grey, red, green, yellow, blue, magenta, cyan, white };
 }
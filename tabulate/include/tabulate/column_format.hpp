@@ -84,6 +84,9 @@ public:
   ColumnFormat &color(Color value);
   ColumnFormat &background_color(Color value);
 
+  // Overflow
+  ColumnFormat &overflow(Overflow value);
+
   // Locale
   ColumnFormat &multi_byte_characters(bool value);
   ColumnFormat &locale(const std::string &value);
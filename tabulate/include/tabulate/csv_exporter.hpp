@@ -0,0 +1,109 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <tabulate/exporter.hpp>
+
+namespace tabulate {
+
+// Comma-separated values as described in RFC 4180, one line per row.
+// Fields holding the delimiter, a quote or a line break are quoted.
+class CsvExporter : public Exporter {
+public:
+  class ExportOptions {
+  public:
+    ExportOptions &delimiter(char value) {
+      delimiter_ = value;
+      return *this;
+    }
+
+  private:
+    friend class CsvExporter;
+    char delimiter_{','};
+  };
+
+  ExportOptions &configure() { return options_; }
+
+  std::string dump(Table &table) override {
+    std::string result;
+    write(*table.table_, result, nullptr);
+    return result;
+  }
+
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
+  }
+
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    for (size_t i = 0; i < table.size(); ++i) {
+      for (size_t j = 0; j < table.row_size(i); ++j) {
+        if (j > 0)
+          buffer += options_.delimiter_;
+        auto cell = table.cell_index(i, j);
+        table.visit_cell_text(cell, [&](const char *data, size_t size) {
+          add_field(buffer, data, size);
+        });
+      }
+      buffer += '\n';
+      flush(buffer, stream, flush_size);
+    }
+  }
+
+  void add_field(std::string &buffer, const char *data, size_t size) const {
+    bool quoted = false;
+    for (size_t i = 0; i < size && !quoted; ++i) {
+      quoted = data[i] == options_.delimiter_ || data[i] == '"' || data[i] == '\n' ||
+               data[i] == '\r';
+    }
+    if (!quoted) {
+      buffer.append(data, size);
+      return;
+    }
+
+    buffer += '"';
+    for (size_t i = 0; i < size; ++i) {
+      if (data[i] == '"')
+        buffer += '"';
+      buffer += data[i];
+    }
+    buffer += '"';
+  }
+
+  ExportOptions options_;
+};
+
+} // namespace tabulate
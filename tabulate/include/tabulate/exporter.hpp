@@ -32,6 +32,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
+#include <ostream>
 #include <string>
 #include <tabulate/table.hpp>
 
@@ -39,7 +40,27 @@ namespace tabulate {
 
 class Exporter {
 public:
+  virtual ~Exporter() = default;
+
   virtual std::string dump(Table &table) = 0;
+
+  // Writes the exported table to stream
+  virtual void dump(Table &table, std::ostream &stream) {
+    auto result = dump(table);
+    stream.write(result.data(), static_cast<std::streamsize>(result.size()));
+  }
+
+protected:
+  // Streaming exporters render into buffer and hand it to stream in chunks of
+  // this size; without a stream the buffer holds the whole result
+  static const size_t flush_size = 64 * 1024;
+
+  static void flush(std::string &buffer, std::ostream *stream, size_t threshold = 0) {
+    if (stream == nullptr || buffer.size() < threshold)
+      return;
+    stream->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
 };
 
 } // namespace tabulate
@@ -35,5 +35,5 @@ SOFTWARE.
 
 namespace tabulate {
 
-enum class FontAlign { left, right, center };
+enum class FontAlign : unsigned char { left, right, center };
 }
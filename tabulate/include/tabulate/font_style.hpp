@@ -36,4 +36,7 @@ SOFTWARE.
 namespace tabulate {
 
 enum class FontStyle { bold, dark, italic, underline, blink, reverse, concealed, crossed };
+
+// Bit of a font style in a set of font styles, e.g., Format::font_style_
+inline unsigned font_style_bit(FontStyle style) { return 1u << static_cast<unsigned>(style); }
 }
@@ -33,23 +33,18 @@ SOFTWARE.
 */
 #pragma once
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstddef>
-#include <sstream>
+#include <cstdint>
 #include <string>
 #include <tabulate/color.hpp>
 #include <tabulate/font_align.hpp>
 #include <tabulate/font_style.hpp>
+#include <tabulate/interned_string.hpp>
+#include <tabulate/layout.hpp>
+#include <tabulate/overflow.hpp>
 #include <tabulate/utf8.hpp>
-
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-#include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
-
 #include <vector>
 
 namespace tabulate {
@@ -57,304 +52,305 @@ namespace tabulate {
 class Format {
 public:
   Format &width(size_t value) {
-    width_ = value;
+    set(Property::width, width_, value);
     return *this;
   }
 
   Format &height(size_t value) {
-    height_ = value;
+    set(Property::height, height_, value);
     return *this;
   }
 
   Format &padding(size_t value) {
-    padding_left_ = value;
-    padding_right_ = value;
-    padding_top_ = value;
-    padding_bottom_ = value;
+    set(Property::padding_left, padding_left_, value);
+    set(Property::padding_right, padding_right_, value);
+    set(Property::padding_top, padding_top_, value);
+    set(Property::padding_bottom, padding_bottom_, value);
     return *this;
   }
 
   Format &padding_left(size_t value) {
-    padding_left_ = value;
+    set(Property::padding_left, padding_left_, value);
     return *this;
   }
 
   Format &padding_right(size_t value) {
-    padding_right_ = value;
+    set(Property::padding_right, padding_right_, value);
     return *this;
   }
 
   Format &padding_top(size_t value) {
-    padding_top_ = value;
+    set(Property::padding_top, padding_top_, value);
     return *this;
   }
 
   Format &padding_bottom(size_t value) {
-    padding_bottom_ = value;
+    set(Property::padding_bottom, padding_bottom_, value);
     return *this;
   }
 
   Format &border(const std::string &value) {
-    border_left_ = value;
-    border_right_ = value;
-    border_top_ = value;
-    border_bottom_ = value;
+    set(Property::border_left, border_left_, value);
+    set(Property::border_right, border_right_, value);
+    set(Property::border_top, border_top_, value);
+    set(Property::border_bottom, border_bottom_, value);
     return *this;
   }
 
   Format &border_color(Color value) {
-    border_left_color_ = value;
-    border_right_color_ = value;
-    border_top_color_ = value;
-    border_bottom_color_ = value;
+    set(Property::border_left_color, border_left_color_, value);
+    set(Property::border_right_color, border_right_color_, value);
+    set(Property::border_top_color, border_top_color_, value);
+    set(Property::border_bottom_color, border_bottom_color_, value);
     return *this;
   }
 
   Format &border_background_color(Color value) {
-    border_left_background_color_ = value;
-    border_right_background_color_ = value;
-    border_top_background_color_ = value;
-    border_bottom_background_color_ = value;
+    set(Property::border_left_background_color, border_left_background_color_, value);
+    set(Property::border_right_background_color, border_right_background_color_, value);
+    set(Property::border_top_background_color, border_top_background_color_, value);
+    set(Property::border_bottom_background_color, border_bottom_background_color_, value);
     return *this;
   }
 
   Format &border_left(const std::string &value) {
-    border_left_ = value;
+    set(Property::border_left, border_left_, value);
     return *this;
   }
 
   Format &border_left_color(Color value) {
-    border_left_color_ = value;
+    set(Property::border_left_color, border_left_color_, value);
     return *this;
   }
 
   Format &border_left_background_color(Color value) {
-    border_left_background_color_ = value;
+    set(Property::border_left_background_color, border_left_background_color_, value);
     return *this;
   }
 
   Format &border_right(const std::string &value) {
-    border_right_ = value;
+    set(Property::border_right, border_right_, value);
     return *this;
   }
 
   Format &border_right_color(Color value) {
-    border_right_color_ = value;
+    set(Property::border_right_color, border_right_color_, value);
     return *this;
   }
 
   Format &border_right_background_color(Color value) {
-    border_right_background_color_ = value;
+    set(Property::border_right_background_color, border_right_background_color_, value);
     return *this;
   }
 
   Format &border_top(const std::string &value) {
-    border_top_ = value;
+    set(Property::border_top, border_top_, value);
     return *this;
   }
 
   Format &border_top_color(Color value) {
-    border_top_color_ = value;
+    set(Property::border_top_color, border_top_color_, value);
     return *this;
   }
 
   Format &border_top_background_color(Color value) {
-    border_top_background_color_ = value;
+    set(Property::border_top_background_color, border_top_background_color_, value);
     return *this;
   }
 
   Format &border_bottom(const std::string &value) {
-    border_bottom_ = value;
+    set(Property::border_bottom, border_bottom_, value);
     return *this;
   }
 
   Format &border_bottom_color(Color value) {
-    border_bottom_color_ = value;
+    set(Property::border_bottom_color, border_bottom_color_, value);
     return *this;
   }
 
   Format &border_bottom_background_color(Color value) {
-    border_bottom_background_color_ = value;
+    set(Property::border_bottom_background_color, border_bottom_background_color_, value);
     return *this;
   }
 
   Format &show_border() {
-    show_border_top_ = true;
-    show_border_bottom_ = true;
-    show_border_left_ = true;
-    show_border_right_ = true;
+    set(Property::show_border_top, show_border_top_, true);
+    set(Property::show_border_bottom, show_border_bottom_, true);
+    set(Property::show_border_left, show_border_left_, true);
+    set(Property::show_border_right, show_border_right_, true);
     return *this;
   }
 
   Format &hide_border() {
-    show_border_top_ = false;
-    show_border_bottom_ = false;
-    show_border_left_ = false;
-    show_border_right_ = false;
+    set(Property::show_border_top, show_border_top_, false);
+    set(Property::show_border_bottom, show_border_bottom_, false);
+    set(Property::show_border_left, show_border_left_, false);
+    set(Property::show_border_right, show_border_right_, false);
     return *this;
   }
 
   Format &show_border_top() {
-    show_border_top_ = true;
+    set(Property::show_border_top, show_border_top_, true);
     return *this;
   }
 
   Format &hide_border_top() {
-    show_border_top_ = false;
+    set(Property::show_border_top, show_border_top_, false);
     return *this;
   }
 
   Format &show_border_bottom() {
-    show_border_bottom_ = true;
+    set(Property::show_border_bottom, show_border_bottom_, true);
     return *this;
   }
 
   Format &hide_border_bottom() {
-    show_border_bottom_ = false;
+    set(Property::show_border_bottom, show_border_bottom_, false);
     return *this;
   }
 
   Format &show_border_left() {
-    show_border_left_ = true;
+    set(Property::show_border_left, show_border_left_, true);
     return *this;
   }
 
   Format &hide_border_left() {
-    show_border_left_ = false;
+    set(Property::show_border_left, show_border_left_, false);
     return *this;
   }
 
   Format &show_border_right() {
-    show_border_right_ = true;
+    set(Property::show_border_right, show_border_right_, true);
     return *this;
   }
 
   Format &hide_border_right() {
-    show_border_right_ = false;
+    set(Property::show_border_right, show_border_right_, false);
     return *this;
   }
 
   Format &corner(const std::string &value) {
-    corner_top_left_ = value;
-    corner_top_right_ = value;
-    corner_bottom_left_ = value;
-    corner_bottom_right_ = value;
+    set(Property::corner_top_left, corner_top_left_, value);
+    set(Property::corner_top_right, corner_top_right_, value);
+    set(Property::corner_bottom_left, corner_bottom_left_, value);
+    set(Property::corner_bottom_right, corner_bottom_right_, value);
     return *this;
   }
 
   Format &corner_color(Color value) {
-    corner_top_left_color_ = value;
-    corner_top_right_color_ = value;
-    corner_bottom_left_color_ = value;
-    corner_bottom_right_color_ = value;
+    set(Property::corner_top_left_color, corner_top_left_color_, value);
+    set(Property::corner_top_right_color, corner_top_right_color_, value);
+    set(Property::corner_bottom_left_color, corner_bottom_left_color_, value);
+    set(Property::corner_bottom_right_color, corner_bottom_right_color_, value);
     return *this;
   }
 
   Format &corner_background_color(Color value) {
-    corner_top_left_background_color_ = value;
-    corner_top_right_background_color_ = value;
-    corner_bottom_left_background_color_ = value;
-    corner_bottom_right_background_color_ = value;
+    set(Property::corner_top_left_background_color, corner_top_left_background_color_, value);
+    set(Property::corner_top_right_background_color, corner_top_right_background_color_, value);
+    set(Property::corner_bottom_left_background_color, corner_bottom_left_background_color_, value);
+    set(Property::corner_bottom_right_background_color,
+        corner_bottom_right_background_color_, value);
     return *this;
   }
 
   Format &corner_top_left(const std::string &value) {
-    corner_top_left_ = value;
+    set(Property::corner_top_left, corner_top_left_, value);
     return *this;
   }
 
   Format &corner_top_left_color(Color value) {
-    corner_top_left_color_ = value;
+    set(Property::corner_top_left_color, corner_top_left_color_, value);
     return *this;
   }
 
   Format &corner_top_left_background_color(Color value) {
-    corner_top_left_background_color_ = value;
+    set(Property::corner_top_left_background_color, corner_top_left_background_color_, value);
     return *this;
   }
 
   Format &corner_top_right(const std::string &value) {
-    corner_top_right_ = value;
+    set(Property::corner_top_right, corner_top_right_, value);
     return *this;
   }
 
   Format &corner_top_right_color(Color value) {
-    corner_top_right_color_ = value;
+    set(Property::corner_top_right_color, corner_top_right_color_, value);
     return *this;
   }
 
   Format &corner_top_right_background_color(Color value) {
-    corner_top_right_background_color_ = value;
+    set(Property::corner_top_right_background_color, corner_top_right_background_color_, value);
     return *this;
   }
 
   Format &corner_bottom_left(const std::string &value) {
-    corner_bottom_left_ = value;
+    set(Property::corner_bottom_left, corner_bottom_left_, value);
     return *this;
   }
 
   Format &corner_bottom_left_color(Color value) {
-    corner_bottom_left_color_ = value;
+    set(Property::corner_bottom_left_color, corner_bottom_left_color_, value);
     return *this;
   }
 
   Format &corner_bottom_left_background_color(Color value) {
-    corner_bottom_left_background_color_ = value;
+    set(Property::corner_bottom_left_background_color, corner_bottom_left_background_color_, value);
     return *this;
   }
 
   Format &corner_bottom_right(const std::string &value) {
-    corner_bottom_right_ = value;
+    set(Property::corner_bottom_right, corner_bottom_right_, value);
     return *this;
   }
 
   Format &corner_bottom_right_color(Color value) {
-    corner_bottom_right_color_ = value;
+    set(Property::corner_bottom_right_color, corner_bottom_right_color_, value);
     return *this;
   }
 
   Format &corner_bottom_right_background_color(Color value) {
-    corner_bottom_right_background_color_ = value;
+    set(Property::corner_bottom_right_background_color,
+        corner_bottom_right_background_color_, value);
     return *this;
   }
 
   Format &column_separator(const std::string &value) {
-    column_separator_ = value;
+    set(Property::column_separator, column_separator_, value);
     return *this;
   }
 
   Format &column_separator_color(Color value) {
-    column_separator_color_ = value;
+    set(Property::column_separator_color, column_separator_color_, value);
     return *this;
   }
 
   Format &column_separator_background_color(Color value) {
-    column_separator_background_color_ = value;
+    set(Property::column_separator_background_color, column_separator_background_color_, value);
     return *this;
   }
 
   Format &font_align(FontAlign value) {
-    font_align_ = value;
+    set(Property::font_align, font_align_, value);
     return *this;
   }
 
   Format &font_style(const std::vector<FontStyle> &style) {
-    if (font_style_.has_value()) {
-      for (auto &s : style)
-        font_style_->push_back(s);
-    } else {
-      font_style_ = style;
-    }
+    // Font styles add up
+    for (auto &s : style)
+      font_style_ |= static_cast<unsigned char>(font_style_bit(s));
+    properties_ |= bit(Property::font_style);
+    owner_.changed();
     return *this;
   }
 
   Format &font_color(Color value) {
-    font_color_ = value;
+    set(Property::font_color, font_color_, value);
     return *this;
   }
 
   Format &font_background_color(Color value) {
-    font_background_color_ = value;
+    set(Property::font_background_color, font_background_color_, value);
     return *this;
   }
 
@@ -372,73 +368,146 @@ public:
     return *this;
   }
 
+  // Text wider than its column is word wrapped by default, truncation keeps
+  // every row of the column a single line high
+  Format &overflow(Overflow value) {
+    set(Property::overflow, overflow_, value);
+    return *this;
+  }
+
   Format &multi_byte_characters(bool value) {
-    multi_byte_characters_ = value;
+    set(Property::multi_byte_characters, multi_byte_characters_, value);
     return *this;
   }
 
+  // Display widths are always computed for UTF-8 text, independently of the
+  // process locale, so this setting is only kept for compatibility
   Format &locale(const std::string &value) {
-    locale_ = value;
+    set(Property::locale, locale_, value);
     return *this;
   }
 
   // Apply word wrap
   // Given an input string and a line length, this will insert \n
   // in strategic places in input string and apply word wrapping
-  static std::string word_wrap(const std::string &str, size_t width, const std::string &locale,
+  static std::string word_wrap(const std::string &str, size_t width,
+                               const std::string & /*locale*/,
                                bool is_multi_byte_character_support_enabled) {
-    std::vector<std::string> words = explode_string(str, {" ", "-", "\t"});
-    size_t current_line_length = 0;
     std::string result;
+    std::vector<LineSpan> lines;
+    word_wrap(str.data(), str.size(), width, is_multi_byte_character_support_enabled, result,
+              lines);
+    return result;
+  }
+
+  // Word wraps size bytes of text and appends the wrapped lines to result,
+  // separated by '\n'. The span and display width of each line in result is
+  // added to lines, except for a trailing empty line
+  // Words are read in place, only the output is allocated
+  static void word_wrap(const char *text, size_t size, size_t width,
+                        bool is_multi_byte_character_support_enabled, std::string &result,
+                        std::vector<LineSpan> &lines) {
+    // Printable ASCII is as wide as it is long, it is never measured
+    auto text_class = classify_text(text, size);
+    auto ascii = is_printable_ascii(text_class);
+    auto sequence_length = [&](const char *data, size_t length) {
+      return ascii ? length
+                   : get_sequence_length(data, length, is_multi_byte_character_support_enabled);
+    };
+
+    size_t line_start = result.size();
+    auto end_line = [&]() {
+      auto length = result.size() - line_start;
+      lines.push_back({line_start, length, sequence_length(result.data() + line_start, length)});
+      result += '\n';
+      line_start = result.size();
+    };
 
-    for (size_t i = 0; i < words.size(); ++i) {
-      std::string word = words[i];
+    size_t current_line_length = 0;
+    auto add_word = [&](const char *word, size_t length) {
+      if (length == 0)
+        return;
+      auto word_length = sequence_length(word, length);
       // If adding the new word to the current line would be too long,
       // then put it on a new line (and split it up if it's too long).
-      if (current_line_length +
-              get_sequence_length(word, locale, is_multi_byte_character_support_enabled) >
-          width) {
+      if (current_line_length + word_length > width) {
         // Only move down to a new line if we have text on the current line.
         // Avoids situation where wrapped whitespace causes emptylines in text.
         if (current_line_length > 0) {
-          result += '\n';
+          end_line();
           current_line_length = 0;
         }
 
         // If the current word is too long to fit on a line even on it's own then
         // split the word up.
-        while (get_sequence_length(word, locale, is_multi_byte_character_support_enabled) > width) {
-          result += word.substr(0, width - 1) + "-";
-          word = word.substr(width - 1);
-          result += '\n';
+        // A single column has no room left for the hyphen.
+        while (word_length > width) {
+          auto chunk = width > 1 ? width - 1 : 1;
+          result.append(word, chunk);
+          if (width > 1)
+            result += '-';
+          end_line();
+          word += chunk;
+          length -= chunk;
+          word_length = sequence_length(word, length);
         }
 
         // Remove leading whitespace from the word so the new line starts flush to the left.
-        word = trim_left(word);
+        while (length > 0 && std::isspace(static_cast<unsigned char>(*word))) {
+          ++word;
+          --length;
+        }
+        word_length = sequence_length(word, length);
       }
-      result += word;
-      current_line_length +=
-          get_sequence_length(word, locale, is_multi_byte_character_support_enabled);
+      result.append(word, length);
+      current_line_length += word_length;
+    };
+
+    // Spaces and tabs are words of their own
+    // Unlike whitespace, dashes and the like should stick to the word occurring before it.
+    // Without a space, a tab or a dash the text is a single word
+    size_t start{0};
+    if ((text_class & (text_space | text_dash | text_control)) == 0) {
+      add_word(text, size);
+      start = size;
     }
-    return result;
+    while (start < size) {
+      auto end = start;
+      while (end < size && text[end] != ' ' && text[end] != '\t' && text[end] != '-')
+        ++end;
+      if (end == size) {
+        add_word(text + start, end - start);
+        break;
+      }
+      if (text[end] == '-') {
+        add_word(text + start, end + 1 - start);
+      } else {
+        add_word(text + start, end - start);
+        add_word(text + end, 1);
+      }
+      start = end + 1;
+    }
+
+    auto length = result.size() - line_start;
+    auto line_width = sequence_length(result.data() + line_start, length);
+    if (line_width > 0)
+      lines.push_back({line_start, length, line_width});
   }
 
   static std::vector<std::string> split_lines(const std::string &text, const std::string &delimiter,
-                                              const std::string &locale,
+                                              const std::string & /*locale*/,
                                               bool is_multi_byte_character_support_enabled) {
     std::vector<std::string> result{};
-    std::string input = text;
-    size_t pos = 0;
-    std::string token;
-    while ((pos = input.find(delimiter)) != std::string::npos) {
-      token = input.substr(0, pos);
-      result.push_back(token);
-      input.erase(0, pos + delimiter.length());
+    size_t start{0}, pos;
+    while (!delimiter.empty() && (pos = text.find(delimiter, start)) != std::string::npos) {
+      result.push_back(text.substr(start, pos - start));
+      start = pos + delimiter.size();
     }
-    if (get_sequence_length(input, locale, is_multi_byte_character_support_enabled))
-      result.push_back(input);
+    if (get_sequence_length(text.data() + start, text.size() - start,
+                            is_multi_byte_character_support_enabled))
+      result.push_back(text.substr(start));
     return result;
-  };
+  }
 
   // Merge two formats
   // first has higher precedence
@@ -446,242 +515,67 @@ public:
   // second = row-level formatting
   // Result has attributes of both with cell-level
   // formatting taking precedence
-  static Format merge(Format first, Format second) {
-    Format result;
-
-    // Width and height
-    if (first.width_.has_value())
-      result.width_ = first.width_;
-    else
-      result.width_ = second.width_;
-
-    if (first.height_.has_value())
-      result.height_ = first.height_;
-    else
-      result.height_ = second.height_;
-
-    // Font styling
-    if (first.font_align_.has_value())
-      result.font_align_ = first.font_align_;
-    else
-      result.font_align_ = second.font_align_;
-
-    if (first.font_style_.has_value()) {
-      // Merge font styles using std::set_union
-      std::vector<FontStyle> merged_font_style(first.font_style_->size() +
-                                               second.font_style_->size());
-#if defined(_WIN32) || defined(_WIN64)
-      // Fixes error in Windows - Sequence not ordered
-      std::sort(first.font_style_->begin(), first.font_style_->end());
-      std::sort(second.font_style_->begin(), second.font_style_->end());
-#endif
-      std::set_union(first.font_style_->begin(), first.font_style_->end(),
-                     second.font_style_->begin(), second.font_style_->end(),
-                     merged_font_style.begin());
-      result.font_style_ = merged_font_style;
-    } else
-      result.font_style_ = second.font_style_;
-
-    if (first.font_color_.has_value())
-      result.font_color_ = first.font_color_;
-    else
-      result.font_color_ = second.font_color_;
-
-    if (first.font_background_color_.has_value())
-      result.font_background_color_ = first.font_background_color_;
-    else
-      result.font_background_color_ = second.font_background_color_;
-
-    // Padding
-    if (first.padding_left_.has_value())
-      result.padding_left_ = first.padding_left_;
-    else
-      result.padding_left_ = second.padding_left_;
-
-    if (first.padding_top_.has_value())
-      result.padding_top_ = first.padding_top_;
-    else
-      result.padding_top_ = second.padding_top_;
-
-    if (first.padding_right_.has_value())
-      result.padding_right_ = first.padding_right_;
-    else
-      result.padding_right_ = second.padding_right_;
-
-    if (first.padding_bottom_.has_value())
-      result.padding_bottom_ = first.padding_bottom_;
-    else
-      result.padding_bottom_ = second.padding_bottom_;
-
-    // Border
-    if (first.border_left_.has_value())
-      result.border_left_ = first.border_left_;
-    else
-      result.border_left_ = second.border_left_;
-
-    if (first.border_left_color_.has_value())
-      result.border_left_color_ = first.border_left_color_;
-    else
-      result.border_left_color_ = second.border_left_color_;
-
-    if (first.border_left_background_color_.has_value())
-      result.border_left_background_color_ = first.border_left_background_color_;
-    else
-      result.border_left_background_color_ = second.border_left_background_color_;
-
-    if (first.border_top_.has_value())
-      result.border_top_ = first.border_top_;
-    else
-      result.border_top_ = second.border_top_;
-
-    if (first.border_top_color_.has_value())
-      result.border_top_color_ = first.border_top_color_;
-    else
-      result.border_top_color_ = second.border_top_color_;
-
-    if (first.border_top_background_color_.has_value())
-      result.border_top_background_color_ = first.border_top_background_color_;
-    else
-      result.border_top_background_color_ = second.border_top_background_color_;
-
-    if (first.border_bottom_.has_value())
-      result.border_bottom_ = first.border_bottom_;
-    else
-      result.border_bottom_ = second.border_bottom_;
-
-    if (first.border_bottom_color_.has_value())
-      result.border_bottom_color_ = first.border_bottom_color_;
-    else
-      result.border_bottom_color_ = second.border_bottom_color_;
-
-    if (first.border_bottom_background_color_.has_value())
-      result.border_bottom_background_color_ = first.border_bottom_background_color_;
-    else
-      result.border_bottom_background_color_ = second.border_bottom_background_color_;
-
-    if (first.border_right_.has_value())
-      result.border_right_ = first.border_right_;
-    else
-      result.border_right_ = second.border_right_;
-
-    if (first.border_right_color_.has_value())
-      result.border_right_color_ = first.border_right_color_;
-    else
-      result.border_right_color_ = second.border_right_color_;
-
-    if (first.border_right_background_color_.has_value())
-      result.border_right_background_color_ = first.border_right_background_color_;
-    else
-      result.border_right_background_color_ = second.border_right_background_color_;
-
-    if (first.show_border_top_.has_value())
-      result.show_border_top_ = first.show_border_top_;
-    else
-      result.show_border_top_ = second.show_border_top_;
-
-    if (first.show_border_bottom_.has_value())
-      result.show_border_bottom_ = first.show_border_bottom_;
-    else
-      result.show_border_bottom_ = second.show_border_bottom_;
-
-    if (first.show_border_left_.has_value())
-      result.show_border_left_ = first.show_border_left_;
-    else
-      result.show_border_left_ = second.show_border_left_;
-
-    if (first.show_border_right_.has_value())
-      result.show_border_right_ = first.show_border_right_;
-    else
-      result.show_border_right_ = second.show_border_right_;
-
-    // Corner
-    if (first.corner_top_left_.has_value())
-      result.corner_top_left_ = first.corner_top_left_;
-    else
-      result.corner_top_left_ = second.corner_top_left_;
-
-    if (first.corner_top_left_color_.has_value())
-      result.corner_top_left_color_ = first.corner_top_left_color_;
-    else
-      result.corner_top_left_color_ = second.corner_top_left_color_;
-
-    if (first.corner_top_left_background_color_.has_value())
-      result.corner_top_left_background_color_ = first.corner_top_left_background_color_;
-    else
-      result.corner_top_left_background_color_ = second.corner_top_left_background_color_;
-
-    if (first.corner_top_right_.has_value())
-      result.corner_top_right_ = first.corner_top_right_;
-    else
-      result.corner_top_right_ = second.corner_top_right_;
-
-    if (first.corner_top_right_color_.has_value())
-      result.corner_top_right_color_ = first.corner_top_right_color_;
-    else
-      result.corner_top_right_color_ = second.corner_top_right_color_;
-
-    if (first.corner_top_right_background_color_.has_value())
-      result.corner_top_right_background_color_ = first.corner_top_right_background_color_;
-    else
-      result.corner_top_right_background_color_ = second.corner_top_right_background_color_;
-
-    if (first.corner_bottom_left_.has_value())
-      result.corner_bottom_left_ = first.corner_bottom_left_;
-    else
-      result.corner_bottom_left_ = second.corner_bottom_left_;
-
-    if (first.corner_bottom_left_color_.has_value())
-      result.corner_bottom_left_color_ = first.corner_bottom_left_color_;
-    else
-      result.corner_bottom_left_color_ = second.corner_bottom_left_color_;
-
-    if (first.corner_bottom_left_background_color_.has_value())
-      result.corner_bottom_left_background_color_ = first.corner_bottom_left_background_color_;
-    else
-      result.corner_bottom_left_background_color_ = second.corner_bottom_left_background_color_;
-
-    if (first.corner_bottom_right_.has_value())
-      result.corner_bottom_right_ = first.corner_bottom_right_;
-    else
-      result.corner_bottom_right_ = second.corner_bottom_right_;
-
-    if (first.corner_bottom_right_color_.has_value())
-      result.corner_bottom_right_color_ = first.corner_bottom_right_color_;
-    else
-      result.corner_bottom_right_color_ = second.corner_bottom_right_color_;
-
-    if (first.corner_bottom_right_background_color_.has_value())
-      result.corner_bottom_right_background_color_ = first.corner_bottom_right_background_color_;
-    else
-      result.corner_bottom_right_background_color_ = second.corner_bottom_right_background_color_;
-
-    // Column separator
-    if (first.column_separator_.has_value())
-      result.column_separator_ = first.column_separator_;
-    else
-      result.column_separator_ = second.column_separator_;
-
-    if (first.column_separator_color_.has_value())
-      result.column_separator_color_ = first.column_separator_color_;
-    else
-      result.column_separator_color_ = second.column_separator_color_;
-
-    if (first.column_separator_background_color_.has_value())
-      result.column_separator_background_color_ = first.column_separator_background_color_;
-    else
-      result.column_separator_background_color_ = second.column_separator_background_color_;
-
-    // Internationlization
-    if (first.multi_byte_characters_.has_value())
-      result.multi_byte_characters_ = first.multi_byte_characters_;
-    else
-      result.multi_byte_characters_ = second.multi_byte_characters_;
-
-    if (first.locale_.has_value())
-      result.locale_ = first.locale_;
-    else
-      result.locale_ = second.locale_;
-
+  static Format merge(const Format &first, const Format &second) {
+    // Start from second and take over every property set in first
+    Format result = second;
+    result.take(first, Property::width, &Format::width_);
+    result.take(first, Property::height, &Format::height_);
+    result.take(first, Property::font_align, &Format::font_align_);
+    result.take(first, Property::font_color, &Format::font_color_);
+    result.take(first, Property::font_background_color, &Format::font_background_color_);
+    result.take(first, Property::padding_left, &Format::padding_left_);
+    result.take(first, Property::padding_top, &Format::padding_top_);
+    result.take(first, Property::padding_right, &Format::padding_right_);
+    result.take(first, Property::padding_bottom, &Format::padding_bottom_);
+    result.take(first, Property::show_border_top, &Format::show_border_top_);
+    result.take(first, Property::border_top, &Format::border_top_);
+    result.take(first, Property::border_top_color, &Format::border_top_color_);
+    result.take(first, Property::border_top_background_color,
+                &Format::border_top_background_color_);
+    result.take(first, Property::show_border_bottom, &Format::show_border_bottom_);
+    result.take(first, Property::border_bottom, &Format::border_bottom_);
+    result.take(first, Property::border_bottom_color, &Format::border_bottom_color_);
+    result.take(first, Property::border_bottom_background_color,
+                &Format::border_bottom_background_color_);
+    result.take(first, Property::show_border_left, &Format::show_border_left_);
+    result.take(first, Property::border_left, &Format::border_left_);
+    result.take(first, Property::border_left_color, &Format::border_left_color_);
+    result.take(first, Property::border_left_background_color,
+                &Format::border_left_background_color_);
+    result.take(first, Property::show_border_right, &Format::show_border_right_);
+    result.take(first, Property::border_right, &Format::border_right_);
+    result.take(first, Property::border_right_color, &Format::border_right_color_);
+    result.take(first, Property::border_right_background_color,
+                &Format::border_right_background_color_);
+    result.take(first, Property::corner_top_left, &Format::corner_top_left_);
+    result.take(first, Property::corner_top_left_color, &Format::corner_top_left_color_);
+    result.take(first, Property::corner_top_left_background_color,
+                &Format::corner_top_left_background_color_);
+    result.take(first, Property::corner_top_right, &Format::corner_top_right_);
+    result.take(first, Property::corner_top_right_color, &Format::corner_top_right_color_);
+    result.take(first, Property::corner_top_right_background_color,
+                &Format::corner_top_right_background_color_);
+    result.take(first, Property::corner_bottom_left, &Format::corner_bottom_left_);
+    result.take(first, Property::corner_bottom_left_color, &Format::corner_bottom_left_color_);
+    result.take(first, Property::corner_bottom_left_background_color,
+                &Format::corner_bottom_left_background_color_);
+    result.take(first, Property::corner_bottom_right, &Format::corner_bottom_right_);
+    result.take(first, Property::corner_bottom_right_color, &Format::corner_bottom_right_color_);
+    result.take(first, Property::corner_bottom_right_background_color,
+                &Format::corner_bottom_right_background_color_);
+    result.take(first, Property::column_separator, &Format::column_separator_);
+    result.take(first, Property::column_separator_color, &Format::column_separator_color_);
+    result.take(first, Property::column_separator_background_color,
+                &Format::column_separator_background_color_);
+    result.take(first, Property::overflow, &Format::overflow_);
+    result.take(first, Property::multi_byte_characters, &Format::multi_byte_characters_);
+    result.take(first, Property::locale, &Format::locale_);
+
+    // Font styles add up
+    if (first.has(Property::font_style))
+      result.font_style_ |= first.font_style_;
+
+    result.properties_ |= first.properties_;
     return result;
   }
 
@@ -697,156 +591,198 @@ private:
 
   void set_defaults() {
     // NOTE: width and height are not set here
-    font_align_ = FontAlign::left;
-    font_style_ = std::vector<FontStyle>{};
-    font_color_ = font_background_color_ = Color::none;
-    padding_left_ = padding_right_ = 1;
-    padding_top_ = padding_bottom_ = 0;
-    border_top_ = border_bottom_ = "-";
-    border_left_ = border_right_ = "|";
-    show_border_left_ = show_border_right_ = show_border_top_ = show_border_bottom_ = true;
-    border_top_color_ = border_top_background_color_ = border_bottom_color_ =
-        border_bottom_background_color_ = border_left_color_ = border_left_background_color_ =
-            border_right_color_ = border_right_background_color_ = Color::none;
-    corner_top_left_ = corner_top_right_ = corner_bottom_left_ = corner_bottom_right_ = "+";
-    corner_top_left_color_ = corner_top_left_background_color_ = corner_top_right_color_ =
-        corner_top_right_background_color_ = corner_bottom_left_color_ =
-            corner_bottom_left_background_color_ = corner_bottom_right_color_ =
-                corner_bottom_right_background_color_ = Color::none;
-    column_separator_ = "|";
-    column_separator_color_ = column_separator_background_color_ = Color::none;
-    multi_byte_characters_ = false;
-    locale_ = "";
-  }
-
-  // Helper methods for word wrapping:
-
-  // trim white spaces from the left end of an input string
-  static std::string trim_left(const std::string &input_string) {
-    std::string result = input_string;
-    result.erase(result.begin(), std::find_if(result.begin(), result.end(),
-                                              [](int ch) { return !std::isspace(ch); }));
-    return result;
-  }
+    font_align(FontAlign::left);
+    font_style({});
+    font_color(Color::none);
+    font_background_color(Color::none);
+    padding_left(1);
+    padding_right(1);
+    padding_top(0);
+    padding_bottom(0);
+    border_top("-");
+    border_bottom("-");
+    border_left("|");
+    border_right("|");
+    show_border();
+    border_color(Color::none);
+    border_background_color(Color::none);
+    corner("+");
+    corner_color(Color::none);
+    corner_background_color(Color::none);
+    column_separator("|");
+    column_separator_color(Color::none);
+    column_separator_background_color(Color::none);
+    overflow(Overflow::wrap);
+    multi_byte_characters(false);
+    locale("");
+  }
+
+  // Properties, as bits of properties_
+  enum class Property : unsigned char {
+    width,
+    height,
+    font_align,
+    font_style,
+    font_color,
+    font_background_color,
+    padding_left,
+    padding_top,
+    padding_right,
+    padding_bottom,
+    show_border_top,
+    border_top,
+    border_top_color,
+    border_top_background_color,
+    show_border_bottom,
+    border_bottom,
+    border_bottom_color,
+    border_bottom_background_color,
+    show_border_left,
+    border_left,
+    border_left_color,
+    border_left_background_color,
+    show_border_right,
+    border_right,
+    border_right_color,
+    border_right_background_color,
+    corner_top_left,
+    corner_top_left_color,
+    corner_top_left_background_color,
+    corner_top_right,
+    corner_top_right_color,
+    corner_top_right_background_color,
+    corner_bottom_left,
+    corner_bottom_left_color,
+    corner_bottom_left_background_color,
+    corner_bottom_right,
+    corner_bottom_right_color,
+    corner_bottom_right_background_color,
+    column_separator,
+    column_separator_color,
+    column_separator_background_color,
+    overflow,
+    multi_byte_characters,
+    locale,
+  };
 
-  // trim white spaces from right end of an input string
-  static std::string trim_right(const std::string &input_string) {
-    std::string result = input_string;
-    result.erase(
-        std::find_if(result.rbegin(), result.rend(), [](int ch) { return !std::isspace(ch); })
-            .base(),
-        result.end());
-    return result;
+  static uint64_t bit(Property property) {
+    return uint64_t(1) << static_cast<unsigned>(property);
   }
 
-  // trim white spaces from either end of an input string
-  static std::string trim(const std::string &input_string) {
-    return trim_left(trim_right(input_string));
-  }
+  bool has(Property property) const { return (properties_ & bit(property)) != 0; }
 
-  static size_t index_of_any(const std::string &input, size_t start_index,
-                             const std::vector<std::string> &split_characters) {
-    std::vector<size_t> indices{};
-    for (auto &c : split_characters) {
-      auto index = input.find(c, start_index);
-      if (index != std::string::npos)
-        indices.push_back(index);
-    }
-    if (indices.size() > 0)
-      return *std::min_element(indices.begin(), indices.end());
-    else
-      return std::string::npos;
+  template <typename T, typename U> void set(Property property, T &field, const U &value) {
+    field = T(value);
+    properties_ |= bit(property);
+    owner_.changed();
   }
 
-  static std::vector<std::string> explode_string(const std::string &input,
-                                                 const std::vector<std::string> &split_characters) {
-    std::vector<std::string> result{};
-    size_t start_index{0};
-    while (true) {
-      auto index = index_of_any(input, start_index, split_characters);
+  // Table a format belongs to, told about every change of the format, even
+  // through a Format& kept across prints, see TableInternal::resolve_formats()
+  // A copy of a format belongs to no table, assigning to a format changes it
+  class Owner {
+  public:
+    Owner() = default;
+    Owner(const Owner &) {}
+    Owner &operator=(const Owner &) {
+      changed();
+      return *this;
+    }
 
-      if (index == std::string::npos) {
-        result.push_back(input.substr(start_index));
-        return result;
-      }
+    // generation counts the changes of the formats of the table
+    void attach(std::atomic<uint64_t> *generation) { generation_ = generation; }
 
-      std::string word = input.substr(start_index, index - start_index);
-      char next_character = input.substr(index, 1)[0];
-      // Unlike whitespace, dashes and the like should stick to the word occurring before it.
-      if (isspace(next_character)) {
-        result.push_back(word);
-        result.push_back(std::string(1, next_character));
-      } else {
-        result.push_back(word + next_character);
-      }
-      start_index = index + 1;
+    void changed() {
+      if (generation_ != nullptr)
+        changed_ = generation_->fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
-    return result;
+    // Generation of the table after the last change of the format, 0 if it
+    // was not changed since it was attached
+    uint64_t last_change() const { return changed_; }
+
+  private:
+    std::atomic<uint64_t> *generation_{nullptr};
+    uint64_t changed_{0};
+  };
+
+  // Copies a property of other, if it is set there
+  template <typename T> void take(const Format &other, Property property, T Format::*field) {
+    if (other.has(property))
+      this->*field = other.*field;
   }
 
+  // Properties set in this format
+  // The fields of the properties that are not set are left zero-initialized
+  uint64_t properties_{0};
+
   // Element width and height
-  optional<size_t> width_{};
-  optional<size_t> height_{};
+  size_t width_{0};
+  size_t height_{0};
 
   // Font styling
-  optional<FontAlign> font_align_{};
-  optional<std::vector<FontStyle>> font_style_{};
-  optional<Color> font_color_{};
-  optional<Color> font_background_color_{};
+  FontAlign font_align_{};
+  unsigned char font_style_{0}; // font_style_bit() of each style
+  Color font_color_{};
+  Color font_background_color_{};
 
   // Element padding
-  optional<size_t> padding_left_{};
-  optional<size_t> padding_top_{};
-  optional<size_t> padding_right_{};
-  optional<size_t> padding_bottom_{};
+  size_t padding_left_{0};
+  size_t padding_top_{0};
+  size_t padding_right_{0};
+  size_t padding_bottom_{0};
 
   // Element border
-  optional<bool> show_border_top_{};
-  optional<std::string> border_top_{};
-  optional<Color> border_top_color_{};
-  optional<Color> border_top_background_color_{};
-
-  optional<bool> show_border_bottom_{};
-  optional<std::string> border_bottom_{};
-  optional<Color> border_bottom_color_{};
-  optional<Color> border_bottom_background_color_{};
-
-  optional<bool> show_border_left_{};
-  optional<std::string> border_left_{};
-  optional<Color> border_left_color_{};
-  optional<Color> border_left_background_color_{};
-
-  optional<bool> show_border_right_{};
-  optional<std::string> border_right_{};
-  optional<Color> border_right_color_{};
-  optional<Color> border_right_background_color_{};
+  bool show_border_top_{false};
+  InternedString border_top_{};
+  Color border_top_color_{};
+  Color border_top_background_color_{};
+
+  bool show_border_bottom_{false};
+  InternedString border_bottom_{};
+  Color border_bottom_color_{};
+  Color border_bottom_background_color_{};
+
+  bool show_border_left_{false};
+  InternedString border_left_{};
+  Color border_left_color_{};
+  Color border_left_background_color_{};
+
+  bool show_border_right_{false};
+  InternedString border_right_{};
+  Color border_right_color_{};
+  Color border_right_background_color_{};
 
   // Element corner
-  optional<std::string> corner_top_left_{};
-  optional<Color> corner_top_left_color_{};
-  optional<Color> corner_top_left_background_color_{};
+  InternedString corner_top_left_{};
+  Color corner_top_left_color_{};
+  Color corner_top_left_background_color_{};
 
-  optional<std::string> corner_top_right_{};
-  optional<Color> corner_top_right_color_{};
-  optional<Color> corner_top_right_background_color_{};
+  InternedString corner_top_right_{};
+  Color corner_top_right_color_{};
+  Color corner_top_right_background_color_{};
 
-  optional<std::string> corner_bottom_left_{};
-  optional<Color> corner_bottom_left_color_{};
-  optional<Color> corner_bottom_left_background_color_{};
+  InternedString corner_bottom_left_{};
+  Color corner_bottom_left_color_{};
+  Color corner_bottom_left_background_color_{};
 
-  optional<std::string> corner_bottom_right_{};
-  optional<Color> corner_bottom_right_color_{};
-  optional<Color> corner_bottom_right_background_color_{};
+  InternedString corner_bottom_right_{};
+  Color corner_bottom_right_color_{};
+  Color corner_bottom_right_background_color_{};
 
   // Element column separator
-  optional<std::string> column_separator_{};
-  optional<Color> column_separator_color_{};
-  optional<Color> column_separator_background_color_{};
+  InternedString column_separator_{};
+  Color column_separator_color_{};
+  Color column_separator_background_color_{};
+
+  // Text wider than its column
+  Overflow overflow_{};
 
   // Internationalization
-  optional<bool> multi_byte_characters_{};
-  optional<std::string> locale_{};
+  bool multi_byte_characters_{false};
+  InternedString locale_{};
+
+  Owner owner_;
 };
 
 } // namespace tabulate
@@ -0,0 +1,76 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace tabulate {
+
+// A string stored once for the whole process, e.g., a border glyph
+// Copying and comparing interned strings only involves a pointer
+class InternedString {
+public:
+  InternedString() = default;
+
+  explicit InternedString(const std::string &value)
+      : string_(value.empty() ? nullptr : &intern(value)) {}
+
+  const std::string &str() const { return string_ ? *string_ : empty_string(); }
+
+  bool empty() const { return string_ == nullptr; }
+
+  bool operator==(const InternedString &other) const { return string_ == other.string_; }
+
+  bool operator!=(const InternedString &other) const { return string_ != other.string_; }
+
+private:
+  // Elements of an unordered_set never move, so the returned reference stays
+  // valid until the process exits
+  static const std::string &intern(const std::string &value) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> strings;
+    std::lock_guard<std::mutex> lock(mutex);
+    return *strings.insert(value).first;
+  }
+
+  static const std::string &empty_string() {
+    static const std::string empty;
+    return empty;
+  }
+
+  const std::string *string_{nullptr};
+};
+
+} // namespace tabulate
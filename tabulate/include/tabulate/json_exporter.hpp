@@ -0,0 +1,195 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <tabulate/exporter.hpp>
+#include <tabulate/utf8.hpp>
+
+namespace tabulate {
+
+// A JSON array with one element per row. By default the first row holds the
+// keys and every following row becomes an object; without a header each row
+// becomes an array of strings.
+class JsonExporter : public Exporter {
+public:
+  class ExportOptions {
+  public:
+    ExportOptions &header(bool value) {
+      header_ = value;
+      return *this;
+    }
+
+  private:
+    friend class JsonExporter;
+    bool header_{true};
+  };
+
+  JsonExporter() = default;
+
+  ExportOptions &configure() { return options_; }
+
+  std::string dump(Table &table) override {
+    std::string result;
+    write(*table.table_, result, nullptr);
+    return result;
+  }
+
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
+  }
+
+protected:
+  // Newline-delimited JSON writes one row per line without the enclosing array
+  explicit JsonExporter(bool lines) : lines_(lines) {}
+
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    if (!lines_)
+      buffer += '[';
+
+    size_t first_row = options_.header_ ? 1 : 0;
+    for (size_t i = first_row; i < table.size(); ++i) {
+      if (!lines_)
+        buffer += i > first_row ? ",\n" : "\n";
+      if (options_.header_)
+        add_object(buffer, table, i);
+      else
+        add_array(buffer, table, i);
+      if (lines_)
+        buffer += '\n';
+      flush(buffer, stream, flush_size);
+    }
+
+    if (!lines_)
+      buffer += table.size() > first_row ? "\n]\n" : "]\n";
+  }
+
+  static void add_object(std::string &buffer, const TableInternal &table, size_t row) {
+    buffer += '{';
+    for (size_t j = 0; j < table.row_size(row); ++j) {
+      if (j > 0)
+        buffer += ',';
+      // Columns without a header are keyed by their index
+      if (j < table.row_size(0)) {
+        auto key = table.cell_index(0, j);
+        table.visit_cell_text(key, [&](const char *data, size_t size) {
+          add_string(buffer, data, size);
+        });
+      } else {
+        auto key = std::to_string(j);
+        add_string(buffer, key.data(), key.size());
+      }
+      buffer += ':';
+      auto cell = table.cell_index(row, j);
+      table.visit_cell_text(cell, [&](const char *data, size_t size) {
+        add_string(buffer, data, size);
+      });
+    }
+    buffer += '}';
+  }
+
+  static void add_array(std::string &buffer, const TableInternal &table, size_t row) {
+    buffer += '[';
+    for (size_t j = 0; j < table.row_size(row); ++j) {
+      if (j > 0)
+        buffer += ',';
+      auto cell = table.cell_index(row, j);
+      table.visit_cell_text(cell, [&](const char *data, size_t size) {
+        add_string(buffer, data, size);
+      });
+    }
+    buffer += ']';
+  }
+
+  // Quotes text as a JSON string, valid UTF-8 is passed through as is and
+  // every byte of an invalid sequence is replaced by U+FFFD, so that the
+  // output stays valid JSON
+  static void add_string(std::string &buffer, const char *data, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    buffer += '"';
+    for (size_t i = 0; i < size; ++i) {
+      auto c = static_cast<unsigned char>(data[i]);
+      if (c >= 0x80) {
+        auto end = i;
+        char32_t code_point;
+        if (decode_utf8(data, size, end, code_point)) {
+          buffer.append(data + i, end - i);
+          i = end - 1;
+        } else {
+          buffer += "\xef\xbf\xbd";
+        }
+        continue;
+      }
+      switch (c) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\b':
+        buffer += "\\b";
+        break;
+      case '\f':
+        buffer += "\\f";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\t':
+        buffer += "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          buffer += "\\u00";
+          buffer += hex[c >> 4];
+          buffer += hex[c & 0xf];
+        } else {
+          buffer += data[i];
+        }
+      }
+    }
+    buffer += '"';
+  }
+
+  ExportOptions options_;
+  bool lines_{false};
+};
+
+} // namespace tabulate
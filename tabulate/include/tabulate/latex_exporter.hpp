@@ -63,6 +63,8 @@ public:
 
   ExportOptions &configure() { return options_; }
 
+  using Exporter::dump;
+
   std::string dump(Table &table) override {
     std::string result{"\\begin{tabular}"};
     result += new_line;
@@ -101,12 +103,12 @@ private:
     std::string result{"{"};
 
     for (auto &cell : table[0]) {
-      auto format = cell.format();
-      if (format.font_align_.value() == FontAlign::left) {
+      const Format &format = cell.resolved_format();
+      if (format.font_align_ == FontAlign::left) {
         result += 'l';
-      } else if (format.font_align_.value() == FontAlign::center) {
+      } else if (format.font_align_ == FontAlign::center) {
         result += 'c';
-      } else if (format.font_align_.value() == FontAlign::right) {
+      } else if (format.font_align_ == FontAlign::right) {
         result += 'r';
       }
     }
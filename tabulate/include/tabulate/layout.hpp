@@ -0,0 +1,125 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tabulate {
+
+// A single visual line of a laid out cell
+// offset and length refer to CellLayout::text(), width is the display width
+struct LineSpan {
+  size_t offset;
+  size_t length;
+  size_t width;
+};
+
+class NestedLayout;
+
+// Result of word wrapping a cell exactly once for the width of its column
+class CellLayout {
+public:
+  size_t height() const { return lines.size(); }
+
+  std::string line(size_t index) const {
+    return std::string(text() + lines[index].offset, lines[index].length);
+  }
+
+  // Text the lines refer to: the text of the cell in its table, which is not
+  // copied, until the layout rewrites it, e.g., to word wrap it
+  const char *text() const { return view_ != nullptr ? view_ : text_.data(); }
+  size_t text_size() const { return view_ != nullptr ? view_size_ : text_.size(); }
+
+  // Refers to text, which must not change while the layout is in use
+  void view_text(const char *text, size_t size) {
+    view_ = text;
+    view_size_ = size;
+    text_.clear();
+  }
+
+  // Replaces the text with text of the layout's own
+  void set_text(std::string &&text) {
+    text_ = std::move(text);
+    view_ = nullptr;
+  }
+
+  std::vector<LineSpan> lines;
+  unsigned text_class{0}; // TextClass flags of text()
+
+  // Layout of the table nested in the cell, if any, which is rendered in
+  // place one line at a time. Its lines have no text, only a width
+  std::unique_ptr<NestedLayout> nested;
+
+private:
+  const char *view_{nullptr};
+  size_t view_size_{0};
+  std::string text_; // rewritten text, used when view_ is nullptr
+};
+
+// Dimensions and per-cell line spans of a whole table
+// Computed once per print by Printer::compute_layout() and then shared by
+// the height, width and printing stages
+// The cells may be laid out for a window of rows only, e.g., the rows shown by
+// a Viewport, see Printer::layout_rows()
+class TableLayout {
+public:
+  size_t num_rows() const { return row_heights.size(); }
+
+  size_t num_columns() const { return column_widths.size(); }
+
+  CellLayout &cell(size_t row, size_t column) {
+    return cells[(row - first_row) * num_columns() + column];
+  }
+
+  const CellLayout &cell(size_t row, size_t column) const {
+    return cells[(row - first_row) * num_columns() + column];
+  }
+
+  std::vector<size_t> row_heights;
+  std::vector<size_t> column_widths;
+  size_t first_row{0};           // row of the first cells
+  std::vector<CellLayout> cells; // row-major, from first_row on
+};
+
+// A table nested in a cell, laid out for the width of the column of the cell
+class NestedLayout {
+public:
+  TableLayout layout;
+  std::vector<size_t> line_offsets; // see Printer::compute_line_offsets()
+};
+
+} // namespace tabulate
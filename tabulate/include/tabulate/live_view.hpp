@@ -0,0 +1,219 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <tabulate/table.hpp>
+#include <tabulate/viewport.hpp>
+#include <vector>
+
+namespace tabulate {
+
+// Redraws a table in place on a terminal, e.g., a dashboard refreshed every
+// second, writing only what changed since the previous frame
+//
+//   LiveView view(std::cout);
+//   while (running) {
+//     update(table);
+//     view.render(table);
+//     std::this_thread::sleep_for(std::chrono::seconds(1));
+//   }
+//
+// The previous frame is kept, each line of the new frame is compared with the
+// line drawn before it and only the changed ones are rewritten using cursor
+// movements. Within an uncolored line only the changed characters are
+// rewritten. The frame has to fit on the screen, lines scrolled out of it can
+// no longer be reached by the cursor.
+class LiveView {
+public:
+  explicit LiveView(std::ostream &stream) : stream_(stream) {}
+
+  LiveView(const LiveView &) = delete;
+  LiveView &operator=(const LiveView &) = delete;
+
+  // Draws table over the previous frame, or below the cursor for the first
+  // frame. The cursor is left at the start of the line below the frame
+  void render(Table &table) {
+    std::string frame;
+    StyleState style = frame_style(frame);
+    Printer::print_table(frame, style, *table.table_);
+    draw(frame);
+  }
+
+  // Draws the lines in the window of viewport, e.g., after scrolling it
+  void render(Viewport &viewport) {
+    std::string frame;
+    StyleState style = frame_style(frame);
+    viewport.print(frame, style);
+    draw(frame);
+  }
+
+  // Forgets the previous frame, the next frame is drawn below the cursor
+  void reset() {
+    frame_.clear();
+    lines_.clear();
+    row_ = 0;
+  }
+
+  // Number of bytes written by the last render()
+  size_t last_update_size() const { return last_update_size_; }
+
+private:
+  struct Line {
+    size_t offset;
+    size_t length;
+  };
+
+  StyleState frame_style(std::string &frame) {
+#if defined(_WIN32) || defined(_WIN64)
+    // Colors are set through the console API there, which cannot be
+    // replayed from a frame, so frames are kept plain
+    return StyleState(frame);
+#else
+    return StyleState(frame, stream_);
+#endif
+  }
+
+  void draw(std::string &frame) {
+    std::vector<Line> lines;
+    size_t start{0};
+    while (start < frame.size()) {
+      auto end = frame.find('\n', start);
+      if (end == std::string::npos)
+        end = frame.size();
+      lines.push_back({start, end - start});
+      start = end + 1;
+    }
+
+    std::string output;
+    update(output, frame, lines);
+    stream_.write(output.data(), static_cast<std::streamsize>(output.size()));
+    stream_.flush();
+    last_update_size_ = output.size();
+
+    frame_.swap(frame);
+    lines_.swap(lines);
+  }
+
+  void update(std::string &output, const std::string &frame, const std::vector<Line> &lines) {
+    auto common_lines = std::min(lines.size(), lines_.size());
+    for (size_t i = 0; i < common_lines; ++i)
+      update_line(output, i, frame, lines[i]);
+
+    if (lines.size() > lines_.size()) {
+      // New lines are printed below the previous frame, scrolling if needed
+      move_to(output, lines_.size());
+      for (size_t i = lines_.size(); i < lines.size(); ++i) {
+        output.append(frame, lines[i].offset, lines[i].length);
+        output += '\n';
+      }
+      row_ = lines.size();
+    } else if (lines.size() < lines_.size()) {
+      // Erase the lines left from the previous frame
+      move_to(output, lines.size());
+      output += "\033[J";
+    }
+    // The cursor is still at the start of the line below the frame if
+    // nothing changed
+    if (!output.empty())
+      move_to(output, lines.size());
+  }
+
+  void update_line(std::string &output, size_t row, const std::string &frame, const Line &line) {
+    const char *text = frame.data() + line.offset;
+    const char *old_text = frame_.data() + lines_[row].offset;
+    auto size = line.length, old_size = lines_[row].length;
+    if (size == old_size && std::memcmp(text, old_text, size) == 0)
+      return;
+
+    move_to(output, row);
+    if (std::memchr(text, '\033', size) != nullptr ||
+        std::memchr(old_text, '\033', old_size) != nullptr) {
+      // Escape sequences have no width, the whole styled line is rewritten
+      output.append(text, size);
+      output += "\033[K";
+      return;
+    }
+
+    // Skip the unchanged characters at both ends of the line
+    auto is_continuation = [](char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; };
+    size_t prefix{0};
+    while (prefix < size && prefix < old_size && text[prefix] == old_text[prefix])
+      ++prefix;
+    while (prefix > 0 && ((prefix < size && is_continuation(text[prefix])) ||
+                          (prefix < old_size && is_continuation(old_text[prefix]))))
+      --prefix;
+    size_t suffix{0};
+    while (suffix < size - prefix && suffix < old_size - prefix &&
+           text[size - suffix - 1] == old_text[old_size - suffix - 1])
+      ++suffix;
+    while (suffix > 0 && (is_continuation(text[size - suffix]) ||
+                          is_continuation(old_text[old_size - suffix])))
+      --suffix;
+
+    auto column = get_sequence_length(text, prefix, true);
+    if (column > 0)
+      output += "\033[" + std::to_string(column + 1) + "G";
+
+    auto changed = size - suffix - prefix, old_changed = old_size - suffix - prefix;
+    if (get_sequence_length(text + prefix, changed, true) ==
+        get_sequence_length(old_text + prefix, old_changed, true)) {
+      // Same width, the end of the line stays where it is
+      output.append(text + prefix, changed);
+    } else {
+      output.append(text + prefix, size - prefix);
+      output += "\033[K";
+    }
+  }
+
+  // Moves the cursor to the start of a line of the frame
+  void move_to(std::string &output, size_t row) {
+    if (row < row_)
+      output += "\033[" + std::to_string(row_ - row) + "A";
+    else if (row > row_)
+      output += "\033[" + std::to_string(row - row_) + "B";
+    output += '\r';
+    row_ = row;
+  }
+
+  std::ostream &stream_;
+  std::string frame_;
+  std::vector<Line> lines_; // lines of frame_
+  size_t row_{0};           // line of the frame the cursor is on
+  size_t last_update_size_{0};
+};
+
+} // namespace tabulate
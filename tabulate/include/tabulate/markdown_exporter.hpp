@@ -38,71 +38,60 @@ namespace tabulate {
 
 class MarkdownExporter : public Exporter {
 public:
+  using Exporter::dump;
+
+  // The markdown borders are applied to a copy of the table, which is left
+  // untouched and can be printed by other threads meanwhile
   std::string dump(Table &table) override {
-    std::string result{""};
-    apply_markdown_format(table);
-    result = table.str();
-    restore_table_format(table);
-    return result;
+    Table copy;
+    copy.table_ = table.table_->clone();
+    copy.rows_ = table.rows_;
+    copy.cols_ = table.cols_;
+    apply_markdown_format(copy);
+    return copy.str();
   }
 
 private:
   void add_alignment_header_row(Table &table) {
-    auto &rows = table.table_->rows_;
-
-    if (rows.size() >= 1) {
-      auto alignment_row = std::make_shared<Row>(table.table_->shared_from_this());
+    auto &storage = *table.table_;
 
+    if (storage.size() >= 1) {
       // Create alignment header cells
       std::vector<std::string> alignment_cells{};
       for (auto &cell : table[0]) {
-        auto format = cell.format();
-        if (format.font_align_.value() == FontAlign::left) {
+        const Format &format = cell.resolved_format();
+        if (format.font_align_ == FontAlign::left) {
           alignment_cells.push_back(":----");
-        } else if (format.font_align_.value() == FontAlign::center) {
+        } else if (format.font_align_ == FontAlign::center) {
           alignment_cells.push_back(":---:");
-        } else if (format.font_align_.value() == FontAlign::right) {
+        } else if (format.font_align_ == FontAlign::right) {
           alignment_cells.push_back("----:");
         }
       }
 
-      // Add alignment header cells to alignment row
-      for (auto &c : alignment_cells) {
-        auto cell = std::make_shared<Cell>(alignment_row);
-        cell->format()
+      // Insert alignment header row
+      storage.insert_row(1, alignment_cells);
+      for (auto &cell : storage[1]) {
+        cell.format()
             .hide_border_top()
             .hide_border_bottom()
             .border_left("|")
             .border_right("|")
             .column_separator("|")
             .corner("|");
-        cell->set_text(c);
-        if (c == ":---:")
-          cell->format().font_align(FontAlign::center);
-        else if (c == "----:")
-          cell->format().font_align(FontAlign::right);
-        alignment_row->add_cell(cell);
+        auto text = cell.get_text();
+        if (text == ":---:")
+          cell.format().font_align(FontAlign::center);
+        else if (text == "----:")
+          cell.format().font_align(FontAlign::right);
       }
-
-      // Insert alignment header row
-      if (rows.size() > 1)
-        rows.insert(rows.begin() + 1, alignment_row);
-      else
-        rows.push_back(alignment_row);
     }
   }
 
-  void remove_alignment_header_row(Table &table) {
-    auto &rows = table.table_->rows_;
-    table.table_->rows_.erase(rows.begin() + 1);
-  }
-
   void apply_markdown_format(Table &table) {
     // Apply markdown format to cells in each row
     for (auto row : table) {
       for (auto &cell : row) {
-        auto format = cell.format();
-        formats_.push_back(format);
         cell.format()
             .hide_border_top()
             .hide_border_bottom()
@@ -115,22 +104,6 @@ private:
     // Add alignment header row at position 1
     add_alignment_header_row(table);
   }
-
-  void restore_table_format(Table &table) {
-    // Remove alignment header row at position 1
-    remove_alignment_header_row(table);
-
-    // Restore original formatting for each cell
-    size_t format_index{0};
-    for (auto row : table) {
-      for (auto &cell : row) {
-        cell.format() = formats_[format_index];
-        format_index += 1;
-      }
-    }
-  }
-
-  std::vector<Format> formats_;
 };
 
 } // namespace tabulate
@@ -34,177 +34,155 @@ SOFTWARE.
 #pragma once
 #include <tabulate/color.hpp>
 #include <tabulate/font_style.hpp>
+#include <tabulate/layout.hpp>
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace tabulate {
 
-class Printer {
+// Tracks the colors and font styles last written to a rendered table so that
+// escape sequences are only emitted when the style of the printed text changes.
+// Nothing is emitted for streams that are not colorized, e.g., files and pipes,
+// nor for tables rendered into a string
+class StyleState {
 public:
-  static std::pair<std::vector<size_t>, std::vector<size_t>>
-  compute_cell_dimensions(TableInternal &table);
+  // Styles the text rendered into buffer before it is written to stream
+  StyleState(std::string &buffer, std::ostream &stream)
+      : buffer_(buffer), stream_(&stream),
+        colorized_(termcolor::_internal::is_colorized(stream)) {}
 
-  static void print_table(std::ostream &stream, TableInternal &table);
+  explicit StyleState(std::string &buffer) : buffer_(buffer), stream_(nullptr), colorized_(false) {}
 
-  static void print_row_in_cell(std::ostream &stream, TableInternal &table,
-                                const std::pair<size_t, size_t> &index,
-                                const std::pair<size_t, size_t> &dimension, size_t num_columns,
-                                size_t row_index);
+  // Styles the text rendered into another buffer for the same stream as
+  // other, starting from the default style, see can_fork()
+  StyleState(std::string &buffer, const StyleState &other)
+      : buffer_(buffer), stream_(other.stream_), colorized_(other.colorized_) {}
 
-  static bool print_cell_border_top(std::ostream &stream, TableInternal &table,
-                                    const std::pair<size_t, size_t> &index,
-                                    const std::pair<size_t, size_t> &dimension, size_t num_columns);
-  static bool print_cell_border_bottom(std::ostream &stream, TableInternal &table,
-                                       const std::pair<size_t, size_t> &index,
-                                       const std::pair<size_t, size_t> &dimension,
-                                       size_t num_columns);
+  // Whether colors and font styles are rendered at all
+  bool colorized() const { return colorized_; }
 
-  static void apply_element_style(std::ostream &stream, Color foreground_color,
-                                  Color background_color,
-                                  const std::vector<FontStyle> &font_style) {
-    apply_foreground_color(stream, foreground_color);
-    apply_background_color(stream, background_color);
-    for (auto &style : font_style)
-      apply_font_style(stream, style);
+  // Whether parts of a table can be styled into separate buffers and
+  // concatenated afterwards, which is not the case where colors are set
+  // through the console API as the buffer is written
+  bool can_fork() const {
+#if defined(_WIN32) || defined(_WIN64)
+    return !colorized_;
+#else
+    return true;
+#endif
   }
 
-  static void reset_element_style(std::ostream &stream) { stream << termcolor::reset; }
+  // font_styles is a bitmask of font_style_bit values
+  void apply(Color foreground_color, Color background_color, unsigned font_styles) {
+    if (!colorized_)
+      return;
 
-private:
-  static void print_content_left_aligned(std::ostream &stream, const std::string &cell_content,
-                                         const Format &format, size_t text_with_padding_size,
-                                         size_t column_width) {
+    // Colors and font styles can only be switched off all at once
+    if ((font_styles_ & ~font_styles) != 0 ||
+        (foreground_color == Color::none && foreground_color_ != Color::none) ||
+        (background_color == Color::none && background_color_ != Color::none))
+      reset();
 
-    // Apply font style
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                        *format.font_style_);
-    stream << cell_content;
-    // Only apply font_style to the font
-    // Not the padding. So calling apply_element_style with font_style = {}
-    reset_element_style(stream);
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-
-    if (text_with_padding_size < column_width) {
-      for (size_t j = 0; j < (column_width - text_with_padding_size); ++j) {
-        stream << " ";
-      }
+    if (foreground_color != foreground_color_)
+      apply_foreground_color(foreground_color);
+    if (background_color != background_color_)
+      apply_background_color(background_color);
+    for (auto style : {FontStyle::bold, FontStyle::dark, FontStyle::italic, FontStyle::underline,
+                       FontStyle::blink, FontStyle::reverse, FontStyle::concealed,
+                       FontStyle::crossed}) {
+      if ((font_styles & ~font_styles_ & font_style_bit(style)) != 0)
+        apply_font_style(style);
     }
-  }
 
-  static void print_content_center_aligned(std::ostream &stream, const std::string &cell_content,
-                                           const Format &format, size_t text_with_padding_size,
-                                           size_t column_width) {
-    auto num_spaces = column_width - text_with_padding_size;
-    if (num_spaces % 2 == 0) {
-      // Even spacing on either side
-      for (size_t j = 0; j < num_spaces / 2; ++j)
-        stream << " ";
-
-      // Apply font style
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                          *format.font_style_);
-      stream << cell_content;
-      // Only apply font_style to the font
-      // Not the padding. So calling apply_element_style with font_style = {}
-      reset_element_style(stream);
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-
-      for (size_t j = 0; j < num_spaces / 2; ++j)
-        stream << " ";
-    } else {
-      auto num_spaces_before = num_spaces / 2 + 1;
-      for (size_t j = 0; j < num_spaces_before; ++j)
-        stream << " ";
-
-      // Apply font style
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                          *format.font_style_);
-      stream << cell_content;
-      // Only apply font_style to the font
-      // Not the padding. So calling apply_element_style with font_style = {}
-      reset_element_style(stream);
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-
-      for (size_t j = 0; j < num_spaces - num_spaces_before; ++j)
-        stream << " ";
-    }
+    foreground_color_ = foreground_color;
+    background_color_ = background_color;
+    font_styles_ = font_styles;
   }
 
-  static void print_content_right_aligned(std::ostream &stream, const std::string &cell_content,
-                                          const Format &format, size_t text_with_padding_size,
-                                          size_t column_width) {
-    if (text_with_padding_size < column_width) {
-      for (size_t j = 0; j < (column_width - text_with_padding_size); ++j) {
-        stream << " ";
-      }
-    }
+  // Returns the text to its default style, if anything was applied
+  void reset() {
+    if (foreground_color_ == Color::none && background_color_ == Color::none &&
+        font_styles_ == 0)
+      return;
+    emit("\033[00m", termcolor::reset);
+    foreground_color_ = Color::none;
+    background_color_ = Color::none;
+    font_styles_ = 0;
+  }
 
-    // Apply font style
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                        *format.font_style_);
-    stream << cell_content;
-    // Only apply font_style to the font
-    // Not the padding. So calling apply_element_style with font_style = {}
-    reset_element_style(stream);
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
+private:
+  void emit(const char *sequence, std::ostream &(*manipulator)(std::ostream &)) {
+#if defined(_WIN32) || defined(_WIN64)
+    // The console colors are changed through the console API and not with
+    // escape sequences, so the text rendered so far has to be written first
+    (void)sequence;
+    stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+    *stream_ << manipulator;
+#else
+    (void)manipulator;
+    buffer_ += sequence;
+#endif
   }
 
-  static void apply_font_style(std::ostream &stream, FontStyle style) {
+  void apply_font_style(FontStyle style) {
     switch (style) {
     case FontStyle::bold:
-      stream << termcolor::bold;
+      emit("\033[1m", termcolor::bold);
       break;
     case FontStyle::dark:
-      stream << termcolor::dark;
+      emit("\033[2m", termcolor::dark);
       break;
     case FontStyle::italic:
-      stream << termcolor::italic;
+      emit("\033[3m", termcolor::italic);
       break;
     case FontStyle::underline:
-      stream << termcolor::underline;
+      emit("\033[4m", termcolor::underline);
       break;
     case FontStyle::blink:
-      stream << termcolor::blink;
+      emit("\033[5m", termcolor::blink);
       break;
     case FontStyle::reverse:
-      stream << termcolor::reverse;
+      emit("\033[7m", termcolor::reverse);
       break;
     case FontStyle::concealed:
-      stream << termcolor::concealed;
+      emit("\033[8m", termcolor::concealed);
       break;
     case FontStyle::crossed:
-      stream << termcolor::crossed;
+      emit("\033[9m", termcolor::crossed);
       break;
     default:
       break;
     }
   }
 
-  static void apply_foreground_color(std::ostream &stream, Color foreground_color) {
+  void apply_foreground_color(Color foreground_color) {
     switch (foreground_color) {
     case Color::grey:
-      stream << termcolor::grey;
+      emit("\033[30m", termcolor::grey);
       break;
     case Color::red:
-      stream << termcolor::red;
+      emit("\033[31m", termcolor::red);
       break;
     case Color::green:
-      stream << termcolor::green;
+      emit("\033[32m", termcolor::green);
       break;
     case Color::yellow:
-      stream << termcolor::yellow;
+      emit("\033[33m", termcolor::yellow);
       break;
     case Color::blue:
-      stream << termcolor::blue;
+      emit("\033[34m", termcolor::blue);
       break;
     case Color::magenta:
-      stream << termcolor::magenta;
+      emit("\033[35m", termcolor::magenta);
       break;
     case Color::cyan:
-      stream << termcolor::cyan;
+      emit("\033[36m", termcolor::cyan);
       break;
     case Color::white:
-      stream << termcolor::white;
+      emit("\033[37m", termcolor::white);
       break;
     case Color::none:
     default:
@@ -212,37 +190,289 @@ private:
     }
   }
 
-  static void apply_background_color(std::ostream &stream, Color background_color) {
+  void apply_background_color(Color background_color) {
     switch (background_color) {
     case Color::grey:
-      stream << termcolor::on_grey;
+      emit("\033[40m", termcolor::on_grey);
       break;
     case Color::red:
-      stream << termcolor::on_red;
+      emit("\033[41m", termcolor::on_red);
       break;
     case Color::green:
-      stream << termcolor::on_green;
+      emit("\033[42m", termcolor::on_green);
       break;
     case Color::yellow:
-      stream << termcolor::on_yellow;
+      emit("\033[43m", termcolor::on_yellow);
       break;
     case Color::blue:
-      stream << termcolor::on_blue;
+      emit("\033[44m", termcolor::on_blue);
       break;
     case Color::magenta:
-      stream << termcolor::on_magenta;
+      emit("\033[45m", termcolor::on_magenta);
       break;
     case Color::cyan:
-      stream << termcolor::on_cyan;
+      emit("\033[46m", termcolor::on_cyan);
       break;
     case Color::white:
-      stream << termcolor::on_white;
+      emit("\033[47m", termcolor::on_white);
       break;
     case Color::none:
     default:
       break;
     }
   }
+
+  std::string &buffer_;
+  std::ostream *stream_;
+  bool colorized_;
+  Color foreground_color_{Color::none};
+  Color background_color_{Color::none};
+  unsigned font_styles_{0};
+};
+
+// Top borders of the rows printed so far within one layout of a table
+// Rows whose cells resolve to the same formats have the same top border: it
+// is rendered for the first of them and copied for the others
+class BorderLines {
+public:
+  void clear() { lines_.clear(); }
+
+private:
+  friend class Printer;
+
+  struct Line {
+    std::vector<uint32_t> formats; // resolved format of each cell of the row
+    std::string text;              // rendered top border, reset and newline included
+  };
+
+  // Rows with more distinct formats than this render their top border
+  static const size_t max_lines = 8;
+
+  std::vector<Line> lines_;
+};
+
+class Printer {
+public:
+  // Measures, word wraps and sizes every cell of the table exactly once
+  static TableLayout compute_layout(const TableInternal &table);
+
+  // Lays out the table for the given column widths instead of measuring its
+  // columns, columns past the end of column_widths are still measured
+  static TableLayout compute_layout(const TableInternal &table,
+                                    const std::vector<size_t> &column_widths);
+
+  // Measures the cells of a row of layout, then raises configured_widths and
+  // computed_widths to the widths its cells are given and need
+  static void measure_row(const TableInternal &table, TableLayout &layout, size_t row,
+                          std::vector<size_t> &configured_widths,
+                          std::vector<size_t> &computed_widths);
+
+  // Word wraps the measured cells of a row for the column widths of layout
+  // and works out the height of the row
+  static void wrap_row(const TableInternal &table, TableLayout &layout, size_t row);
+
+  // Column widths and row heights of the table, the same as compute_layout()
+  // works out, with no cells laid out: rows are laid out batch_rows at a
+  // time and dropped, see layout_rows()
+  static TableLayout compute_dimensions(const TableInternal &table, size_t batch_rows = 1024);
+
+  // Lays out the cells of the rows [first, last) of the table for the column
+  // widths of layout, in place of the cells layout had
+  static void layout_rows(const TableInternal &table, TableLayout &layout, size_t first,
+                          size_t last);
+
+  static std::pair<std::vector<size_t>, std::vector<size_t>>
+  compute_cell_dimensions(const TableInternal &table);
+
+  // Display width of the first line and number of lines of the rendered
+  // table, worked out from its layout without rendering it, the lines being
+  // separated by '\n'
+  static std::pair<size_t, size_t> compute_shape(const TableInternal &table);
+
+  // Index of the line of the rendered table on which each row starts, its
+  // top border included, followed by the number of lines of the table
+  // The last row also spans the bottom border of the table
+  static std::vector<size_t> compute_line_offsets(const TableInternal &table,
+                                                  const TableLayout &layout);
+
+  // Display width of each line of the rendered table, an empty last line
+  // included, e.g., below a hidden bottom border
+  static std::vector<size_t> compute_line_widths(const TableInternal &table,
+                                                 const TableLayout &layout);
+
+  // Renders the whole table into one buffer and writes it to stream at once
+  static void print_table(std::ostream &stream, const TableInternal &table);
+
+  // Appends the rendered table, without colors, to buffer
+  static void print_table(std::string &buffer, const TableInternal &table);
+
+  // Appends the rendered table to buffer, styled through style
+  static void print_table(std::string &buffer, StyleState &style, const TableInternal &table);
+
+  // Same as print_table() for a table caching its rows: only the rows changed
+  // since the last print are measured, and rendered again along with the
+  // last row, the others are copied as they were rendered
+  // Every row is rendered again when the column widths change
+  static void print_cached_table(std::string &buffer, StyleState &style,
+                                 const TableInternal &table);
+
+  // Prints the rows [first, last) of the table, each but the first row of the
+  // table preceded by a newline, then the bottom border of the table if last
+  // is its number of rows, and leaves style reset
+  static void print_rows(std::string &buffer, StyleState &style, const TableInternal &table,
+                         const TableLayout &layout, size_t first, size_t last);
+
+  // Prints the top border and the word-wrapped lines of a row of the table
+  // The lines are separated by '\n', there is none after the last line
+  // The row has to start a line, in the default style. Given borders, which
+  // must only be used with layout, top borders are copied from earlier rows
+  static void print_row(std::string &buffer, StyleState &style, const TableInternal &table,
+                        const TableLayout &layout, size_t row,
+                        BorderLines *borders = nullptr);
+
+  // Prints a single line of the rendered table, given the line offsets of
+  // its layout, without newline and leaving style reset
+  static void print_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                         const TableLayout &layout, const std::vector<size_t> &line_offsets,
+                         size_t line);
+
+  // Prints the bottom borders of the cells of a row, on a single line
+  static void print_bottom_border(std::string &buffer, StyleState &style, const TableInternal &table,
+                                  const std::vector<size_t> &column_widths, size_t row);
+
+  static void print_row_in_cell(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const CellLayout &cell_layout,
+                                const std::pair<size_t, size_t> &index,
+                                const std::pair<size_t, size_t> &dimension, size_t num_columns,
+                                size_t row_index);
+
+  static bool print_cell_border_top(std::string &buffer, StyleState &style, const TableInternal &table,
+                                    const std::pair<size_t, size_t> &index,
+                                    const std::pair<size_t, size_t> &dimension, size_t num_columns);
+  static bool print_cell_border_bottom(std::string &buffer, StyleState &style,
+                                       const TableInternal &table,
+                                       const std::pair<size_t, size_t> &index,
+                                       const std::pair<size_t, size_t> &dimension,
+                                       size_t num_columns);
+
+private:
+
+  // Display widths of what print_row_in_cell, print_cell_border_top and
+  // print_cell_border_bottom print, the border functions return false where
+  // their counterparts print nothing
+  static size_t row_in_cell_width(const Format &format, const CellLayout &cell_layout,
+                                  size_t column_width, bool last_column, size_t row_index);
+  static bool cell_border_top_width(const Format &format, size_t column_width, bool last_column,
+                                    size_t &width);
+  static bool cell_border_bottom_width(const Format &format, size_t column_width,
+                                       bool last_column, size_t &width);
+
+  // Upper bound of the size of the rendered table, escape sequences aside
+  static size_t estimate_rendered_size(const TableInternal &table, const TableLayout &layout);
+
+  // Replaces every '\t' of the text of cell_layout with spaces up to the next
+  // multiple of 8 columns of its line, so that the printed text is as wide as
+  // it was measured, tabs being as wide as the column they start at allows
+  static void expand_tabs(CellLayout &cell_layout, const Format &format);
+
+  // Splits the text of cell_layout at its embedded '\n' characters into lines,
+  // text_class has to describe the text
+  // A trailing empty line is dropped, e.g., "abc\n" is a single line
+  static void split_cell_lines(CellLayout &cell_layout, const Format &format);
+
+  // Lays out the table nested in a cell with the given column widths, or at
+  // its natural width if there are none, and gives the cell a line of that
+  // width for every line of the table
+  static void layout_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                  const std::vector<size_t> &column_widths = {});
+
+  // Lays the table nested in a cell out again, its widest columns narrowed,
+  // if it is wider than width
+  static void fit_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                               size_t width);
+
+  // Prints a line of table, nested in a cell laid out as cell_layout, aligned
+  // like text between the paddings of the cell
+  static void print_nested_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const CellLayout &cell_layout, const Format &format,
+                                size_t column_width, size_t line);
+
+  // Replaces the natural lines of cell_layout with the lines to print for the
+  // given column width, word wrapping or truncating its text if it does not
+  // fit, depending on the overflow of format
+  static void wrap_cell_lines(CellLayout &cell_layout, const Format &format,
+                              size_t column_width);
+
+  // Cuts the first line of cell_layout to width display columns and drops the
+  // other lines, the cut line ends with an ellipsis if any text is left out
+  // The text is scanned once, up to the cut
+  static void truncate_cell_lines(CellLayout &cell_layout, const Format &format, size_t width);
+
+  // Trims white spaces from both ends of a line and updates its display width
+  static LineSpan trim_line(const char *text, LineSpan line, const Format &format);
+
+  // Appends count copies of glyph, which may be a multi-byte character
+  static void append_repeated(std::string &buffer, const std::string &glyph, size_t count) {
+    if (glyph.size() == 1) {
+      buffer.append(count, glyph[0]);
+      return;
+    }
+    for (size_t i = 0; i < count; ++i)
+      buffer += glyph;
+  }
+
+  static void print_content_left_aligned(std::string &buffer, StyleState &style,
+                                         const char *text, const LineSpan &line,
+                                         const Format &format, size_t text_with_padding_size,
+                                         size_t column_width) {
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+
+    if (text_with_padding_size < column_width)
+      buffer.append(column_width - text_with_padding_size, ' ');
+  }
+
+  static void print_content_center_aligned(std::string &buffer, StyleState &style,
+                                           const char *text, const LineSpan &line,
+                                           const Format &format, size_t text_with_padding_size,
+                                           size_t column_width) {
+    // A line wider than the column, e.g. with padding wider than a fixed
+    // column width, is printed without any space around it
+    auto num_spaces =
+        text_with_padding_size < column_width ? column_width - text_with_padding_size : 0;
+    // Odd spacing puts the extra space before the text
+    auto num_spaces_before = num_spaces / 2 + num_spaces % 2;
+    buffer.append(num_spaces_before, ' ');
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+
+    buffer.append(num_spaces - num_spaces_before, ' ');
+  }
+
+  static void print_content_right_aligned(std::string &buffer, StyleState &style,
+                                          const char *text, const LineSpan &line,
+                                          const Format &format, size_t text_with_padding_size,
+                                          size_t column_width) {
+    if (text_with_padding_size < column_width)
+      buffer.append(column_width - text_with_padding_size, ' ');
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+  }
 };
 
 } // namespace tabulate
@@ -48,6 +48,10 @@ using nonstd::variant;
 using nonstd::visit;
 #endif
 
+#include <algorithm>
+#include <deque>
+#include <tabulate/table_model.hpp>
+#include <type_traits>
 #include <utility>
 
 namespace tabulate {
@@ -57,38 +61,85 @@ public:
   Table() : table_(TableInternal::create()) {}
 
   Table &add_row(const std::vector<variant<std::string, const char *, Table>> &cells) {
-
-    if (rows_ == 0) {
-      // This is the first row added
-      // cells.size() is the number of columns
-      cols_ = cells.size();
+    // Texts are copied once, straight from cells into the table
+    std::vector<TableInternal::TextRef> texts;
+    texts.reserve(cells.size());
+    std::string self;
+    bool self_printed{false};
+    for (auto &cell : cells) {
+      if (auto text = get_if<std::string>(&cell)) {
+        texts.push_back(TableInternal::text_ref(*text));
+      } else if (auto text = get_if<const char *>(&cell)) {
+        texts.push_back(TableInternal::text_ref(*text));
+      } else if (get_if<Table>(&cell)->table_ == table_) {
+        // A table nested in itself is rendered as it is now
+        if (!self_printed)
+          print(self);
+        self_printed = true;
+        texts.push_back(TableInternal::text_ref(self));
+      } else {
+        texts.push_back(TableInternal::text_ref(""));
+      }
     }
 
-    std::vector<std::string> cell_strings;
-    if (cells.size() < cols_) {
-      cell_strings.resize(cols_);
-      std::fill(cell_strings.begin(), cell_strings.end(), "");
-    } else {
-      cell_strings.resize(cells.size());
-      std::fill(cell_strings.begin(), cell_strings.end(), "");
-    }
+    auto row = table_->size();
+    append_row(texts);
 
+    // Other nested tables are kept as they are and rendered with this table
     for (size_t i = 0; i < cells.size(); ++i) {
-      auto cell = cells[i];
-      if (holds_alternative<std::string>(cell)) {
-        cell_strings[i] = *get_if<std::string>(&cell);
-      } else if (holds_alternative<const char *>(cell)) {
-        cell_strings[i] = *get_if<const char *>(&cell);
-      } else {
-        auto table = *get_if<Table>(&cell);
-        std::stringstream stream;
-        table.print(stream);
-        cell_strings[i] = stream.str();
-      }
+      auto nested = get_if<Table>(&cells[i]);
+      if (nested != nullptr && nested->table_ != table_)
+        table_->set_cell_table(table_->cell_index(row, i), nested->table_);
     }
+    return *this;
+  }
 
-    table_->add_row(cell_strings);
-    rows_ += 1;
+  // Adds a row with a cell for every argument, std::string or C string
+  // Unlike add_row(), no vector of cells is built, every text is copied once,
+  // straight into the table
+  //
+  //   table.emplace_row(contact.alias, contact.uri, "online");
+  template <typename... Cells> Table &emplace_row(const Cells &...cells) {
+    append_row(std::initializer_list<TableInternal::TextRef>{TableInternal::text_ref(cells)...});
+    return *this;
+  }
+
+  // Adds a row for every element of rows, itself a range of std::string or C
+  // strings, e.g., a std::vector<std::vector<std::string>>
+  template <typename Rows,
+            typename std::enable_if<!std::is_base_of<TableModel, Rows>::value, int>::type = 0>
+  Table &add_rows(const Rows &rows) {
+    for (auto &cells : rows)
+      append_row(cells);
+    return *this;
+  }
+
+  // Adds the rows of a table model, pulling their cells one row at a time
+  // Every cell is copied into the table, a Viewport or a TableStream shows
+  // the rows of a model without holding all of them
+  Table &add_rows(const TableModel &model) {
+    table_->reserve(table_->size() + model.num_rows(), std::max(cols_, model.num_columns()));
+    std::vector<std::string> cells(model.num_columns());
+    for (size_t row = 0; row < model.num_rows(); ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model.cell(row, column);
+      append_row(cells);
+    }
+    return *this;
+  }
+
+  // Makes room for rows rows of columns cells in total, e.g., before adding a
+  // known number of rows
+  Table &reserve(size_t rows, size_t columns) {
+    table_->reserve(rows, columns);
+    return *this;
+  }
+
+  // Keeps every row rendered between prints, so that printing the table
+  // again only renders the rows changed since and copies the others, at the
+  // cost of keeping a copy of the rendered table
+  Table &cache_rows(bool enabled = true) {
+    table_->cache_rows(enabled);
     return *this;
   }
 
@@ -96,33 +147,43 @@ public:
 
   Row &row(size_t index) { return (*table_)[index]; }
 
+  const Row &operator[](size_t index) const { return row(index); }
+
+  const Row &row(size_t index) const { return static_cast<const TableInternal &>(*table_)[index]; }
+
   Column column(size_t index) { return table_->column(index); }
 
   Format &format() { return table_->format(); }
 
-  void print(std::ostream &stream) { table_->print(stream); }
+  // Printing does not modify the table, so tables, the same one included,
+  // can be printed from several threads as long as none is being modified
+  void print(std::ostream &stream) const { table_->print(stream); }
 
-  std::string str() {
-    std::stringstream stream;
-    print(stream);
-    return stream.str();
+  // Appends the rendered table to buffer, e.g., to collect several tables
+  // before writing them out at once
+  void print(std::string &buffer) const { table_->print(buffer); }
+
+  std::string str() const {
+    std::string buffer;
+    print(buffer);
+    return buffer;
   }
 
-  std::pair<size_t, size_t> shape() { return table_->shape(); }
+  std::pair<size_t, size_t> shape() const { return table_->shape(); }
 
   class RowIterator {
   public:
-    explicit RowIterator(std::vector<std::shared_ptr<Row>>::iterator ptr) : ptr(ptr) {}
+    explicit RowIterator(std::deque<Row>::iterator ptr) : ptr(ptr) {}
 
     RowIterator operator++() {
       ++ptr;
       return *this;
     }
     bool operator!=(const RowIterator &other) const { return ptr != other.ptr; }
-    Row &operator*() { return **ptr; }
+    Row &operator*() { return *ptr; }
 
   private:
-    std::vector<std::shared_ptr<Row>>::iterator ptr;
+    std::deque<Row>::iterator ptr;
   };
 
   auto begin() -> RowIterator { return RowIterator(table_->rows_.begin()); }
@@ -132,15 +193,30 @@ private:
   friend class MarkdownExporter;
   friend class LatexExporter;
   friend class AsciiDocExporter;
+  friend class CsvExporter;
+  friend class TsvExporter;
+  friend class JsonExporter;
+  friend class LiveView;
+  friend class Viewport;
 
   friend std::ostream &operator<<(std::ostream &stream, const Table &table);
+
+  // Adds a row of cells, padded with empty cells up to the number of cells of
+  // the first row, which is the number of columns of the table
+  template <typename Cells> void append_row(const Cells &cells) {
+    table_->insert_row(table_->size(), cells, cols_);
+    if (rows_ == 0)
+      cols_ = table_->row_size(table_->size() - 1);
+    rows_ += 1;
+  }
+
   size_t rows_{0};
   size_t cols_{0};
   std::shared_ptr<TableInternal> table_;
 };
 
 inline std::ostream &operator<<(std::ostream &stream, const Table &table) {
-  const_cast<Table &>(table).print(stream);
+  table.print(stream);
   return stream;
 }
 
@@ -33,8 +33,14 @@ SOFTWARE.
 */
 #pragma once
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <tabulate/bands.hpp>
 #include <tabulate/column.hpp>
 #include <tabulate/font_style.hpp>
 #include <tabulate/printer.hpp>
@@ -58,390 +64,1536 @@ public:
     return result;
   }
 
-  void add_row(const std::vector<std::string> &cells) {
-    auto row = std::make_shared<Row>(shared_from_this());
-    for (auto &c : cells) {
-      auto cell = std::make_shared<Cell>(row);
-      cell->set_text(c);
-      row->add_cell(cell);
-    }
-    rows_.push_back(row);
+  void add_row(const std::vector<std::string> &cells) { insert_row(size(), cells); }
+
+  // Adds a row with a cell for every argument, std::string or C string,
+  // whose text is copied once, straight into the storage of the table
+  template <typename... Cells> void emplace_row(const Cells &...cells) {
+    insert_row(size(), std::initializer_list<TextRef>{text_ref(cells)...});
   }
 
-  Row &operator[](size_t index) { return *(rows_[index]); }
+  // Makes room for rows rows of columns cells in total, so that adding them
+  // does not grow the storage of the table several times
+  void reserve(size_t rows, size_t columns) {
+    cell_texts_.reserve(rows * columns);
+    cell_styles_.reserve(rows * columns);
+    row_offsets_.reserve(rows + 1);
+    row_styles_.reserve(rows);
+  }
 
-  const Row &operator[](size_t index) const { return *(rows_[index]); }
+  Row &operator[](size_t index) { return rows_[index]; }
 
-  Column column(size_t index) {
-    Column column(shared_from_this());
-    for (size_t i = 0; i < rows_.size(); ++i) {
-      auto row = rows_[i];
-      auto &cell = row->cell(index);
-      column.add_cell(cell);
-    }
-    return column;
-  }
+  const Row &operator[](size_t index) const { return rows_[index]; }
+
+  Column column(size_t index) { return Column(shared_from_this(), index); }
 
   size_t size() const { return rows_.size(); }
 
-  std::pair<size_t, size_t> shape() {
-    std::pair<size_t, size_t> result{0, 0};
-    std::stringstream stream;
-    print(stream);
-    auto buffer = stream.str();
-    auto lines = Format::split_lines(buffer, "\n", "", true);
-    if (lines.size()) {
-      result = {get_sequence_length(lines[0], "", true), lines.size()};
-    }
-    return result;
-  }
+  std::pair<size_t, size_t> shape() const { return Printer::compute_shape(*this); }
 
   Format &format() { return format_; }
 
-  void print(std::ostream &stream) { Printer::print_table(stream, *this); }
+  // Keeps the measurements and the rendered lines of every row between
+  // prints, see Printer::print_cached_table()
+  void cache_rows(bool enabled) {
+    cache_rows_ = enabled;
+    cached_rows_.clear();
+    cached_column_widths_.clear();
+    cached_cells_.clear();
+    if (enabled)
+      cached_rows_.resize(size());
+  }
 
-  size_t estimate_num_columns() const {
-    size_t result{0};
-    if (size()) {
-      auto first_row = operator[](size_t(0));
-      result = first_row.size();
+  // Flattens the table, row, column and cell formats into one immutable record
+  // per distinct combination: cells without a format of their own share the
+  // record of their column, or of their row, or of the table
+  // Column formats take precedence over row formats, so in rows with a format
+  // of their own they are merged once per formatted column
+  // The records are reused by every print until a format is changed, which
+  // every setter of Format counts in format_generation_
+  // Prints of the same table from several threads may resolve concurrently,
+  // the first one does the work while the others wait for it
+  void resolve_formats() const {
+    auto generation = format_generation_.load(std::memory_order_acquire);
+    if (resolved_generation_.load(std::memory_order_acquire) == generation)
+      return;
+    std::lock_guard<std::mutex> lock(resolve_mutex_);
+    if (resolved_generation_.load(std::memory_order_relaxed) == generation)
+      return;
+    resolved_formats_.clear();
+    resolved_formats_.push_back(format_);
+    resolved_styles_.resize(cell_texts_.size());
+    std::vector<uint32_t> column_records(column_styles_.size(), 0);
+    for (size_t column = 0; column < column_styles_.size(); ++column) {
+      if (column_styles_[column] != no_style) {
+        resolved_formats_.push_back(
+            Format::merge(style(column_styles_[column]), resolved_formats_[0]));
+        column_records[column] = static_cast<uint32_t>(resolved_formats_.size() - 1);
+      }
     }
-    return result;
+    for (size_t i = 0; i < size(); ++i) {
+      uint32_t row_record{0};
+      if (row_styles_[i] != no_style) {
+        resolved_formats_.push_back(Format::merge(style(row_styles_[i]), resolved_formats_[0]));
+        row_record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+      }
+      for (size_t cell = row_offsets_[i]; cell < row_offsets_[i + 1]; ++cell) {
+        auto column = cell - row_offsets_[i];
+        uint32_t record{row_record};
+        if (column < column_styles_.size() && column_styles_[column] != no_style) {
+          if (row_record == 0) {
+            record = column_records[column];
+          } else {
+            resolved_formats_.push_back(
+                Format::merge(style(column_styles_[column]), resolved_formats_[row_record]));
+            record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+          }
+        }
+        if (cell_styles_[cell] != no_style) {
+          resolved_formats_.push_back(
+              Format::merge(style(cell_styles_[cell]), resolved_formats_[record]));
+          record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+        }
+        resolved_styles_[cell] = record;
+      }
+    }
+    resolved_generation_.store(generation, std::memory_order_release);
   }
 
+  void invalidate_formats() { format_generation_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Whether a format the cells of the row are printed with, the format of the
+  // table, of the row, of its columns or of its cells, was changed after
+  // generation of format_generation_
+  bool row_formats_changed(size_t row, uint64_t generation) const {
+    if (format_.owner_.last_change() > generation ||
+        style_or_empty(row_styles_[row]).owner_.last_change() > generation)
+      return true;
+    for (size_t cell = row_offsets_[row]; cell < row_offsets_[row + 1]; ++cell) {
+      auto column = cell - row_offsets_[row];
+      if (style_or_empty(cell_styles_[cell]).owner_.last_change() > generation ||
+          (column < column_styles_.size() &&
+           style_or_empty(column_styles_[column]).owner_.last_change() > generation))
+        return true;
+    }
+    return false;
+  }
+
+  void print(std::ostream &stream) const { Printer::print_table(stream, *this); }
+
+  // Appends the rendered table to buffer
+  void print(std::string &buffer) const { Printer::print_table(buffer, *this); }
+
+  size_t estimate_num_columns() const { return size() ? row_size(0) : 0; }
+
 private:
+  friend class Cell;
+  friend class Row;
+  friend class Column;
+  friend class Printer;
   friend class Table;
+  friend class TableStream;
   friend class MarkdownExporter;
+  friend class CsvExporter;
+  friend class TsvExporter;
+  friend class JsonExporter;
+  friend class Viewport;
 
-  TableInternal() {}
+  TableInternal() { format_.owner_.attach(&format_generation_); }
   TableInternal &operator=(const TableInternal &);
   TableInternal(const TableInternal &);
 
-  std::vector<std::shared_ptr<Row>> rows_;
+  // Where the text of a cell is stored in text_
+  struct TextSpan {
+    size_t offset;
+    size_t length;
+  };
+
+  // Text of a cell to be added, referenced without being copied
+  struct TextRef {
+    const char *data;
+    size_t size;
+  };
+
+  static TextRef text_ref(const std::string &text) { return {text.data(), text.size()}; }
+
+  static TextRef text_ref(const char *text) { return {text, std::strlen(text)}; }
+
+  static TextRef text_ref(const TextRef &text) { return text; }
+
+  // Style id of rows and cells without a format of their own
+  enum : uint32_t { no_style = 0 };
+
+  // What the last print measured and rendered of a row, dropped when the row
+  // changes, see Printer::print_cached_table()
+  struct CachedRow {
+    bool measured{false};
+    bool rendered{false};
+    uint64_t generation{0}; // of format_generation_ when the row was measured
+    std::vector<size_t> configured_widths; // widths the row needs, see measure_row()
+    std::vector<size_t> computed_widths;
+    std::string text; // top border and lines of the row, ending in the default style
+  };
+
+  // Copy of the table with rows and cells of its own, nested tables are shared
+  std::shared_ptr<TableInternal> clone() const {
+    auto result = std::shared_ptr<TableInternal>(new TableInternal());
+    result->format_ = format_;
+    result->text_ = text_;
+    result->text_garbage_ = text_garbage_;
+    result->cell_texts_ = cell_texts_;
+    result->cell_styles_ = cell_styles_;
+    result->cell_tables_ = cell_tables_;
+    result->row_offsets_ = row_offsets_;
+    result->row_styles_ = row_styles_;
+    result->column_styles_ = column_styles_;
+    result->styles_ = styles_;
+    for (auto &style : result->styles_)
+      style.owner_.attach(&result->format_generation_);
+    result->free_styles_ = free_styles_;
+    for (size_t i = 0; i < rows_.size(); ++i)
+      result->rows_.emplace_back(*result, i);
+    for (size_t i = 0; i < cells_.size(); ++i)
+      result->cells_.emplace_back(*result, i);
+    return result;
+  }
+
+  // Inserts a row before the row at the given position, with a cell for every
+  // text of cells, std::string, C string or TextRef, then empty cells up to
+  // min_cells
+  template <typename Cells>
+  void insert_row(size_t index, const Cells &cells, size_t min_cells = 0) {
+    auto first = row_offsets_[index];
+    auto end = cell_texts_.size();
+
+    // Spans are appended, then rotated in place before the cells of the row at
+    // index, which leaves them in place when the row is added last
+    for (auto &cell : cells) {
+      auto text = text_ref(cell);
+      cell_texts_.push_back({text_.size(), text.size});
+      text_.append(text.data, text.size);
+    }
+    if (cell_texts_.size() - end < min_cells)
+      cell_texts_.resize(end + min_cells, TextSpan{text_.size(), 0});
+    auto count = cell_texts_.size() - end;
+    std::rotate(cell_texts_.begin() + first, cell_texts_.begin() + end, cell_texts_.end());
+    cell_styles_.insert(cell_styles_.begin() + first, count, no_style);
+    if (!cell_tables_.empty())
+      cell_tables_.insert(cell_tables_.begin() + first, count, nullptr);
+
+    row_offsets_.insert(row_offsets_.begin() + index, first);
+    for (size_t i = index + 1; i < row_offsets_.size(); ++i)
+      row_offsets_[i] += count;
+    row_styles_.insert(row_styles_.begin() + index, no_style);
+    if (cache_rows_)
+      cached_rows_.insert(cached_rows_.begin() + index, CachedRow());
+
+    // Views are positional, there is one for every row and every cell
+    rows_.emplace_back(*this, rows_.size());
+    for (size_t i = 0; i < count; ++i)
+      cells_.emplace_back(*this, cells_.size());
+    invalidate_formats();
+  }
+
+  // Removes the rows in [first, last)
+  void erase_rows(size_t first, size_t last) {
+    if (first >= last)
+      return;
+    auto first_cell = row_offsets_[first], last_cell = row_offsets_[last];
+    auto count = last_cell - first_cell;
+
+    for (auto cell = first_cell; cell < last_cell; ++cell) {
+      text_garbage_ += cell_texts_[cell].length;
+      release_style(cell_styles_[cell]);
+    }
+    cell_texts_.erase(cell_texts_.begin() + first_cell, cell_texts_.begin() + last_cell);
+    cell_styles_.erase(cell_styles_.begin() + first_cell, cell_styles_.begin() + last_cell);
+    if (!cell_tables_.empty())
+      cell_tables_.erase(cell_tables_.begin() + first_cell, cell_tables_.begin() + last_cell);
+
+    for (auto row = first; row < last; ++row)
+      release_style(row_styles_[row]);
+    row_offsets_.erase(row_offsets_.begin() + first, row_offsets_.begin() + last);
+    for (size_t i = first; i < row_offsets_.size(); ++i)
+      row_offsets_[i] -= count;
+    row_styles_.erase(row_styles_.begin() + first, row_styles_.begin() + last);
+    if (cache_rows_)
+      cached_rows_.erase(cached_rows_.begin() + first, cached_rows_.begin() + last);
+
+    rows_.erase(rows_.end() - (last - first), rows_.end());
+    cells_.erase(cells_.end() - count, cells_.end());
+    compact_text();
+    invalidate_formats();
+  }
+
+  size_t row_size(size_t row) const { return row_offsets_[row + 1] - row_offsets_[row]; }
+
+  size_t cell_index(size_t row, size_t column) const { return row_offsets_[row] + column; }
+
+  // Row holding a cell, the last of the rows starting at it if some are empty
+  size_t row_of_cell(size_t cell) const {
+    return static_cast<size_t>(std::upper_bound(row_offsets_.begin(), row_offsets_.end(), cell) -
+                               row_offsets_.begin()) -
+           1;
+  }
+
+  // Whether a table is nested in one of the cells of a row
+  bool row_has_tables(size_t row) const {
+    for (auto cell = row_offsets_[row]; cell < row_offsets_[row + 1]; ++cell) {
+      if (cell_table(cell))
+        return true;
+    }
+    return false;
+  }
+
+  // Drops what the last print kept of a row, or of every row
+  void invalidate_cached_row(size_t row) {
+    if (row < cached_rows_.size())
+      cached_rows_[row] = CachedRow();
+  }
+
+  void invalidate_cached_rows() {
+    for (auto &cached : cached_rows_)
+      cached = CachedRow();
+  }
+
+  std::string cell_text(size_t cell) const {
+    if (auto nested = cell_table(cell)) {
+      std::string text;
+      nested->print(text);
+      return text;
+    }
+    return text_.substr(cell_texts_[cell].offset, cell_texts_[cell].length);
+  }
+
+  // Calls fn(data, size) with the text of a cell, only the text of a nested
+  // table is rendered into a temporary string
+  template <typename Function> void visit_cell_text(size_t cell, Function fn) const {
+    if (auto nested = cell_table(cell)) {
+      std::string text;
+      nested->print(text);
+      fn(text.data(), text.size());
+    } else {
+      fn(text_.data() + cell_texts_[cell].offset, cell_texts_[cell].length);
+    }
+  }
+
+  // Table nested in a cell, nullptr for a cell holding text
+  TableInternal *cell_table(size_t cell) const {
+    return cell < cell_tables_.size() ? cell_tables_[cell].get() : nullptr;
+  }
+
+  // Nests table in an empty cell, it is laid out and rendered along with this
+  // table, so later changes to it show up in the next print
+  void set_cell_table(size_t cell, std::shared_ptr<TableInternal> table) {
+    if (cell_tables_.empty())
+      cell_tables_.resize(cell_texts_.size());
+    cell_tables_[cell] = std::move(table);
+    invalidate_cached_row(row_of_cell(cell));
+  }
+
+  void set_cell_text(size_t cell, const std::string &text) {
+    if (!cell_tables_.empty())
+      cell_tables_[cell].reset();
+    auto &span = cell_texts_[cell];
+    if (text.size() <= span.length) {
+      // Overwrite in place, the tail of the old text is left unused
+      text_.replace(span.offset, text.size(), text);
+      text_garbage_ += span.length - text.size();
+    } else {
+      text_garbage_ += span.length;
+      span.offset = text_.size();
+      text_ += text;
+    }
+    span.length = text.size();
+    compact_text();
+    invalidate_cached_row(row_of_cell(cell));
+  }
+
+  // Drops the unused text of erased cells and replaced texts once it takes
+  // more room than the text in use
+  void compact_text() {
+    if (text_garbage_ <= text_.size() / 2)
+      return;
+    std::string text;
+    text.reserve(text_.size() - text_garbage_);
+    for (auto &span : cell_texts_) {
+      auto offset = text.size();
+      text.append(text_, span.offset, span.length);
+      span.offset = offset;
+    }
+    text_.swap(text);
+    text_garbage_ = 0;
+  }
+
+  // Format of a row or a cell, created on first use
+  Format &style_of(uint32_t &id) {
+    if (id == no_style) {
+      if (!free_styles_.empty()) {
+        id = free_styles_.back();
+        free_styles_.pop_back();
+      } else {
+        styles_.emplace_back();
+        styles_.back().owner_.attach(&format_generation_);
+        id = static_cast<uint32_t>(styles_.size());
+      }
+      invalidate_formats();
+    }
+    return style(id);
+  }
+
+  // Format of a column, created on first use
+  Format &column_style(size_t column) {
+    if (column >= column_styles_.size())
+      column_styles_.resize(column + 1, no_style);
+    return style_of(column_styles_[column]);
+  }
+
+  Format &style(uint32_t id) { return styles_[id - 1]; }
+
+  const Format &style(uint32_t id) const { return styles_[id - 1]; }
+
+  // Format of a row or a cell, without creating it if there is none
+  const Format &style_or_empty(uint32_t id) const {
+    static const Format empty;
+    return id == no_style ? empty : style(id);
+  }
+
+  void release_style(uint32_t id) {
+    if (id == no_style)
+      return;
+    style(id) = Format();
+    free_styles_.push_back(id);
+  }
+
+  // Effective format of the cell, valid after resolve_formats()
+  const Format &resolved_format(size_t row, size_t column) const {
+    return resolved_formats_[resolved_styles_[cell_index(row, column)]];
+  }
+
   Format format_;
+
+  // Cells of every row, stored row after row as parallel arrays
+  std::string text_;                  // text of every cell, back to back
+  size_t text_garbage_{0};            // bytes of text_ no longer used by any cell
+  std::vector<TextSpan> cell_texts_;  // text of each cell in text_
+  std::vector<uint32_t> cell_styles_; // style id of each cell
+  std::vector<std::shared_ptr<TableInternal>> cell_tables_; // empty until a table is nested
+
+  std::vector<size_t> row_offsets_{0}; // first cell of each row, then the number of cells
+  std::vector<uint32_t> row_styles_;   // style id of each row
+
+  // Style id of each column, up to the last formatted one
+  std::vector<uint32_t> column_styles_;
+
+  // Row, column and cell formats, style id i is styles_[i - 1]
+  std::deque<Format> styles_;
+  std::vector<uint32_t> free_styles_; // ids released by erased rows and cells
+
+  // Flattened formats, see resolve_formats()
+  mutable std::vector<Format> resolved_formats_;
+  mutable std::vector<uint32_t> resolved_styles_; // index in resolved_formats_ of each cell
+  // Changes of the formats and of the cells they apply to, counted up by the
+  // setters of the formats of the table and by invalidate_formats()
+  std::atomic<uint64_t> format_generation_{1};
+  mutable std::atomic<uint64_t> resolved_generation_{0}; // of the resolved formats
+  mutable std::mutex resolve_mutex_;
+
+  // Rows kept between prints, one for every row while cache_rows_ is set
+  bool cache_rows_{false};
+  mutable std::vector<CachedRow> cached_rows_;
+  mutable std::vector<size_t> cached_column_widths_; // widths the rows are rendered for
+  mutable bool cached_colorized_{false};
+  mutable std::vector<CellLayout> cached_cells_; // empty, reused by every print
+  mutable std::mutex cache_mutex_;
+
+  // Views returned by operator[] and Row::cell(), i-th view on i-th row or cell
+  std::deque<Row> rows_;
+  std::deque<Cell> cells_;
 };
 
+inline void Cell::set_text(const std::string &text) { table_->set_cell_text(index_, text); }
+
+inline std::string Cell::get_text() const { return table_->cell_text(index_); }
+
 inline Format &Cell::format() {
-  std::shared_ptr<Row> parent = parent_.lock();
-  if (!format_.has_value()) {   // no cell format
-    format_ = parent->format(); // Use parent row format
-  } else {
-    // Cell has formatting
-    // Merge cell formatting with parent row formatting
-    format_ = Format::merge(*format_, parent->format());
-  }
-  return *format_;
+  return table_->style_of(table_->cell_styles_[index_]);
 }
 
-inline bool Cell::is_multi_byte_character_support_enabled() {
-  return (*format().multi_byte_characters_);
+inline const Format &Cell::format() const {
+  return table_->style_or_empty(table_->cell_styles_[index_]);
 }
 
+inline const Format &Cell::resolved_format() const {
+  table_->resolve_formats();
+  return table_->resolved_formats_[table_->resolved_styles_[index_]];
+}
+
+inline bool Cell::is_multi_byte_character_support_enabled() const {
+  return resolved_format().multi_byte_characters_;
+}
+
+inline Cell &Row::cell(size_t index) {
+  return table_->cells_[table_->cell_index(index_, index)];
+}
+
+inline const Cell &Row::cell(size_t index) const {
+  return table_->cells_[table_->cell_index(index_, index)];
+}
+
+inline size_t Row::size() const { return table_->row_size(index_); }
+
 inline Format &Row::format() {
-  std::shared_ptr<TableInternal> parent = parent_.lock();
-  if (!format_.has_value()) {   // no row format
-    format_ = parent->format(); // Use parent table format
-  } else {
-    // Row has formatting rules
-    // Merge with parent table format
-    format_ = Format::merge(*format_, parent->format());
-  }
-  return *format_;
+  return table_->style_of(table_->row_styles_[index_]);
 }
 
-inline std::pair<std::vector<size_t>, std::vector<size_t>>
-Printer::compute_cell_dimensions(TableInternal &table) {
-  std::pair<std::vector<size_t>, std::vector<size_t>> result;
-  size_t num_rows = table.size();
-  size_t num_columns = table.estimate_num_columns();
+inline const Format &Row::format() const {
+  return table_->style_or_empty(table_->row_styles_[index_]);
+}
+
+inline Row::CellIterator Row::begin() {
+  return CellIterator(table_->cells_.begin() + table_->row_offsets_[index_]);
+}
+
+inline Row::CellIterator Row::end() {
+  return CellIterator(table_->cells_.begin() + table_->row_offsets_[index_ + 1]);
+}
 
-  std::vector<size_t> row_heights, column_widths{};
+inline Cell &Column::operator[](size_t index) { return (*table_)[index][index_]; }
 
-  for (size_t i = 0; i < num_columns; ++i) {
-    Column column = table.column(i);
-    size_t configured_width = column.get_configured_width();
-    size_t computed_width = column.get_computed_width();
-    if (configured_width != 0)
-      column_widths.push_back(configured_width);
+inline size_t Column::size() const { return table_->size(); }
+
+inline Format &Column::style() { return table_->column_style(index_); }
+
+inline TableLayout Printer::compute_layout(const TableInternal &table) {
+  return compute_layout(table, {});
+}
+
+inline TableLayout Printer::compute_layout(const TableInternal &table,
+                                           const std::vector<size_t> &column_widths) {
+  TableLayout layout;
+  size_t num_rows = table.size();
+  size_t num_columns = table.estimate_num_columns();
+  table.resolve_formats();
+
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  layout.cells.resize(num_rows * num_columns);
+
+  // Column widths
+  // For each column, the largest configured cell.format.width wins.
+  // If no width is configured, use the widest
+  //   padding_left + cell_contents + padding_right
+  // where cell_contents is the widest line of the cell
+  // Large tables are measured in bands of rows, the widths measured by each
+  // band are then reduced to the widest
+  auto bands = split_rows(num_rows);
+  std::vector<std::vector<size_t>> configured_widths(bands.size()), computed_widths(bands.size());
+  for_each_band(bands.size(), [&](size_t band) {
+    configured_widths[band].resize(num_columns, 0);
+    computed_widths[band].resize(num_columns, 0);
+    for (size_t i = bands[band].first; i < bands[band].last; ++i)
+      measure_row(table, layout, i, configured_widths[band], computed_widths[band]);
+  });
+  for (size_t j = 0; j < num_columns; ++j) {
+    size_t configured_width{0}, computed_width{0};
+    for (size_t band = 0; band < bands.size(); ++band) {
+      configured_width = std::max(configured_width, configured_widths[band][j]);
+      computed_width = std::max(computed_width, computed_widths[band][j]);
+    }
+    if (j < column_widths.size())
+      layout.column_widths[j] = column_widths[j];
     else
-      column_widths.push_back(computed_width);
+      layout.column_widths[j] = configured_width != 0 ? configured_width : computed_width;
   }
 
-  for (size_t i = 0; i < num_rows; ++i) {
-    Row row = table[i];
-    size_t configured_height = row.get_configured_height();
-    size_t computed_height = row.get_computed_height(column_widths);
+  for_each_band(bands.size(), [&](size_t band) {
+    for (size_t i = bands[band].first; i < bands[band].last; ++i)
+      wrap_row(table, layout, i);
+  });
+
+  return layout;
+}
 
-    // NOTE: Unlike column width, row height is calculated as the max
-    // b/w configured height and computed height
-    // which means that .width() has higher precedence than .height()
-    // when both are configured by the user
-    //
-    // TODO: Maybe this can be configured?
-    // If such a configuration is exposed, i.e., prefer height over width
-    // then the logic will be reversed, i.e.,
-    // column_widths.push_back(std::max(configured_width, computed_width))
-    // and
-    // row_height = configured_height if != 0 else computed_height
+inline void Printer::measure_row(const TableInternal &table, TableLayout &layout, size_t row,
+                                 std::vector<size_t> &configured_widths,
+                                 std::vector<size_t> &computed_widths) {
+  for (size_t j = 0; j < layout.num_columns() && j < table.row_size(row); ++j) {
+    const Format &format = table.resolved_format(row, j);
+    CellLayout &cell_layout = layout.cell(row, j);
+    if (auto nested = table.cell_table(table.cell_index(row, j))) {
+      layout_nested_table(cell_layout, *nested);
+    } else {
+      // The layout refers to the text of the cell until it rewrites it
+      const auto &span = table.cell_texts_[table.cell_index(row, j)];
+      cell_layout.view_text(table.text_.data() + span.offset, span.length);
+      cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
+      if ((cell_layout.text_class & text_control) != 0)
+        expand_tabs(cell_layout, format);
+      split_cell_lines(cell_layout, format);
+    }
 
-    row_heights.push_back(std::max(configured_height, computed_height));
+    size_t widest_line{0};
+    for (auto &line : cell_layout.lines)
+      widest_line = std::max(widest_line, line.width);
+
+    if (format.has(Format::Property::width))
+      configured_widths[j] = std::max(configured_widths[j], format.width_);
+    computed_widths[j] = std::max(computed_widths[j], format.padding_left_ + widest_line +
+                                                          format.padding_right_);
   }
+}
 
-  result.first = row_heights;
-  result.second = column_widths;
+inline void Printer::wrap_row(const TableInternal &table, TableLayout &layout, size_t row) {
+  // Row heights
+  // Word wrap each cell once for the width of its column, then
+  //   padding_top + number of lines + padding_bottom
+  // is the computed height of the cell
+  //
+  // NOTE: Unlike column width, row height is calculated as the max
+  // b/w configured height and computed height
+  // which means that .width() has higher precedence than .height()
+  // when both are configured by the user
+  //
+  // TODO: Maybe this can be configured?
+  // If such a configuration is exposed, i.e., prefer height over width
+  // then the logic will be reversed, i.e.,
+  // column_widths.push_back(std::max(configured_width, computed_width))
+  // and
+  // row_height = configured_height if != 0 else computed_height
+  size_t configured_height{0}, computed_height{0};
+  for (size_t j = 0; j < layout.num_columns() && j < table.row_size(row); ++j) {
+    const Format &format = table.resolved_format(row, j);
+    CellLayout &cell_layout = layout.cell(row, j);
+    // A nested table is laid out again if it is wider than the column
+    if (auto nested = table.cell_table(table.cell_index(row, j))) {
+      auto padding = format.padding_left_ + format.padding_right_;
+      auto column_width = layout.column_widths[j];
+      fit_nested_table(cell_layout, *nested, column_width > padding ? column_width - padding : 0);
+    } else {
+      wrap_cell_lines(cell_layout, format, layout.column_widths[j]);
+    }
 
-  return result;
+    if (format.has(Format::Property::height))
+      configured_height = std::max(configured_height, format.height_);
+    computed_height = std::max(computed_height, format.padding_top_ + cell_layout.height() +
+                                                    format.padding_bottom_);
+  }
+  layout.row_heights[row] = std::max(configured_height, computed_height);
 }
 
-inline void Printer::print_table(std::ostream &stream, TableInternal &table) {
+inline TableLayout Printer::compute_dimensions(const TableInternal &table, size_t batch_rows) {
+  TableLayout layout;
   size_t num_rows = table.size();
   size_t num_columns = table.estimate_num_columns();
-  auto dimensions = compute_cell_dimensions(table);
-  auto row_heights = dimensions.first;
-  auto column_widths = dimensions.second;
+  table.resolve_formats();
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  batch_rows = std::max<size_t>(batch_rows, 1);
+
+  // Column widths are measured like compute_layout() does, then the rows are
+  // measured again to be word wrapped for them
+  std::vector<size_t> configured_widths(num_columns, 0), computed_widths(num_columns, 0);
+  for (size_t first = 0; first < num_rows; first += batch_rows) {
+    auto last = std::min(first + batch_rows, num_rows);
+    layout.first_row = first;
+    layout.cells.clear();
+    layout.cells.resize((last - first) * num_columns);
+    for (auto i = first; i < last; ++i)
+      measure_row(table, layout, i, configured_widths, computed_widths);
+  }
+  for (size_t j = 0; j < num_columns; ++j)
+    layout.column_widths[j] = configured_widths[j] != 0 ? configured_widths[j] : computed_widths[j];
+
+  for (size_t first = 0; first < num_rows; first += batch_rows)
+    layout_rows(table, layout, first, std::min(first + batch_rows, num_rows));
+  layout.first_row = 0;
+  layout.cells.clear();
+  return layout;
+}
+
+inline void Printer::layout_rows(const TableInternal &table, TableLayout &layout, size_t first,
+                                 size_t last) {
+  table.resolve_formats();
+  layout.first_row = first;
+  layout.cells.clear();
+  layout.cells.resize((last - first) * layout.num_columns());
+  std::vector<size_t> configured_widths(layout.num_columns()), computed_widths(layout.num_columns());
+  for (auto i = first; i < last; ++i) {
+    measure_row(table, layout, i, configured_widths, computed_widths);
+    wrap_row(table, layout, i);
+  }
+}
+
+inline std::pair<std::vector<size_t>, std::vector<size_t>>
+Printer::compute_cell_dimensions(const TableInternal &table) {
+  auto layout = compute_layout(table);
+  return {std::move(layout.row_heights), std::move(layout.column_widths)};
+}
+
+inline std::pair<size_t, size_t> Printer::compute_shape(const TableInternal &table) {
+  // An empty last line is printed, after a '\n', unless it is the only one
+  auto widths = compute_line_widths(table, compute_layout(table));
+  if (widths.empty() || (widths.size() == 1 && widths[0] == 0))
+    return {0, 0};
+  return {widths[0], widths.size()};
+}
+
+inline std::vector<size_t> Printer::compute_line_widths(const TableInternal &table,
+                                                        const TableLayout &layout) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  const auto &column_widths = layout.column_widths;
+
+  // Follows print_table() line by line, adding up display widths instead of
+  // printing
+  std::vector<size_t> widths;
+  widths.reserve(num_rows * 2 + 1);
+  size_t line_width{0};
+  auto new_line = [&]() {
+    widths.push_back(line_width);
+    line_width = 0;
+  };
 
-  // For each row,
   for (size_t i = 0; i < num_rows; ++i) {
+    if (i > 0)
+      new_line();
 
-    // Print top border
     bool border_top_printed{true};
     for (size_t j = 0; j < num_columns; ++j) {
-      border_top_printed &= print_cell_border_top(stream, table, {i, j},
-                                                  {row_heights[i], column_widths[j]}, num_columns);
+      border_top_printed &= cell_border_top_width(table.resolved_format(i, j), column_widths[j],
+                                                  j + 1 == num_columns, line_width);
     }
     if (border_top_printed)
-      stream << termcolor::reset << "\n";
+      new_line();
 
-    // Print row contents with word wrapping
-    for (size_t k = 0; k < row_heights[i]; ++k) {
+    auto row_height = layout.row_heights[i];
+    for (size_t k = 0; k < row_height; ++k) {
       for (size_t j = 0; j < num_columns; ++j) {
-        print_row_in_cell(stream, table, {i, j}, {row_heights[i], column_widths[j]}, num_columns,
-                          k);
+        line_width += row_in_cell_width(table.resolved_format(i, j), layout.cell(i, j),
+                                        column_widths[j], j + 1 == num_columns, k);
       }
-      if (k + 1 < row_heights[i])
-        stream << termcolor::reset << "\n";
+      if (k + 1 < row_height)
+        new_line();
+    }
+  }
+
+  if (num_rows > 0) {
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
+        break;
+      }
+    }
+    if (bottom_border_needed)
+      new_line();
+    for (size_t j = 0; j < num_columns; ++j) {
+      cell_border_bottom_width(table.resolved_format(i, j), column_widths[j],
+                               j + 1 == num_columns, line_width);
     }
+  }
 
-    if (i + 1 == num_rows) {
+  if (num_rows > 0)
+    widths.push_back(line_width);
+  return widths;
+}
 
-      // Check if there is bottom border to print:
-      auto bottom_border_needed{true};
-      for (size_t j = 0; j < num_columns; ++j) {
-        auto cell = table[i][j];
-        auto format = cell.format();
-        auto corner = *format.corner_bottom_left_;
-        auto border_bottom = *format.border_bottom_;
-        if (corner == "" && border_bottom == "") {
-          bottom_border_needed = false;
-          break;
-        }
+inline std::vector<size_t> Printer::compute_line_offsets(const TableInternal &table,
+                                                        const TableLayout &layout) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  std::vector<size_t> offsets;
+  offsets.reserve(num_rows + 1);
+
+  // Rows are separated by a newline, a row prints one more newline after its
+  // top border and between each of its lines
+  size_t line{0};
+  for (size_t i = 0; i < num_rows; ++i) {
+    offsets.push_back(line);
+    size_t width{0};
+    bool border_top_printed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      border_top_printed &= cell_border_top_width(table.resolved_format(i, j),
+                                                  layout.column_widths[j],
+                                                  j + 1 == num_columns, width);
+    }
+    auto row_height = layout.row_heights[i];
+    line += 1 + (border_top_printed ? 1 : 0) + (row_height > 0 ? row_height - 1 : 0);
+  }
+
+  if (num_rows > 0) {
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
+        break;
       }
+    }
+    if (bottom_border_needed)
+      ++line;
+  }
+  offsets.push_back(line);
+  return offsets;
+}
 
-      if (bottom_border_needed)
-        stream << termcolor::reset << "\n";
-      // Print bottom border for table
-      for (size_t j = 0; j < num_columns; ++j) {
-        print_cell_border_bottom(stream, table, {i, j}, {row_heights[i], column_widths[j]},
-                                 num_columns);
+inline void Printer::layout_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                         const std::vector<size_t> &column_widths) {
+  if (!cell_layout.nested)
+    cell_layout.nested.reset(new NestedLayout());
+  auto &nested = *cell_layout.nested;
+  nested.layout = compute_layout(table, column_widths);
+  nested.line_offsets = compute_line_offsets(table, nested.layout);
+  auto widths = compute_line_widths(table, nested.layout);
+  // An empty last line, e.g., below a hidden bottom border, takes no room
+  if (!widths.empty() && widths.back() == 0)
+    widths.pop_back();
+  cell_layout.lines.clear();
+  cell_layout.lines.reserve(widths.size());
+  for (auto width : widths)
+    cell_layout.lines.push_back({0, 0, width});
+}
+
+inline void Printer::fit_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                      size_t width) {
+  size_t widest_line{0};
+  for (auto &line : cell_layout.lines)
+    widest_line = std::max(widest_line, line.width);
+  if (widest_line <= width)
+    return;
+
+  // The widest column loses one character at a time, down to its padding
+  // and one character of text, then the cells are word wrapped for the
+  // narrower columns
+  // A nested table still too wide overflows the cell, like natural lines do
+  auto column_widths = cell_layout.nested->layout.column_widths;
+  std::vector<size_t> min_widths(column_widths.size(), 1);
+  for (size_t i = 0; i < table.size(); ++i) {
+    for (size_t j = 0; j < min_widths.size() && j < table.row_size(i); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      min_widths[j] =
+          std::max(min_widths[j], format.padding_left_ + format.padding_right_ + 1);
+    }
+  }
+  for (auto excess = widest_line - width; excess > 0; --excess) {
+    size_t widest = column_widths.size();
+    for (size_t j = 0; j < column_widths.size(); ++j) {
+      if (column_widths[j] > min_widths[j] &&
+          (widest == column_widths.size() || column_widths[j] > column_widths[widest]))
+        widest = j;
+    }
+    if (widest == column_widths.size())
+      break;
+    --column_widths[widest];
+  }
+  layout_nested_table(cell_layout, table, column_widths);
+}
+
+inline void Printer::expand_tabs(CellLayout &cell_layout, const Format &format) {
+  const char *text = cell_layout.text();
+  auto size = cell_layout.text_size();
+  if (std::memchr(text, '\t', size) == nullptr)
+    return;
+
+  std::string result;
+  result.reserve(size + 8);
+  size_t column{0};  // of the line, up to segment
+  size_t segment{0}; // start of the text of result not measured yet
+  for (size_t i = 0; i < size; ++i) {
+    auto c = text[i];
+    if (c == '\t') {
+      column += get_sequence_length(result.data() + segment, result.size() - segment,
+                                    format.multi_byte_characters_);
+      auto spaces = 8 - column % 8;
+      result.append(spaces, ' ');
+      column += spaces;
+      segment = result.size();
+    } else {
+      result += c;
+      if (c == '\n') {
+        column = 0;
+        segment = result.size();
       }
     }
-    if (i + 1 < num_rows)
-      stream << termcolor::reset << "\n"; // Don't add newline after last row
   }
+  cell_layout.set_text(std::move(result));
+  cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
 }
 
-inline void Printer::print_row_in_cell(std::ostream &stream, TableInternal &table,
-                                       const std::pair<size_t, size_t> &index,
-                                       const std::pair<size_t, size_t> &dimension,
-                                       size_t num_columns, size_t row_index) {
-  auto column_width = dimension.second;
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  auto is_multi_byte_character_support_enabled = cell.is_multi_byte_character_support_enabled();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
-  auto text = cell.get_text();
-  auto word_wrapped_text =
-      Format::word_wrap(text, column_width, locale, is_multi_byte_character_support_enabled);
-  auto text_height = std::count(word_wrapped_text.begin(), word_wrapped_text.end(), '\n') + 1;
-  auto padding_top = *format.padding_top_;
-
-  if (*format.show_border_left_) {
-    apply_element_style(stream, *format.border_left_color_, *format.border_left_background_color_,
-                        {});
-    stream << *format.border_left_;
-    reset_element_style(stream);
-  }
-
-  apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-  if (row_index < padding_top) {
-    // Padding top
-    stream << std::string(column_width, ' ');
-  } else if (row_index >= padding_top && (row_index <= (padding_top + text_height))) {
-    // // Row contents
-
-    // Retrieve padding left and right
+inline void Printer::split_cell_lines(CellLayout &cell_layout, const Format &format) {
+  const char *text = cell_layout.text();
+  auto size = cell_layout.text_size();
+  cell_layout.lines.clear();
+
+  if ((cell_layout.text_class & text_newline) == 0) {
+    // A single line, which is as wide as it is long if it is printable ASCII
+    auto width = is_printable_ascii(cell_layout.text_class)
+                     ? size
+                     : get_sequence_length(text, size, format.multi_byte_characters_);
+    if (width > 0)
+      cell_layout.lines.push_back({0, size, width});
+    return;
+  }
+
+  size_t start{0};
+  while (true) {
+    auto newline = static_cast<const char *>(std::memchr(text + start, '\n', size - start));
+    auto end = newline != nullptr ? static_cast<size_t>(newline - text) : std::string::npos;
+    auto length = (end == std::string::npos ? size : end) - start;
+    auto width = get_sequence_length(text + start, length, format.multi_byte_characters_);
+    if (end == std::string::npos) {
+      if (width > 0)
+        cell_layout.lines.push_back({start, length, width});
+      break;
+    }
+    cell_layout.lines.push_back({start, length, width});
+    start = end + 1;
+  }
+}
+
+inline void Printer::wrap_cell_lines(CellLayout &cell_layout, const Format &format,
+                                     size_t column_width) {
+  auto padding_left = format.padding_left_;
+  auto padding_right = format.padding_right_;
+
+  // A column no wider than its padding leaves no room for text, the cell
+  // keeps a single empty line so that its row is still printed
+  if (format.overflow_ == Overflow::truncate) {
+    if (column_width <= padding_left + padding_right) {
+      cell_layout.lines.assign(1, LineSpan{0, 0, 0});
+      return;
+    }
+    if (!cell_layout.lines.empty())
+      truncate_cell_lines(cell_layout, format, column_width - padding_left - padding_right);
+  } else if ((cell_layout.text_class & text_newline) != 0) {
+    // There are embedded '\n' characters
+    // Respect these characters, the natural lines are printed as they are
+  } else if (column_width <= (padding_left + padding_right)) {
+    // Configured column width cannot be lower than (padding_left + padding_right)
+    // This is a bad configuration
+    // E.g., the user is trying to force the column width to be 5
+    // when padding_left and padding_right are each configured to 3
+    // (padding_left + padding_right) = 6 > column_width
+    cell_layout.lines.assign(1, LineSpan{0, 0, 0});
+    return;
+  } else if (cell_layout.lines.empty() ||
+             cell_layout.lines[0].width <= column_width - padding_left - padding_right) {
+    // Fits in the column, word wrapping would not change anything
+  } else {
+    // Apply word wrapping to input text
     // (column_width - padding_left - padding_right) is the amount of space
-    // available for cell text - Use this to word wrap cell contents
-    auto padding_left = *format.padding_left_;
-    auto padding_right = *format.padding_right_;
-
-    // Check if input text has embedded \n that are to be respected
-    auto newlines_in_input = Format::split_lines(text, "\n", cell.locale(),
-                                                 cell.is_multi_byte_character_support_enabled())
-                                 .size() -
-                             1;
-    std::string word_wrapped_text;
-
-    // If there are no embedded \n characters, then apply word wrap
-    if (newlines_in_input == 0) {
-      // Apply word wrapping to input text
-      // Then display one word-wrapped line at a time within cell
-      if (column_width > (padding_left + padding_right))
-        word_wrapped_text =
-            Format::word_wrap(text, column_width - padding_left - padding_right, cell.locale(),
-                              cell.is_multi_byte_character_support_enabled());
-      else {
-        // Configured column width cannot be lower than (padding_left + padding_right)
-        // This is a bad configuration
-        // E.g., the user is trying to force the column width to be 5
-        // when padding_left and padding_right are each configured to 3
-        // (padding_left + padding_right) = 6 > column_width
-      }
-    } else {
-      word_wrapped_text = text; // repect the embedded '\n' characters
+    // available for cell text
+    std::string text;
+    std::vector<LineSpan> lines;
+    Format::word_wrap(cell_layout.text(), cell_layout.text_size(),
+                      column_width - padding_left - padding_right,
+                      format.multi_byte_characters_, text, lines);
+    cell_layout.set_text(std::move(text));
+    cell_layout.lines.swap(lines);
+    cell_layout.text_class |= text_newline | text_dash;
+  }
+
+  // Only spaces and control characters, e.g., '\t', are trimmed
+  if ((cell_layout.text_class & (text_space | text_control)) == 0)
+    return;
+  for (auto &line : cell_layout.lines)
+    line = trim_line(cell_layout.text(), line, format);
+}
+
+inline void Printer::truncate_cell_lines(CellLayout &cell_layout, const Format &format,
+                                         size_t width) {
+  auto line = cell_layout.lines[0];
+  if (cell_layout.lines.size() == 1 && line.width <= width)
+    return;
+
+  // The ellipsis is left out if the column is too narrow for it
+  auto multi_byte = format.multi_byte_characters_;
+  // U+2026 and "..." both take 3 bytes
+  const char *ellipsis = multi_byte ? "\xe2\x80\xa6" : "...";
+  size_t ellipsis_size{3}, ellipsis_width = multi_byte ? 1 : 3;
+  if (ellipsis_width > width)
+    ellipsis_size = ellipsis_width = 0;
+
+  // Cuts between characters, never inside of a UTF-8 sequence, which is as
+  // wide as it is long without multi-byte character support
+  const char *text = cell_layout.text();
+  auto room = width - ellipsis_width;
+  auto end = line.offset + line.length;
+  size_t cut{line.offset}, cut_width{0};
+  while (cut < end) {
+    auto next = cut;
+    char32_t code_point;
+    size_t character_width{1};
+    if (!decode_utf8(text, end, next, code_point))
+      next = cut + 1;
+    else if (!multi_byte)
+      character_width = next - cut;
+    else if (get_code_point_width(code_point) >= 0)
+      character_width = static_cast<size_t>(get_code_point_width(code_point));
+    if (cut_width + character_width > room)
+      break;
+    cut = next;
+    cut_width += character_width;
+  }
+  while (cut > line.offset && text[cut - 1] == ' ') {
+    --cut;
+    --cut_width;
+  }
+
+  std::string result(text, cut);
+  result.append(ellipsis, ellipsis_size);
+  cell_layout.set_text(std::move(result));
+  cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
+  cell_layout.lines.assign(
+      1, LineSpan{line.offset, cell_layout.text_size() - line.offset, cut_width + ellipsis_width});
+}
+
+inline LineSpan Printer::trim_line(const char *text, LineSpan line, const Format &format) {
+  auto is_space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+  auto begin = line.offset, end = line.offset + line.length;
+  while (begin < end && is_space(text[begin]))
+    ++begin;
+  while (end > begin && is_space(text[end - 1]))
+    --end;
+  if (end - begin != line.length)
+    line.width = get_sequence_length(text + begin, end - begin, format.multi_byte_characters_);
+  line.offset = begin;
+  line.length = end - begin;
+  return line;
+}
+
+inline void Printer::print_table(std::ostream &stream, const TableInternal &table) {
+  std::string buffer;
+  StyleState style(buffer, stream);
+  print_table(buffer, style, table);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+inline void Printer::print_table(std::string &buffer, const TableInternal &table) {
+  StyleState style(buffer);
+  print_table(buffer, style, table);
+}
+
+inline size_t Printer::estimate_rendered_size(const TableInternal &table, const TableLayout &layout) {
+  size_t result{0}, line_size{1};
+  for (size_t i = 0; i < layout.num_rows(); ++i) {
+    // Text lines and padding are as wide as the column, borders may use
+    // multi-byte glyphs and multi-byte text takes more bytes than columns
+    size_t text_size{0};
+    line_size = 1;
+    for (size_t j = 0; j < layout.num_columns(); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      auto glyph_size = std::max({size_t(1), format.border_top_.str().size(),
+                                  format.border_bottom_.str().size()});
+      line_size += layout.column_widths[j] * glyph_size + format.border_left_.str().size() +
+                   format.border_right_.str().size() + format.corner_top_left_.str().size() +
+                   format.corner_top_right_.str().size();
+      text_size += layout.cell(i, j).text_size();
     }
+    // Top border and text lines of the row
+    result += line_size * (layout.row_heights[i] + 1) + text_size;
+  }
+  // Bottom border of the last row
+  return result + line_size;
+}
 
-    auto lines = Format::split_lines(word_wrapped_text, "\n", cell.locale(),
-                                     cell.is_multi_byte_character_support_enabled());
+inline void Printer::print_table(std::string &buffer, StyleState &style, const TableInternal &table) {
+  if (table.cache_rows_ && style.can_fork()) {
+    print_cached_table(buffer, style, table);
+    return;
+  }
+  size_t num_rows = table.size();
+  auto layout = compute_layout(table);
+  auto estimated_size = estimate_rendered_size(table, layout);
+
+  auto bands = style.can_fork() ? split_rows(num_rows) : std::vector<RowBand>{{0, num_rows}};
+  if (bands.size() == 1) {
+    buffer.reserve(buffer.size() + estimated_size);
+    print_rows(buffer, style, table, layout, 0, num_rows);
+    return;
+  }
+
+  // Large tables are rendered in bands of rows, each into a buffer of its own,
+  // which are then appended in order. A band ends in the default style like
+  // every line does, so the bands render exactly what a single pass would
+  std::vector<std::string> band_buffers(bands.size());
+  for_each_band(bands.size(), [&](size_t band) {
+    auto &band_buffer = band_buffers[band];
+    band_buffer.reserve(estimated_size / num_rows * (bands[band].last - bands[band].first + 1));
+    StyleState band_style(band_buffer, style);
+    print_rows(band_buffer, band_style, table, layout, bands[band].first, bands[band].last);
+  });
+
+  auto size = buffer.size();
+  for (auto &band_buffer : band_buffers)
+    size += band_buffer.size();
+  buffer.reserve(size);
+  for (auto &band_buffer : band_buffers)
+    buffer += band_buffer;
+}
 
-    if (row_index - padding_top < lines.size()) {
-      auto line = lines[row_index - padding_top];
+inline void Printer::print_cached_table(std::string &buffer, StyleState &style,
+                                        const TableInternal &table) {
+  std::lock_guard<std::mutex> lock(table.cache_mutex_);
+  size_t num_rows = table.size();
+  size_t num_columns = table.estimate_num_columns();
+  if (num_rows == 0)
+    return;
+  table.resolve_formats();
+  auto &cached_rows = table.cached_rows_;
+
+  // The cell layouts are kept empty between prints, only the rows laid out
+  // by this print are emptied again afterwards
+  TableLayout layout;
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  layout.cells.swap(table.cached_cells_);
+  layout.cells.resize(num_rows * num_columns);
+
+  // Only the rows changed since the last print are measured, rows with a
+  // nested table every time as the nested table may have changed
+  auto bands = split_rows(num_rows);
+  std::vector<char> measured(num_rows, 0), laid_out(num_rows, 0);
+  for_each_band(bands.size(), [&](size_t band) {
+    for (size_t i = bands[band].first; i < bands[band].last; ++i) {
+      auto &cached = cached_rows[i];
+      if (cached.measured && cached.configured_widths.size() == num_columns &&
+          !table.row_formats_changed(i, cached.generation))
+        continue;
+      cached.generation = table.format_generation_.load(std::memory_order_relaxed);
+      cached.configured_widths.assign(num_columns, 0);
+      cached.computed_widths.assign(num_columns, 0);
+      measure_row(table, layout, i, cached.configured_widths, cached.computed_widths);
+      cached.measured = !table.row_has_tables(i);
+      cached.rendered = false;
+      measured[i] = 1;
+    }
+  });
+  for (size_t j = 0; j < num_columns; ++j) {
+    size_t configured_width{0}, computed_width{0};
+    for (auto &cached : cached_rows) {
+      configured_width = std::max(configured_width, cached.configured_widths[j]);
+      computed_width = std::max(computed_width, cached.computed_widths[j]);
+    }
+    layout.column_widths[j] = configured_width != 0 ? configured_width : computed_width;
+  }
 
-      // Print left padding characters
-      stream << std::string(padding_left, ' ');
+  // Rows are rendered for the widths of the columns and for colors or not
+  if (layout.column_widths != table.cached_column_widths_ ||
+      style.colorized() != table.cached_colorized_) {
+    for (auto &cached : cached_rows)
+      cached.rendered = false;
+    table.cached_column_widths_ = layout.column_widths;
+    table.cached_colorized_ = style.colorized();
+  }
 
-      // Print word-wrapped line
-      line = Format::trim(line);
-      auto line_with_padding_size =
-          get_sequence_length(line, cell.locale(), cell.is_multi_byte_character_support_enabled()) +
-          padding_left + padding_right;
-      switch (*format.font_align_) {
-      case FontAlign::left:
-        print_content_left_aligned(stream, line, format, line_with_padding_size, column_width);
-        break;
-      case FontAlign::center:
-        print_content_center_aligned(stream, line, format, line_with_padding_size, column_width);
-        break;
-      case FontAlign::right:
-        print_content_right_aligned(stream, line, format, line_with_padding_size, column_width);
+  // Every row but the last is rendered on its own, from and back to the
+  // default style, the last row is followed by the bottom border so it is
+  // always printed along with it
+  auto prepare_row = [&](size_t i) {
+    if (!measured[i]) {
+      std::vector<size_t> configured(num_columns, 0), computed(num_columns, 0);
+      measure_row(table, layout, i, configured, computed);
+    }
+    wrap_row(table, layout, i);
+    laid_out[i] = 1;
+  };
+  for_each_band(bands.size(), [&](size_t band) {
+    BorderLines borders;
+    for (size_t i = bands[band].first; i < bands[band].last && i + 1 < num_rows; ++i) {
+      auto &cached = cached_rows[i];
+      if (cached.rendered)
+        continue;
+      prepare_row(i);
+      cached.text.clear();
+      StyleState row_style(cached.text, style);
+      print_row(cached.text, row_style, table, layout, i, &borders);
+      row_style.reset();
+      cached.rendered = cached.measured;
+    }
+  });
+  prepare_row(num_rows - 1);
+
+  // The last row and the bottom border take about as much as two other rows
+  auto start = buffer.size(), size = start;
+  for (size_t i = 0; i + 1 < num_rows; ++i)
+    size += cached_rows[i].text.size() + 1;
+  buffer.reserve(size + (size - start) / num_rows * 2);
+  for (size_t i = 0; i + 1 < num_rows; ++i) {
+    if (i > 0)
+      buffer += "\n";
+    buffer += cached_rows[i].text;
+  }
+  print_rows(buffer, style, table, layout, num_rows - 1, num_rows);
+
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (!measured[i] && !laid_out[i])
+      continue;
+    for (size_t j = 0; j < num_columns; ++j)
+      layout.cell(i, j) = CellLayout();
+  }
+  layout.cells.swap(table.cached_cells_);
+}
+
+inline void Printer::print_rows(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const TableLayout &layout, size_t first, size_t last) {
+  size_t num_rows = table.size();
+
+  // For each row,
+  // Rows are separated by newlines, there is none after the last row
+  BorderLines borders;
+  for (size_t i = first; i < last; ++i) {
+    if (i > 0) {
+      style.reset();
+      buffer += "\n";
+    }
+    print_row(buffer, style, table, layout, i, &borders);
+  }
+
+  if (last == num_rows && num_rows > 0) {
+    // Check if there is bottom border to print:
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < layout.num_columns(); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
         break;
       }
+    }
 
-      // Print right padding characters
-      stream << std::string(padding_right, ' ');
-    } else
-      stream << std::string(column_width, ' ');
+    if (bottom_border_needed) {
+      style.reset();
+      buffer += "\n";
+    }
+    // Print bottom border for table
+    print_bottom_border(buffer, style, table, layout.column_widths, i);
+  }
+  style.reset();
+}
 
+inline void Printer::print_row(std::string &buffer, StyleState &style, const TableInternal &table,
+                               const TableLayout &layout, size_t row, BorderLines *borders) {
+  size_t num_columns = layout.num_columns();
+  const auto &column_widths = layout.column_widths;
+  auto row_height = layout.row_heights[row];
+
+  // Print top border, or copy the one of an earlier row with the same formats
+  const uint32_t *formats = table.resolved_styles_.data() + table.cell_index(row, 0);
+  const std::string *border_line{nullptr};
+  if (borders != nullptr) {
+    for (auto &line : borders->lines_) {
+      if (std::equal(line.formats.begin(), line.formats.end(), formats)) {
+        border_line = &line.text;
+        break;
+      }
+    }
+  }
+  if (border_line != nullptr) {
+    buffer += *border_line;
   } else {
-    // Padding bottom
-    stream << std::string(column_width, ' ');
+    auto start = buffer.size();
+    bool border_top_printed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      border_top_printed &= print_cell_border_top(buffer, style, table, {row, j},
+                                                  {row_height, column_widths[j]}, num_columns);
+    }
+    if (border_top_printed) {
+      style.reset();
+      buffer += "\n";
+      // A whole line starts and ends in the default style, it can be copied
+      if (borders != nullptr && borders->lines_.size() < BorderLines::max_lines)
+        borders->lines_.push_back({std::vector<uint32_t>(formats, formats + num_columns),
+                                   buffer.substr(start)});
+    }
+  }
+
+  // Print row contents with word wrapping
+  for (size_t k = 0; k < row_height; ++k) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_row_in_cell(buffer, style, table, layout.cell(row, j), {row, j},
+                        {row_height, column_widths[j]}, num_columns, k);
+    }
+    if (k + 1 < row_height) {
+      style.reset();
+      buffer += "\n";
+    }
   }
+}
 
-  reset_element_style(stream);
+inline void Printer::print_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const TableLayout &layout, const std::vector<size_t> &line_offsets,
+                                size_t line) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  if (num_rows == 0)
+    return;
+
+  // Every row spans at least one line, the line is in the last row starting
+  // at or before it
+  auto row = static_cast<size_t>(std::upper_bound(line_offsets.begin(), line_offsets.end() - 1,
+                                                  line) -
+                                 line_offsets.begin()) -
+             1;
+  auto row_height = layout.row_heights[row];
+  auto row_lines = std::max(row_height, size_t(1));
+  auto k = line - line_offsets[row];
+
+  // Lines of the row as print_rows() prints them: the top border, on a line
+  // of its own if every cell has one, then the lines of the cells
+  bool border_top_printed{true};
+  for (size_t j = 0; j < num_columns; ++j) {
+    const Format &format = table.resolved_format(row, j);
+    border_top_printed &= format.show_border_top_ &&
+                          !(format.corner_top_left_.empty() && format.border_top_.empty());
+  }
+  if (k == 0) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_cell_border_top(buffer, style, table, {row, j},
+                            {row_height, layout.column_widths[j]}, num_columns);
+    }
+    if (border_top_printed) {
+      style.reset();
+      return;
+    }
+  } else if (border_top_printed) {
+    --k;
+  }
+
+  if (k < row_height) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_row_in_cell(buffer, style, table, layout.cell(row, j), {row, j},
+                        {row_height, layout.column_widths[j]}, num_columns, k);
+    }
+  }
+
+  // Then the bottom border of the table, on a line of its own if it was
+  // counted for it, or after the last line of the last row
+  if (row + 1 == num_rows) {
+    auto bottom_line = line_offsets[row + 1] - line_offsets[row] >
+                       row_lines + (border_top_printed ? 1 : 0);
+    if (k == (bottom_line ? row_lines : row_lines - 1))
+      print_bottom_border(buffer, style, table, layout.column_widths, row);
+  }
+  style.reset();
+}
+
+inline void Printer::print_bottom_border(std::string &buffer, StyleState &style,
+                                         const TableInternal &table,
+                                         const std::vector<size_t> &column_widths, size_t row) {
+  size_t num_columns = column_widths.size();
+  for (size_t j = 0; j < num_columns; ++j)
+    print_cell_border_bottom(buffer, style, table, {row, j}, {0, column_widths[j]}, num_columns);
+}
+
+inline void Printer::print_row_in_cell(std::string &buffer, StyleState &style,
+                                       const TableInternal &table, const CellLayout &cell_layout,
+                                       const std::pair<size_t, size_t> &index,
+                                       const std::pair<size_t, size_t> &dimension,
+                                       size_t num_columns, size_t row_index) {
+  auto column_width = dimension.second;
+  const Format &format = table.resolved_format(index.first, index.second);
+  auto padding_top = format.padding_top_;
+
+  if (format.show_border_left_) {
+    style.apply(format.border_left_color_, format.border_left_background_color_, 0);
+    buffer += format.border_left_.str();
+  }
+
+  style.apply(format.font_color_, format.font_background_color_, 0);
+  if (cell_layout.nested && row_index >= padding_top &&
+      row_index - padding_top < cell_layout.height()) {
+    auto nested = table.cell_table(table.cell_index(index.first, index.second));
+    print_nested_line(buffer, style, *nested, cell_layout, format, column_width,
+                      row_index - padding_top);
+  } else if (row_index >= padding_top && row_index - padding_top < cell_layout.height()) {
+    // Row contents, one word-wrapped line at a time
+    const auto &line = cell_layout.lines[row_index - padding_top];
+    auto padding_left = format.padding_left_;
+    auto padding_right = format.padding_right_;
+
+    // Print left padding characters
+    buffer.append(padding_left, ' ');
+
+    // Print word-wrapped line
+    auto line_with_padding_size = line.width + padding_left + padding_right;
+    switch (format.font_align_) {
+    case FontAlign::left:
+      print_content_left_aligned(buffer, style, cell_layout.text(), line, format,
+                                 line_with_padding_size, column_width);
+      break;
+    case FontAlign::center:
+      print_content_center_aligned(buffer, style, cell_layout.text(), line, format,
+                                   line_with_padding_size, column_width);
+      break;
+    case FontAlign::right:
+      print_content_right_aligned(buffer, style, cell_layout.text(), line, format,
+                                  line_with_padding_size, column_width);
+      break;
+    }
+
+    // Print right padding characters
+    buffer.append(padding_right, ' ');
+  } else {
+    // Padding top, padding bottom or below the last line of a shorter cell
+    buffer.append(column_width, ' ');
+  }
 
   if (index.second + 1 == num_columns) {
     // Print right border after last column
-    if (*format.show_border_right_) {
-      apply_element_style(stream, *format.border_right_color_,
-                          *format.border_right_background_color_, {});
-      stream << *format.border_right_;
-      reset_element_style(stream);
+    if (format.show_border_right_) {
+      style.apply(format.border_right_color_, format.border_right_background_color_, 0);
+      buffer += format.border_right_.str();
     }
   }
 }
 
-inline bool Printer::print_cell_border_top(std::ostream &stream, TableInternal &table,
+inline void Printer::print_nested_line(std::string &buffer, StyleState &style,
+                                       const TableInternal &table, const CellLayout &cell_layout,
+                                       const Format &format, size_t column_width, size_t line) {
+  auto line_with_padding_size =
+      cell_layout.lines[line].width + format.padding_left_ + format.padding_right_;
+  auto num_spaces =
+      line_with_padding_size < column_width ? column_width - line_with_padding_size : 0;
+  size_t num_spaces_before{0};
+  if (format.font_align_ == FontAlign::center)
+    num_spaces_before = num_spaces / 2 + num_spaces % 2;
+  else if (format.font_align_ == FontAlign::right)
+    num_spaces_before = num_spaces;
+
+  buffer.append(format.padding_left_ + num_spaces_before, ' ');
+  // Like text, the nested table has no colors of its own and takes the font
+  // style of the cell
+  style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+  StyleState nested_style(buffer);
+  auto &nested = *cell_layout.nested;
+  print_line(buffer, nested_style, table, nested.layout, nested.line_offsets, line);
+  style.apply(format.font_color_, format.font_background_color_, 0);
+  buffer.append(num_spaces - num_spaces_before + format.padding_right_, ' ');
+}
+
+inline bool Printer::print_cell_border_top(std::string &buffer, StyleState &style,
+                                           const TableInternal &table,
                                            const std::pair<size_t, size_t> &index,
                                            const std::pair<size_t, size_t> &dimension,
                                            size_t num_columns) {
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
+  const Format &format = table.resolved_format(index.first, index.second);
   auto column_width = dimension.second;
 
-  auto corner = *format.corner_top_left_;
-  auto corner_color = *format.corner_top_left_color_;
-  auto corner_background_color = *format.corner_top_left_background_color_;
-  auto border_top = *format.border_top_;
+  auto corner = format.corner_top_left_;
+  auto corner_color = format.corner_top_left_color_;
+  auto corner_background_color = format.corner_top_left_background_color_;
+  auto border_top = format.border_top_;
 
-  if ((corner == "" && border_top == "") || !*format.show_border_top_)
+  if ((corner.empty() && border_top.empty()) || !format.show_border_top_)
     return false;
 
-  apply_element_style(stream, corner_color, corner_background_color, {});
-  stream << corner;
-  reset_element_style(stream);
+  style.apply(corner_color, corner_background_color, 0);
+  buffer += corner.str();
 
-  for (size_t i = 0; i < column_width; ++i) {
-    apply_element_style(stream, *format.border_top_color_, *format.border_top_background_color_,
-                        {});
-    stream << border_top;
-    reset_element_style(stream);
-  }
+  style.apply(format.border_top_color_, format.border_top_background_color_, 0);
+  append_repeated(buffer, border_top.str(), column_width);
 
   if (index.second + 1 == num_columns) {
     // Print corner after last column
-    corner = *format.corner_top_right_;
-    corner_color = *format.corner_top_right_color_;
-    corner_background_color = *format.corner_top_right_background_color_;
+    corner = format.corner_top_right_;
+    corner_color = format.corner_top_right_color_;
+    corner_background_color = format.corner_top_right_background_color_;
 
-    apply_element_style(stream, corner_color, corner_background_color, {});
-    stream << corner;
-    reset_element_style(stream);
+    style.apply(corner_color, corner_background_color, 0);
+    buffer += corner.str();
   }
   return true;
 }
 
-inline bool Printer::print_cell_border_bottom(std::ostream &stream, TableInternal &table,
+inline bool Printer::print_cell_border_bottom(std::string &buffer, StyleState &style,
+                                              const TableInternal &table,
                                               const std::pair<size_t, size_t> &index,
                                               const std::pair<size_t, size_t> &dimension,
                                               size_t num_columns) {
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
+  const Format &format = table.resolved_format(index.first, index.second);
   auto column_width = dimension.second;
 
-  auto corner = *format.corner_bottom_left_;
-  auto corner_color = *format.corner_bottom_left_color_;
-  auto corner_background_color = *format.corner_bottom_left_background_color_;
-  auto border_bottom = *format.border_bottom_;
+  auto corner = format.corner_bottom_left_;
+  auto corner_color = format.corner_bottom_left_color_;
+  auto corner_background_color = format.corner_bottom_left_background_color_;
+  auto border_bottom = format.border_bottom_;
 
-  if ((corner == "" && border_bottom == "") || !*format.show_border_bottom_)
+  if ((corner.empty() && border_bottom.empty()) || !format.show_border_bottom_)
     return false;
 
-  apply_element_style(stream, corner_color, corner_background_color, {});
-  stream << corner;
-  reset_element_style(stream);
+  style.apply(corner_color, corner_background_color, 0);
+  buffer += corner.str();
 
-  for (size_t i = 0; i < column_width; ++i) {
-    apply_element_style(stream, *format.border_bottom_color_,
-                        *format.border_bottom_background_color_, {});
-    stream << border_bottom;
-    reset_element_style(stream);
-  }
+  style.apply(format.border_bottom_color_, format.border_bottom_background_color_, 0);
+  append_repeated(buffer, border_bottom.str(), column_width);
 
   if (index.second + 1 == num_columns) {
     // Print corner after last column
-    corner = *format.corner_bottom_right_;
-    corner_color = *format.corner_bottom_right_color_;
-    corner_background_color = *format.corner_bottom_right_background_color_;
+    corner = format.corner_bottom_right_;
+    corner_color = format.corner_bottom_right_color_;
+    corner_background_color = format.corner_bottom_right_background_color_;
+
+    style.apply(corner_color, corner_background_color, 0);
+    buffer += corner.str();
+  }
+  return true;
+}
 
-    apply_element_style(stream, corner_color, corner_background_color, {});
-    stream << corner;
-    reset_element_style(stream);
+inline size_t Printer::row_in_cell_width(const Format &format, const CellLayout &cell_layout,
+                                         size_t column_width, bool last_column,
+                                         size_t row_index) {
+  size_t width{0};
+  if (format.show_border_left_)
+    width += get_sequence_length(format.border_left_.str(), "", true);
+
+  auto padding_top = format.padding_top_;
+  if (row_index >= padding_top && row_index - padding_top < cell_layout.height()) {
+    // The padding is computed from the width measured by the layout, the text
+    // itself is measured the way shape() always did, with multi-byte support
+    const auto &line = cell_layout.lines[row_index - padding_top];
+    auto line_with_padding_size = line.width + format.padding_left_ + format.padding_right_;
+    auto text_width = format.multi_byte_characters_ || cell_layout.nested
+                          ? line.width
+                          : get_sequence_length(cell_layout.text() + line.offset,
+                                                line.length, true);
+    width += format.padding_left_ + text_width + format.padding_right_;
+    if (line_with_padding_size < column_width)
+      width += column_width - line_with_padding_size;
+  } else {
+    width += column_width;
   }
+
+  if (last_column && format.show_border_right_)
+    width += get_sequence_length(format.border_right_.str(), "", true);
+  return width;
+}
+
+inline bool Printer::cell_border_top_width(const Format &format, size_t column_width,
+                                           bool last_column, size_t &width) {
+  if ((format.corner_top_left_.empty() && format.border_top_.empty()) ||
+      !format.show_border_top_)
+    return false;
+  width += get_sequence_length(format.corner_top_left_.str(), "", true) +
+           get_sequence_length(format.border_top_.str(), "", true) * column_width;
+  if (last_column)
+    width += get_sequence_length(format.corner_top_right_.str(), "", true);
+  return true;
+}
+
+inline bool Printer::cell_border_bottom_width(const Format &format, size_t column_width,
+                                              bool last_column, size_t &width) {
+  if ((format.corner_bottom_left_.empty() && format.border_bottom_.empty()) ||
+      !format.show_border_bottom_)
+    return false;
+  width += get_sequence_length(format.corner_bottom_left_.str(), "", true) +
+           get_sequence_length(format.border_bottom_.str(), "", true) * column_width;
+  if (last_column)
+    width += get_sequence_length(format.corner_bottom_right_.str(), "", true);
   return true;
 }
 
@@ -0,0 +1,87 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace tabulate {
+
+// Source of the cells of a table, pulled from it row by row as they are added
+// to a Table or a TableStream, or shown by a Viewport, so that the data behind
+// a table does not have to be copied into strings all at once beforehand
+//
+//   auto model = make_table_model(contacts.size(), 2, [&](size_t row, size_t column) {
+//     return column == 0 ? contacts[row].name : contacts[row].uri;
+//   });
+//   TableStream table(std::cout);
+//   table.add_rows(model);
+class TableModel {
+public:
+  virtual ~TableModel() {}
+
+  virtual size_t num_rows() const = 0;
+
+  virtual size_t num_columns() const = 0;
+
+  // Text of the cell at the given row and column, pulled once when its row
+  // is added, and whenever a Viewport lays out, shows or searches its row
+  virtual std::string cell(size_t row, size_t column) const = 0;
+};
+
+// Table model reading its cells from a function of the row and the column
+template <typename Function> class FunctionTableModel : public TableModel {
+public:
+  FunctionTableModel(size_t num_rows, size_t num_columns, Function cell)
+      : num_rows_(num_rows), num_columns_(num_columns), cell_(std::move(cell)) {}
+
+  size_t num_rows() const override { return num_rows_; }
+
+  size_t num_columns() const override { return num_columns_; }
+
+  std::string cell(size_t row, size_t column) const override { return cell_(row, column); }
+
+private:
+  size_t num_rows_;
+  size_t num_columns_;
+  Function cell_;
+};
+
+template <typename Function>
+FunctionTableModel<Function> make_table_model(size_t num_rows, size_t num_columns,
+                                              Function cell) {
+  return FunctionTableModel<Function>(num_rows, num_columns, std::move(cell));
+}
+
+} // namespace tabulate
@@ -0,0 +1,234 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tabulate/table_internal.hpp>
+#include <tabulate/table_model.hpp>
+#include <utility>
+#include <vector>
+
+namespace tabulate {
+
+// Prints a table row by row, for result sets too large to be held in a Table
+//
+// A Table has to measure all of its rows before the first one is printed.
+// TableStream instead uses declared column widths, or measures the first
+// sample_rows rows, and then prints every row once the next one is added,
+// keeping only the rows not printed yet in memory. Text wider than its column
+// is word wrapped, like in a Table with configured column widths.
+//
+//   TableStream table(std::cout);
+//   table.add_row({"username", "hash"});
+//   for (auto &contact : contacts)
+//     table.add_row({contact.name, contact.uri});
+//   table.close();
+//
+// Unlike Table, every printed line, including the last one, ends with '\n'.
+class TableStream {
+public:
+  explicit TableStream(std::ostream &stream, size_t sample_rows = 100)
+      : stream_(stream), table_(TableInternal::create()), sample_rows_(sample_rows) {}
+
+  TableStream(const TableStream &) = delete;
+  TableStream &operator=(const TableStream &) = delete;
+
+  ~TableStream() { close(); }
+
+  // Format shared by all rows
+  // Changes only apply to the rows that are not printed yet
+  Format &format() { return table_->format(); }
+
+  // Format of a column, shared by the cells of all rows in that column
+  // Like format(), changes only apply to the rows that are not printed yet
+  Column column(size_t index) { return table_->column(index); }
+
+  // Declares the width of the first widths.size() columns, so that rows can be
+  // printed without measuring the first sample_rows rows
+  TableStream &column_widths(std::vector<size_t> widths) {
+    declared_widths_ = std::move(widths);
+    return *this;
+  }
+
+  // Adds a row and prints the previous one
+  // The returned row is printed once the next row is added or the table is
+  // closed, so it can still be formatted, e.g., to style a header row
+  Row &add_row(const std::vector<std::string> &cells) { return append_row(cells); }
+
+  // Same as add_row(), with a cell for every argument, std::string or C
+  // string, without building a vector of cells
+  template <typename... Cells> Row &emplace_row(const Cells &...cells) {
+    using TextRef = TableInternal::TextRef;
+    return append_row(std::initializer_list<TextRef>{TableInternal::text_ref(cells)...});
+  }
+
+  // Adds the rows of a table model, pulling them as the previous ones are
+  // printed, so that no more than sample_rows rows are held at once
+  // Rows are printed sample_rows at a time, even with known column widths
+  TableStream &add_rows(const TableModel &model) {
+    std::vector<std::string> cells(model.num_columns());
+    for (size_t row = 0; row < model.num_rows(); ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model.cell(row, column);
+      append_row(cells, sample_rows_);
+    }
+    return *this;
+  }
+
+  // Same as add_rows(), with every column as wide as in a Table of the rows
+  // not printed yet and of every row of model, so that longer text past the
+  // first sample_rows rows is not word wrapped. The rows of model are pulled
+  // twice, first to be measured sample_rows at a time, then to be printed
+  // Once the column widths are known, e.g., rows were printed, this is
+  // add_rows()
+  TableStream &add_measured_rows(const TableModel &model) {
+    if (column_widths_.empty()) {
+      auto num_columns = std::max(table_->estimate_num_columns(), model.num_columns());
+      std::vector<size_t> configured(num_columns, 0), computed(num_columns, 0);
+      measure_rows(0, configured, computed);
+
+      auto first = table_->size();
+      std::vector<std::string> cells(model.num_columns());
+      for (size_t row = 0; row < model.num_rows();) {
+        auto last = std::min(row + sample_rows_, model.num_rows());
+        for (; row < last; ++row) {
+          for (size_t column = 0; column < cells.size(); ++column)
+            cells[column] = model.cell(row, column);
+          table_->insert_row(table_->size(), cells);
+        }
+        measure_rows(first, configured, computed);
+        table_->erase_rows(first, table_->size());
+      }
+
+      column_widths_.resize(num_columns);
+      for (size_t j = 0; j < num_columns; ++j) {
+        if (j < declared_widths_.size())
+          column_widths_[j] = declared_widths_[j];
+        else
+          column_widths_[j] = configured[j] != 0 ? configured[j] : computed[j];
+      }
+    }
+    return add_rows(model);
+  }
+
+  // Prints the rows not printed yet and the bottom border of the table
+  // Rows added afterwards start a new table
+  void close() {
+    if (table_->size() == 0)
+      return;
+    print_pending_rows();
+
+    StyleState style(buffer_, stream_);
+    Printer::print_bottom_border(buffer_, style, *table_, column_widths_, table_->size() - 1);
+    if (!buffer_.empty()) {
+      style.reset();
+      buffer_ += "\n";
+    }
+    write_buffer();
+
+    table_->erase_rows(0, table_->size());
+    has_printed_row_ = false;
+    column_widths_.clear();
+  }
+
+private:
+  // Once the column widths are known, rows are printed batch_rows at a time
+  template <typename Cells> Row &append_row(const Cells &cells, size_t batch_rows = 1) {
+    if ((widths_known() && pending_rows() >= batch_rows) || pending_rows() >= sample_rows_)
+      print_pending_rows();
+    table_->insert_row(table_->size(), cells);
+    return (*table_)[table_->size() - 1];
+  }
+
+  size_t pending_rows() const { return table_->size() - (has_printed_row_ ? 1 : 0); }
+
+  // Raises configured and computed to the widths the rows of the table from
+  // first on are given and need, see Printer::measure_row()
+  void measure_rows(size_t first, std::vector<size_t> &configured,
+                    std::vector<size_t> &computed) const {
+    TableLayout layout;
+    layout.column_widths.resize(configured.size());
+    layout.row_heights.resize(table_->size());
+    layout.cells.resize(table_->size() * configured.size());
+    table_->resolve_formats();
+    for (auto row = first; row < table_->size(); ++row)
+      Printer::measure_row(*table_, layout, row, configured, computed);
+  }
+
+  bool widths_known() const {
+    return !column_widths_.empty() ||
+           (table_->size() > 0 && declared_widths_.size() >= table_->estimate_num_columns());
+  }
+
+  // Prints every row not printed yet, then drops all the rows but the last one,
+  // which is kept for the bottom border of the table
+  void print_pending_rows() {
+    if (pending_rows() == 0)
+      return;
+
+    // Columns without a declared width are measured on the first rows only
+    auto layout = Printer::compute_layout(
+        *table_, column_widths_.empty() ? declared_widths_ : column_widths_);
+    column_widths_ = layout.column_widths;
+
+    StyleState style(buffer_, stream_);
+    BorderLines borders;
+    for (size_t i = has_printed_row_ ? 1 : 0; i < table_->size(); ++i) {
+      Printer::print_row(buffer_, style, *table_, layout, i, &borders);
+      style.reset();
+      buffer_ += "\n";
+    }
+    write_buffer();
+
+    table_->erase_rows(0, table_->size() - 1);
+    has_printed_row_ = true;
+  }
+
+  void write_buffer() {
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+  std::ostream &stream_;
+  std::shared_ptr<TableInternal> table_;
+  size_t sample_rows_;
+  std::vector<size_t> declared_widths_;
+  std::vector<size_t> column_widths_; // of the table being printed
+  bool has_printed_row_{false};
+  std::string buffer_; // reused by every print
+};
+
+} // namespace tabulate
@@ -50,6 +50,7 @@ static int colorize_index = std::ios_base::xalloc();
 inline FILE *get_standard_stream(const std::ostream &stream);
 inline bool is_colorized(std::ostream &stream);
 inline bool is_atty(const std::ostream &stream);
+inline bool query_atty(FILE *std_stream);
 
 #if defined(TERMCOLOR_OS_WINDOWS)
 inline void win_change_attributes(std::ostream &stream, int foreground, int background = -1);
@@ -363,8 +364,20 @@ inline bool is_colorized(std::ostream &stream) {
   return is_atty(stream) || static_cast<bool>(stream.iword(colorize_index));
 }
 
+//! Test whether a given standard stream refers to a terminal.
+//! This is a system call, see is_atty() for the cached answer.
+inline bool query_atty(FILE *std_stream) {
+#if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
+  return ::isatty(fileno(std_stream));
+#elif defined(TERMCOLOR_OS_WINDOWS)
+  return ::_isatty(_fileno(std_stream));
+#endif
+}
+
 //! Test whether a given `std::ostream` object refers to
 //! a terminal.
+//! The answer is detected once per standard stream, on first use,
+//! and cached afterwards since every manipulator asks for it.
 inline bool is_atty(const std::ostream &stream) {
   FILE *std_stream = get_standard_stream(stream);
 
@@ -375,11 +388,12 @@ inline bool is_atty(const std::ostream &stream) {
   if (!std_stream)
     return false;
 
-#if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-  return ::isatty(fileno(std_stream));
-#elif defined(TERMCOLOR_OS_WINDOWS)
-  return ::_isatty(_fileno(std_stream));
-#endif
+  if (std_stream == stdout) {
+    static const bool stdout_is_atty = query_atty(stdout);
+    return stdout_is_atty;
+  }
+  static const bool stderr_is_atty = query_atty(stderr);
+  return stderr_is_atty;
 }
 
 #if defined(TERMCOLOR_OS_WINDOWS)
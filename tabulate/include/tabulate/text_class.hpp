@@ -0,0 +1,153 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(TABULATE_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TABULATE_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABULATE_SIMD_SSE2
+#endif
+#endif
+
+namespace tabulate {
+
+// Kinds of bytes found in a text by classify_text(), as bit flags
+// Most cell text is plain ASCII without line breaks or spaces, e.g., hashes
+// and ids, which can be measured and wrapped by counting bytes
+enum TextClass : unsigned {
+  text_non_ascii = 1u << 0, // byte of a multi-byte UTF-8 sequence
+  text_control = 1u << 1,   // control character, including '\t' and '\n'
+  text_newline = 1u << 2,   // '\n'
+  text_space = 1u << 3,     // ' '
+  text_dash = 1u << 4,      // '-'
+};
+
+// Printable ASCII text is as wide as it is long
+inline bool is_printable_ascii(unsigned text_class) {
+  return (text_class & (text_non_ascii | text_control)) == 0;
+}
+
+inline unsigned classify_byte(uint8_t byte) {
+  unsigned result{0};
+  if (byte >= 0x80)
+    result |= text_non_ascii;
+  else if (byte < 0x20 || byte == 0x7F)
+    result |= text_control;
+  if (byte == '\n')
+    result |= text_newline;
+  else if (byte == ' ')
+    result |= text_space;
+  else if (byte == '-')
+    result |= text_dash;
+  return result;
+}
+
+// Classifies size bytes of text in a single pass, SIMD registers permitting
+// 32 or 16 bytes at a time
+inline unsigned classify_text(const char *text, size_t size) {
+  unsigned result{0};
+  size_t i{0};
+
+#if defined(TABULATE_SIMD_AVX2)
+  if (size >= 32) {
+    const __m256i space = _mm256_set1_epi8(' '), newline = _mm256_set1_epi8('\n'),
+                  dash = _mm256_set1_epi8('-'), del = _mm256_set1_epi8(0x7F),
+                  minus_one = _mm256_set1_epi8(-1);
+    __m256i any = _mm256_setzero_si256(), controls = any, newlines = any, spaces = any,
+            dashes = any;
+    for (; i + 32 <= size; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+      // Bytes are signed, 0x80 and above are negative
+      any = _mm256_or_si256(any, v);
+      controls = _mm256_or_si256(
+          controls, _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(space, v),
+                                                     _mm256_cmpgt_epi8(v, minus_one)),
+                                    _mm256_cmpeq_epi8(v, del)));
+      newlines = _mm256_or_si256(newlines, _mm256_cmpeq_epi8(v, newline));
+      spaces = _mm256_or_si256(spaces, _mm256_cmpeq_epi8(v, space));
+      dashes = _mm256_or_si256(dashes, _mm256_cmpeq_epi8(v, dash));
+    }
+    if (_mm256_movemask_epi8(any) != 0)
+      result |= text_non_ascii;
+    if (_mm256_movemask_epi8(controls) != 0)
+      result |= text_control;
+    if (_mm256_movemask_epi8(newlines) != 0)
+      result |= text_newline;
+    if (_mm256_movemask_epi8(spaces) != 0)
+      result |= text_space;
+    if (_mm256_movemask_epi8(dashes) != 0)
+      result |= text_dash;
+  }
+#elif defined(TABULATE_SIMD_SSE2)
+  if (size >= 16) {
+    const __m128i space = _mm_set1_epi8(' '), newline = _mm_set1_epi8('\n'),
+                  dash = _mm_set1_epi8('-'), del = _mm_set1_epi8(0x7F),
+                  minus_one = _mm_set1_epi8(-1);
+    __m128i any = _mm_setzero_si128(), controls = any, newlines = any, spaces = any, dashes = any;
+    for (; i + 16 <= size; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+      // Bytes are signed, 0x80 and above are negative
+      any = _mm_or_si128(any, v);
+      controls = _mm_or_si128(
+          controls,
+          _mm_or_si128(_mm_and_si128(_mm_cmplt_epi8(v, space), _mm_cmpgt_epi8(v, minus_one)),
+                       _mm_cmpeq_epi8(v, del)));
+      newlines = _mm_or_si128(newlines, _mm_cmpeq_epi8(v, newline));
+      spaces = _mm_or_si128(spaces, _mm_cmpeq_epi8(v, space));
+      dashes = _mm_or_si128(dashes, _mm_cmpeq_epi8(v, dash));
+    }
+    if (_mm_movemask_epi8(any) != 0)
+      result |= text_non_ascii;
+    if (_mm_movemask_epi8(controls) != 0)
+      result |= text_control;
+    if (_mm_movemask_epi8(newlines) != 0)
+      result |= text_newline;
+    if (_mm_movemask_epi8(spaces) != 0)
+      result |= text_space;
+    if (_mm_movemask_epi8(dashes) != 0)
+      result |= text_dash;
+  }
+#endif
+
+  for (; i < size; ++i)
+    result |= classify_byte(static_cast<uint8_t>(text[i]));
+  return result;
+}
+
+} // namespace tabulate
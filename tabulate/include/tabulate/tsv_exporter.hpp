@@ -0,0 +1,95 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <tabulate/exporter.hpp>
+
+namespace tabulate {
+
+// Tab-separated values, one line per row. Tabs, line breaks and backslashes
+// inside a field are written as \t, \n, \r and \\ so every row stays on a
+// single line.
+class TsvExporter : public Exporter {
+public:
+  std::string dump(Table &table) override {
+    std::string result;
+    write(*table.table_, result, nullptr);
+    return result;
+  }
+
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
+  }
+
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    for (size_t i = 0; i < table.size(); ++i) {
+      for (size_t j = 0; j < table.row_size(i); ++j) {
+        if (j > 0)
+          buffer += '\t';
+        auto cell = table.cell_index(i, j);
+        table.visit_cell_text(cell, [&](const char *data, size_t size) {
+          add_field(buffer, data, size);
+        });
+      }
+      buffer += '\n';
+      flush(buffer, stream, flush_size);
+    }
+  }
+
+  static void add_field(std::string &buffer, const char *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      switch (data[i]) {
+      case '\t':
+        buffer += "\\t";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      default:
+        buffer += data[i];
+      }
+    }
+  }
+};
+
+} // namespace tabulate
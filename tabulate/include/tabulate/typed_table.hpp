@@ -0,0 +1,254 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <string>
+#include <tabulate/table.hpp>
+#include <tabulate/table_stream.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tabulate {
+
+// Borders of a TypedTable
+enum class BorderTheme : unsigned char {
+  ascii, // the default borders and corners of tables
+  none   // no borders around the table and between rows, columns are still separated
+};
+
+// Column of a TypedTable holding values of type T, aligned with Align
+// A Width other than 0 fixes the width of the column, padding included, and
+// longer values are truncated with an ellipsis instead of being word wrapped
+// Plain types can be used for left aligned columns
+template <typename T, FontAlign Align = FontAlign::left, size_t Width = 0> struct Field {};
+
+namespace details {
+
+template <typename Column> struct column_traits {
+  using type = Column;
+  static constexpr FontAlign align = FontAlign::left;
+  static constexpr size_t width = 0;
+};
+
+template <typename T, FontAlign Align, size_t Width>
+struct column_traits<Field<T, Align, Width>> {
+  using type = T;
+  static constexpr FontAlign align = Align;
+  static constexpr size_t width = Width;
+};
+
+// Text of a cell, strings are passed on without being copied
+inline const std::string &to_cell(const std::string &value) { return value; }
+
+inline const char *to_cell(const char *value) { return value; }
+
+inline const char *to_cell(bool value) { return value ? "true" : "false"; }
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, std::string>::type
+to_cell(T value) {
+  return std::to_string(value);
+}
+
+// Appends a row of cells to a table or a table stream, returns the new row
+template <typename... Cells>
+inline Row &append_row(Table &table, size_t index, const Cells &...cells) {
+  table.emplace_row(cells...);
+  return table[index];
+}
+
+template <typename... Cells>
+inline Row &append_row(TableStream &table, size_t, const Cells &...cells) {
+  return table.emplace_row(cells...);
+}
+
+inline void reserve(Table &table, size_t rows, size_t columns) { table.reserve(rows, columns); }
+
+// A table stream only holds the rows not printed yet
+inline void reserve(TableStream &, size_t, size_t) {}
+
+} // namespace details
+
+// Number, types and alignment of the columns of a table, and its borders,
+// fixed at compile time
+template <BorderTheme Theme, typename... Columns> struct TableSchema {
+  static constexpr BorderTheme theme = Theme;
+  static constexpr size_t num_columns = sizeof...(Columns);
+  using row_type = std::tuple<typename details::column_traits<Columns>::type...>;
+};
+
+// Table model with a column for each column of Schema, reading its cells from
+// a function of the row and the column
+template <typename Schema, typename Function>
+class TypedTableModel : public FunctionTableModel<Function> {
+public:
+  TypedTableModel(size_t num_rows, Function cell)
+      : FunctionTableModel<Function>(num_rows, Schema::num_columns, std::move(cell)) {}
+};
+
+// Table model for a TypedTable, whose number of columns is the one of Schema
+//
+//   auto model = make_table_model<Schema>(contacts.size(), [&](size_t row, size_t column) {
+//     return column == 0 ? contacts[row].name : contacts[row].uri;
+//   });
+template <typename Schema, typename Function>
+TypedTableModel<Schema, Function> make_table_model(size_t num_rows, Function cell) {
+  return TypedTableModel<Schema, Function>(num_rows, std::move(cell));
+}
+
+// Table, or table stream, following a TableSchema
+//
+//   using Schema = TableSchema<BorderTheme::ascii, std::string, Field<int, FontAlign::right>>;
+//   TypedTable<Schema> table;
+//   table.add_header("name", "age");
+//   table.add_row("alice", 42);
+//   std::cout << table.target();
+//
+// Rows take exactly one value of the type of each column, anything else
+// does not compile. The formats of the theme and the header are built once
+// per schema, so setting up a table only copies them, and aligned or fixed
+// width columns are formatted once as columns, so adding a row does not touch
+// any format.
+template <typename Schema, typename Target = Table> class TypedTable;
+
+template <BorderTheme Theme, typename... Columns, typename Target>
+class TypedTable<TableSchema<Theme, Columns...>, Target> {
+public:
+  using schema = TableSchema<Theme, Columns...>;
+  using row_type = typename schema::row_type;
+
+  // Arguments are forwarded to the target, e.g., the stream of a TableStream
+  template <typename... Args> explicit TypedTable(Args &&...args)
+      : target_(std::forward<Args>(args)...) {
+    target_.format() = Format::merge(theme_format(), target_.format());
+    format_columns(std::index_sequence_for<Columns...>());
+  }
+
+  // Adds a row of headers, underlined and centered
+  // Headers are formatted cell by cell, to take precedence over the alignment
+  // of their column
+  template <typename... Headers> Row &add_header(const Headers &...headers) {
+    static_assert(sizeof...(Headers) == schema::num_columns,
+                  "a header is needed for every column");
+    auto &row = details::append_row(target_, size_++, details::to_cell(headers)...);
+    for (auto &cell : row)
+      cell.format() = header_format();
+    return row;
+  }
+
+  Row &add_row(const typename details::column_traits<Columns>::type &...values) {
+    return details::append_row(target_, size_++, details::to_cell(values)...);
+  }
+
+  Row &add_row(const row_type &values) {
+    return add_row(values, std::index_sequence_for<Columns...>());
+  }
+
+  // Adds the rows of a table model made for the schema, see make_table_model()
+  // Cells of a model are text already, their type is not checked
+  template <typename Function> void add_rows(const TypedTableModel<schema, Function> &model) {
+    target_.add_rows(model);
+    size_ += model.num_rows();
+  }
+
+  // Same as add_rows(), for a TableStream, with the columns measured on every
+  // row of the model, see TableStream::add_measured_rows()
+  template <typename Function>
+  void add_measured_rows(const TypedTableModel<schema, Function> &model) {
+    target_.add_measured_rows(model);
+    size_ += model.num_rows();
+  }
+
+  // Makes room for rows rows, header included
+  void reserve(size_t rows) { details::reserve(target_, rows, schema::num_columns); }
+
+  // Number of rows added, header included
+  size_t size() const { return size_; }
+
+  Target &target() { return target_; }
+
+private:
+  template <size_t... Indices>
+  Row &add_row(const row_type &values, std::index_sequence<Indices...>) {
+    return add_row(std::get<Indices>(values)...);
+  }
+
+  template <size_t... Indices> void format_columns(std::index_sequence<Indices...>) {
+    // Left aligned columns without a width follow the format of the table,
+    // nothing is done for them
+    using expand = int[];
+    (void)expand{0, (format_column<Indices, Columns>(), 0)...};
+  }
+
+  template <size_t Index, typename Column> void format_column() {
+    using traits = details::column_traits<Column>;
+    if (traits::align != FontAlign::left)
+      target_.column(Index).format().font_align(traits::align);
+    if (traits::width != 0)
+      target_.column(Index).format().width(traits::width).overflow(Overflow::truncate);
+  }
+
+  static const Format &theme_format() {
+    static const Format format = [] {
+      Format result;
+      if (Theme == BorderTheme::none)
+        result.corner_top_left("")
+            .corner_top_right("")
+            .corner_bottom_left("")
+            .corner_bottom_right("")
+            .border_top("")
+            .border_bottom("")
+            .border_left("")
+            .border_right("");
+      return result;
+    }();
+    return format;
+  }
+
+  static const Format &header_format() {
+    static const Format format = [] {
+      Format result;
+      result.font_style({FontStyle::underline}).font_align(FontAlign::center);
+      return result;
+    }();
+    return format;
+  }
+
+  Target target_;
+  size_t size_{0};
+};
+
+} // namespace tabulate
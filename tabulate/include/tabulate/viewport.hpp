@@ -0,0 +1,301 @@
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tabulate/table.hpp>
+#include <tabulate/table_model.hpp>
+#include <vector>
+
+namespace tabulate {
+
+// A window of a fixed number of lines over a table too tall for the
+// terminal, e.g., for a pager
+//
+//   Viewport viewport(table, 24);
+//   viewport.scroll(10);
+//   viewport.find("alice");
+//   viewport.print(std::cout);
+//
+// The columns and rows of the table are measured once, then only the rows
+// intersecting the window are laid out and rendered, so a print allocates for
+// the rows on the screen. The line on which each row starts is kept in a
+// prefix sum, so the window moves to any row in constant time, and to any
+// line with a binary search, however far it is. refresh() has to be called
+// after the table or its formats change.
+//
+// A viewport over a table model only holds the rows in the window, see the
+// second constructor.
+class Viewport {
+public:
+  Viewport(Table &table, size_t height) : table_(table.table_), height_(height) { refresh(); }
+
+  // Window over the rows of table followed by the rows of model, e.g., the
+  // header of a listing and its rows, which are read from model as they
+  // come into the window or are searched, and dropped afterwards. Like in a
+  // TableStream, columns without a configured width are measured on table
+  // and the first sample_rows rows of model only, longer text further down
+  // is word wrapped. refresh() reads every row of model once, to count its
+  // lines. model must outlive the viewport, table is left untouched.
+  Viewport(Table &table, const TableModel &model, size_t height, size_t sample_rows = 100)
+      : source_(table.table_), model_(&model), sample_rows_(std::max<size_t>(sample_rows, 1)),
+        height_(height) {
+    refresh();
+  }
+
+  // Lays the table out again, keeping the window on the same line if it
+  // still exists
+  void refresh() {
+    if (model_ != nullptr) {
+      measure_model();
+    } else {
+      layout_ = Printer::compute_dimensions(*table_);
+      offsets_ = Printer::compute_line_offsets(*table_, layout_);
+    }
+    borders_.clear();
+    scroll_to(top_);
+  }
+
+  // Number of lines of the rendered table
+  size_t num_lines() const { return offsets_.back(); }
+
+  size_t num_rows() const { return offsets_.size() - 1; }
+
+  size_t height() const { return height_; }
+
+  void set_height(size_t height) {
+    height_ = height;
+    scroll_to(top_);
+  }
+
+  // First line and row in the window
+  size_t top() const { return top_; }
+  size_t top_row() const { return top_row_; }
+
+  // Moves the window so that it starts at line, or as close to it as possible
+  // while staying filled
+  void scroll_to(size_t line) {
+    auto last_top = num_lines() > height_ ? num_lines() - height_ : 0;
+    top_ = std::min(line, last_top);
+    // Last row starting at or before top_
+    top_row_ = static_cast<size_t>(std::upper_bound(offsets_.begin(), offsets_.end() - 1, top_) -
+                                   offsets_.begin());
+    top_row_ = top_row_ > 0 ? top_row_ - 1 : 0;
+    row_ = top_row_;
+  }
+
+  // Moves the window by a number of lines, up if negative
+  void scroll(long lines) {
+    if (lines < 0)
+      scroll_to(top_ - std::min(top_, static_cast<size_t>(-lines)));
+    else
+      scroll_to(top_ + static_cast<size_t>(lines));
+  }
+
+  // Moves the window so that it starts at the top border of row
+  void scroll_to_row(size_t row) {
+    scroll_to(offsets_[std::min(row, num_rows())]);
+    if (row < num_rows())
+      row_ = row;
+  }
+
+  // Moves the window to the next row containing text in any of its cells,
+  // wrapping around at the end of the table. The search starts after the row
+  // the window was last moved to, which differs from top_row() when the
+  // window could not scroll that far. Returns false, without moving, if no
+  // row contains text
+  bool find(const std::string &text) { return find(text, true); }
+
+  // Same as find(), towards the beginning of the table
+  bool find_previous(const std::string &text) { return find(text, false); }
+
+  // Appends the lines in the window to buffer, styled through style
+  // The lines are separated by '\n', there is none after the last line
+  void print(std::string &buffer, StyleState &style) {
+    auto bottom = std::min(top_ + height_, num_lines());
+    auto last_row = top_row_;
+    while (last_row < num_rows() && offsets_[last_row] < bottom)
+      ++last_row;
+
+    // Rows of a model are read into the table for the time of the print, and
+    // laid out for the column widths measured by refresh(), the rows of a
+    // table are laid out in place
+    auto first_read = std::max(top_row_, fixed_rows_);
+    if (model_ != nullptr) {
+      if (first_read < last_row)
+        read_rows(first_read - fixed_rows_, last_row - fixed_rows_);
+      layout_ = Printer::compute_layout(*table_, column_widths_);
+      borders_.clear();
+    } else {
+      Printer::layout_rows(*table_, layout_, top_row_, last_row);
+    }
+
+    std::string lines;
+    for (size_t row = top_row_; row < last_row; ++row) {
+      auto table_row = row;
+      if (model_ != nullptr && row >= fixed_rows_)
+        table_row = fixed_rows_ + row - first_read;
+      lines.clear();
+      Printer::print_row(lines, style, *table_, layout_, table_row, &borders_);
+      if (row + 1 == num_rows()) {
+        // The bottom border of the table is on a line of its own if one was
+        // counted for it
+        style.reset();
+        auto row_lines = 1 + static_cast<size_t>(std::count(lines.begin(), lines.end(), '\n'));
+        if (offsets_[row + 1] - offsets_[row] > row_lines)
+          lines += '\n';
+        Printer::print_bottom_border(lines, style, *table_, layout_.column_widths, table_row);
+      }
+      style.reset();
+
+      // Keep the lines of the row falling in the window
+      auto line = offsets_[row];
+      size_t start{0};
+      while (start <= lines.size() && line < bottom) {
+        auto end = lines.find('\n', start);
+        if (end == std::string::npos)
+          end = lines.size();
+        if (line >= top_) {
+          if (line > top_)
+            buffer += '\n';
+          buffer.append(lines, start, end - start);
+        }
+        start = end + 1;
+        ++line;
+      }
+    }
+
+    if (model_ != nullptr)
+      table_->erase_rows(fixed_rows_, table_->size());
+    else
+      layout_.cells.clear();
+  }
+
+  // Writes the lines in the window to stream at once
+  void print(std::ostream &stream) {
+    std::string buffer;
+    StyleState style(buffer, stream);
+    print(buffer, style);
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+
+private:
+  bool find(const std::string &text, bool forward) {
+    auto rows = num_rows();
+    if (rows == 0)
+      return false;
+    for (size_t n = 1; n <= rows; ++n) {
+      auto row = forward ? (row_ + n) % rows : (row_ + rows - n % rows) % rows;
+      // The text of the cells is searched as it was given, matches can span
+      // the lines it is word wrapped into
+      bool found{false};
+      if (model_ != nullptr && row >= fixed_rows_) {
+        for (size_t j = 0; j < model_->num_columns() && !found; ++j) {
+          auto cell = model_->cell(row - fixed_rows_, j);
+          found = std::search(cell.begin(), cell.end(), text.begin(), text.end()) != cell.end();
+        }
+      } else {
+        for (size_t j = 0; j < table_->row_size(row) && !found; ++j) {
+          table_->visit_cell_text(table_->cell_index(row, j), [&](const char *data, size_t size) {
+            found = std::search(data, data + size, text.begin(), text.end()) != data + size;
+          });
+        }
+      }
+      if (found) {
+        scroll_to_row(row);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Measures the columns of a copy of the table with the first rows of the
+  // model, then counts the lines of every row of the model, laying them out
+  // sample_rows_ at a time. The last row of a batch is laid out again with
+  // the next one, the bottom border of the table is only counted for the
+  // last row of the model
+  void measure_model() {
+    table_ = source_->clone();
+    fixed_rows_ = table_->size();
+    auto rows = model_->num_rows();
+    auto last = std::min(sample_rows_, rows);
+    read_rows(0, last);
+    column_widths_ = Printer::compute_layout(*table_).column_widths;
+
+    offsets_.assign(1, 0);
+    while (true) {
+      auto layout = Printer::compute_layout(*table_, column_widths_);
+      auto offsets = Printer::compute_line_offsets(*table_, layout);
+      auto end = last == rows ? table_->size() : table_->size() - 1;
+      for (auto i = offsets_.size() == 1 ? 0 : fixed_rows_; i < end; ++i)
+        offsets_.push_back(offsets_.back() + offsets[i + 1] - offsets[i]);
+      if (last == rows)
+        break;
+
+      table_->erase_rows(fixed_rows_, table_->size() - 1);
+      auto next = std::min(last + sample_rows_, rows);
+      read_rows(last, next);
+      last = next;
+    }
+    table_->erase_rows(fixed_rows_, table_->size());
+  }
+
+  // Appends the rows [first, last) of the model to the table
+  void read_rows(size_t first, size_t last) {
+    std::vector<std::string> cells(model_->num_columns());
+    for (auto row = first; row < last; ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model_->cell(row, column);
+      table_->insert_row(table_->size(), cells, table_->estimate_num_columns());
+    }
+  }
+
+  std::shared_ptr<TableInternal> table_;
+  std::shared_ptr<TableInternal> source_; // table copied into table_, with a model
+  const TableModel *model_{nullptr};      // rows read into table_ after its own rows
+  size_t sample_rows_{0};
+  size_t fixed_rows_{0};             // rows of table_ not read from the model
+  std::vector<size_t> column_widths_; // measured by refresh() for the rows of the model
+  TableLayout layout_;   // of the rows in the window while they are printed
+  BorderLines borders_; // top borders rendered for layout_
+  std::vector<size_t> offsets_; // first line of each row, then the number of lines
+  size_t height_;
+  size_t top_{0};     // first line in the window
+  size_t top_row_{0}; // row on which top_ is
+  size_t row_{0};     // row the window was last moved to, searches start from it
+};
+
+} // namespace tabulate
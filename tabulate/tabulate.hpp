@@ -4036,6 +4036,7 @@ static int colorize_index = std::ios_base::xalloc();
 inline FILE *get_standard_stream(const std::ostream &stream);
 inline bool is_colorized(std::ostream &stream);
 inline bool is_atty(const std::ostream &stream);
+inline bool query_atty(FILE *std_stream);
 
 #if defined(TERMCOLOR_OS_WINDOWS)
 inline void win_change_attributes(std::ostream &stream, int foreground, int background = -1);
@@ -4349,8 +4350,20 @@ inline bool is_colorized(std::ostream &stream) {
   return is_atty(stream) || static_cast<bool>(stream.iword(colorize_index));
 }
 
+//! Test whether a given standard stream refers to a terminal.
+//! This is a system call, see is_atty() for the cached answer.
+inline bool query_atty(FILE *std_stream) {
+#if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
+  return ::isatty(fileno(std_stream));
+#elif defined(TERMCOLOR_OS_WINDOWS)
+  return ::_isatty(_fileno(std_stream));
+#endif
+}
+
 //! Test whether a given `std::ostream` object refers to
 //! a terminal.
+//! The answer is detected once per standard stream, on first use,
+//! and cached afterwards since every manipulator asks for it.
 inline bool is_atty(const std::ostream &stream) {
   FILE *std_stream = get_standard_stream(stream);
 
@@ -4361,11 +4374,12 @@ inline bool is_atty(const std::ostream &stream) {
   if (!std_stream)
     return false;
 
-#if defined(TERMCOLOR_OS_MACOS) || defined(TERMCOLOR_OS_LINUX)
-  return ::isatty(fileno(std_stream));
-#elif defined(TERMCOLOR_OS_WINDOWS)
-  return ::_isatty(_fileno(std_stream));
-#endif
+  if (std_stream == stdout) {
+    static const bool stdout_is_atty = query_atty(stdout);
+    return stdout_is_atty;
+  }
+  static const bool stderr_is_atty = query_atty(stderr);
+  return stderr_is_atty;
 }
 
 #if defined(TERMCOLOR_OS_WINDOWS)
@@ -4465,60 +4479,391 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <string>
 
-#include <clocale>
-#include <locale>
+#if !defined(TABULATE_DISABLE_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TABULATE_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABULATE_SIMD_SSE2
+#endif
+#endif
+
+namespace tabulate {
+
+// Kinds of bytes found in a text by classify_text(), as bit flags
+// Most cell text is plain ASCII without line breaks or spaces, e.g., hashes
+// and ids, which can be measured and wrapped by counting bytes
+enum TextClass : unsigned {
+  text_non_ascii = 1u << 0, // byte of a multi-byte UTF-8 sequence
+  text_control = 1u << 1,   // control character, including '\t' and '\n'
+  text_newline = 1u << 2,   // '\n'
+  text_space = 1u << 3,     // ' '
+  text_dash = 1u << 4,      // '-'
+};
+
+// Printable ASCII text is as wide as it is long
+inline bool is_printable_ascii(unsigned text_class) {
+  return (text_class & (text_non_ascii | text_control)) == 0;
+}
+
+inline unsigned classify_byte(uint8_t byte) {
+  unsigned result{0};
+  if (byte >= 0x80)
+    result |= text_non_ascii;
+  else if (byte < 0x20 || byte == 0x7F)
+    result |= text_control;
+  if (byte == '\n')
+    result |= text_newline;
+  else if (byte == ' ')
+    result |= text_space;
+  else if (byte == '-')
+    result |= text_dash;
+  return result;
+}
+
+// Classifies size bytes of text in a single pass, SIMD registers permitting
+// 32 or 16 bytes at a time
+inline unsigned classify_text(const char *text, size_t size) {
+  unsigned result{0};
+  size_t i{0};
+
+#if defined(TABULATE_SIMD_AVX2)
+  if (size >= 32) {
+    const __m256i space = _mm256_set1_epi8(' '), newline = _mm256_set1_epi8('\n'),
+                  dash = _mm256_set1_epi8('-'), del = _mm256_set1_epi8(0x7F),
+                  minus_one = _mm256_set1_epi8(-1);
+    __m256i any = _mm256_setzero_si256(), controls = any, newlines = any, spaces = any,
+            dashes = any;
+    for (; i + 32 <= size; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+      // Bytes are signed, 0x80 and above are negative
+      any = _mm256_or_si256(any, v);
+      controls = _mm256_or_si256(
+          controls, _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi8(space, v),
+                                                     _mm256_cmpgt_epi8(v, minus_one)),
+                                    _mm256_cmpeq_epi8(v, del)));
+      newlines = _mm256_or_si256(newlines, _mm256_cmpeq_epi8(v, newline));
+      spaces = _mm256_or_si256(spaces, _mm256_cmpeq_epi8(v, space));
+      dashes = _mm256_or_si256(dashes, _mm256_cmpeq_epi8(v, dash));
+    }
+    if (_mm256_movemask_epi8(any) != 0)
+      result |= text_non_ascii;
+    if (_mm256_movemask_epi8(controls) != 0)
+      result |= text_control;
+    if (_mm256_movemask_epi8(newlines) != 0)
+      result |= text_newline;
+    if (_mm256_movemask_epi8(spaces) != 0)
+      result |= text_space;
+    if (_mm256_movemask_epi8(dashes) != 0)
+      result |= text_dash;
+  }
+#elif defined(TABULATE_SIMD_SSE2)
+  if (size >= 16) {
+    const __m128i space = _mm_set1_epi8(' '), newline = _mm_set1_epi8('\n'),
+                  dash = _mm_set1_epi8('-'), del = _mm_set1_epi8(0x7F),
+                  minus_one = _mm_set1_epi8(-1);
+    __m128i any = _mm_setzero_si128(), controls = any, newlines = any, spaces = any, dashes = any;
+    for (; i + 16 <= size; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+      // Bytes are signed, 0x80 and above are negative
+      any = _mm_or_si128(any, v);
+      controls = _mm_or_si128(
+          controls,
+          _mm_or_si128(_mm_and_si128(_mm_cmplt_epi8(v, space), _mm_cmpgt_epi8(v, minus_one)),
+                       _mm_cmpeq_epi8(v, del)));
+      newlines = _mm_or_si128(newlines, _mm_cmpeq_epi8(v, newline));
+      spaces = _mm_or_si128(spaces, _mm_cmpeq_epi8(v, space));
+      dashes = _mm_or_si128(dashes, _mm_cmpeq_epi8(v, dash));
+    }
+    if (_mm_movemask_epi8(any) != 0)
+      result |= text_non_ascii;
+    if (_mm_movemask_epi8(controls) != 0)
+      result |= text_control;
+    if (_mm_movemask_epi8(newlines) != 0)
+      result |= text_newline;
+    if (_mm_movemask_epi8(spaces) != 0)
+      result |= text_space;
+    if (_mm_movemask_epi8(dashes) != 0)
+      result |= text_dash;
+  }
+#endif
+
+  for (; i < size; ++i)
+    result |= classify_byte(static_cast<uint8_t>(text[i]));
+  return result;
+}
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
 
-#include <cstdlib>
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 // #include <tabulate/termcolor.hpp>
-#include <wchar.h>
+// #include <tabulate/text_class.hpp>
 
 namespace tabulate {
 
-#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
-inline int get_wcswidth(const std::string &string, const std::string &locale,
-                        size_t max_column_width) {
-  if (string.size() == 0)
-    return 0;
-
-  // The behavior of wcswidth() depends on the LC_CTYPE category of the current locale.
-  // Set the current locale based on cell properties before computing width
-  auto old_locale = std::locale::global(std::locale(locale));
+// Inclusive range of Unicode code points
+struct CodePointRange {
+  char32_t first;
+  char32_t last;
+};
 
-  // Convert from narrow std::string to wide string
-  wchar_t *wide_string = new wchar_t[string.size()];
-  std::mbstowcs(wide_string, string.c_str(), string.size());
+template <size_t N>
+inline bool is_in_code_point_ranges(char32_t code_point, const CodePointRange (&ranges)[N]) {
+  if (code_point < ranges[0].first || code_point > ranges[N - 1].last)
+    return false;
+  auto range = std::upper_bound(
+      ranges, ranges + N, code_point,
+      [](char32_t value, const CodePointRange &range) { return value < range.first; });
+  return (range - 1)->last >= code_point;
+}
+
+// Nonspacing and enclosing marks, format characters and Hangul Jungseong/Jongseong
+// These take no column on their own, they modify the preceding character
+inline bool is_zero_width_code_point(char32_t code_point) {
+  static constexpr CodePointRange ranges[] = {
+      {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF}, {0x05C1, 0x05C2},
+      {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A}, {0x061C, 0x061C}, {0x064B, 0x065F},
+      {0x0670, 0x0670}, {0x06D6, 0x06DC}, {0x06DF, 0x06E4}, {0x06E7, 0x06E8}, {0x06EA, 0x06ED},
+      {0x0711, 0x0711}, {0x0730, 0x074A}, {0x07A6, 0x07B0}, {0x07EB, 0x07F3}, {0x07FD, 0x07FD},
+      {0x0816, 0x0819}, {0x081B, 0x0823}, {0x0825, 0x0827}, {0x0829, 0x082D}, {0x0859, 0x085B},
+      {0x0898, 0x089F}, {0x08CA, 0x08E1}, {0x08E3, 0x0902}, {0x093A, 0x093A}, {0x093C, 0x093C},
+      {0x0941, 0x0948}, {0x094D, 0x094D}, {0x0951, 0x0957}, {0x0962, 0x0963}, {0x0981, 0x0981},
+      {0x09BC, 0x09BC}, {0x09C1, 0x09C4}, {0x09CD, 0x09CD}, {0x09E2, 0x09E3}, {0x09FE, 0x0A02},
+      {0x0A3C, 0x0A3C}, {0x0A41, 0x0A51}, {0x0A70, 0x0A71}, {0x0A75, 0x0A75}, {0x0A81, 0x0A82},
+      {0x0ABC, 0x0ABC}, {0x0AC1, 0x0AC8}, {0x0ACD, 0x0ACD}, {0x0AE2, 0x0AE3}, {0x0AFA, 0x0B01},
+      {0x0B3C, 0x0B3C}, {0x0B3F, 0x0B3F}, {0x0B41, 0x0B44}, {0x0B4D, 0x0B56}, {0x0B62, 0x0B63},
+      {0x0B82, 0x0B82}, {0x0BC0, 0x0BC0}, {0x0BCD, 0x0BCD}, {0x0C00, 0x0C00}, {0x0C04, 0x0C04},
+      {0x0C3C, 0x0C3C}, {0x0C3E, 0x0C40}, {0x0C46, 0x0C56}, {0x0C62, 0x0C63}, {0x0C81, 0x0C81},
+      {0x0CBC, 0x0CBC}, {0x0CBF, 0x0CBF}, {0x0CC6, 0x0CC6}, {0x0CCC, 0x0CCD}, {0x0CE2, 0x0CE3},
+      {0x0D00, 0x0D01}, {0x0D3B, 0x0D3C}, {0x0D41, 0x0D44}, {0x0D4D, 0x0D4D}, {0x0D62, 0x0D63},
+      {0x0D81, 0x0D81}, {0x0DCA, 0x0DCA}, {0x0DD2, 0x0DD6}, {0x0E31, 0x0E31}, {0x0E34, 0x0E3A},
+      {0x0E47, 0x0E4E}, {0x0EB1, 0x0EB1}, {0x0EB4, 0x0EBC}, {0x0EC8, 0x0ECD}, {0x0F18, 0x0F19},
+      {0x0F35, 0x0F35}, {0x0F37, 0x0F37}, {0x0F39, 0x0F39}, {0x0F71, 0x0F7E}, {0x0F80, 0x0F84},
+      {0x0F86, 0x0F87}, {0x0F8D, 0x0FBC}, {0x0FC6, 0x0FC6}, {0x102D, 0x1030}, {0x1032, 0x1037},
+      {0x1039, 0x103A}, {0x103D, 0x103E}, {0x1058, 0x1059}, {0x105E, 0x1060}, {0x1071, 0x1074},
+      {0x1082, 0x1082}, {0x1085, 0x1086}, {0x108D, 0x108D}, {0x109D, 0x109D}, {0x1160, 0x11FF},
+      {0x135D, 0x135F}, {0x1712, 0x1714}, {0x1732, 0x1733}, {0x1752, 0x1753}, {0x1772, 0x1773},
+      {0x17B4, 0x17B5}, {0x17B7, 0x17BD}, {0x17C6, 0x17C6}, {0x17C9, 0x17D3}, {0x17DD, 0x17DD},
+      {0x180B, 0x180F}, {0x1885, 0x1886}, {0x18A9, 0x18A9}, {0x1920, 0x1922}, {0x1927, 0x1928},
+      {0x1932, 0x1932}, {0x1939, 0x193B}, {0x1A17, 0x1A18}, {0x1A1B, 0x1A1B}, {0x1A56, 0x1A56},
+      {0x1A58, 0x1A60}, {0x1A62, 0x1A62}, {0x1A65, 0x1A6C}, {0x1A73, 0x1A7F}, {0x1AB0, 0x1B03},
+      {0x1B34, 0x1B34}, {0x1B36, 0x1B3A}, {0x1B3C, 0x1B3C}, {0x1B42, 0x1B42}, {0x1B6B, 0x1B73},
+      {0x1B80, 0x1B81}, {0x1BA2, 0x1BA5}, {0x1BA8, 0x1BA9}, {0x1BAB, 0x1BAD}, {0x1BE6, 0x1BE6},
+      {0x1BE8, 0x1BE9}, {0x1BED, 0x1BED}, {0x1BEF, 0x1BF1}, {0x1C2C, 0x1C33}, {0x1C36, 0x1C37},
+      {0x1CD0, 0x1CD2}, {0x1CD4, 0x1CE0}, {0x1CE2, 0x1CE8}, {0x1CED, 0x1CED}, {0x1CF4, 0x1CF4},
+      {0x1CF8, 0x1CF9}, {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x206F},
+      {0x20D0, 0x20F0}, {0x2CEF, 0x2CF1}, {0x2D7F, 0x2D7F}, {0x2DE0, 0x2DFF}, {0x302A, 0x302D},
+      {0x3099, 0x309A}, {0xA66F, 0xA672}, {0xA674, 0xA67D}, {0xA69E, 0xA69F}, {0xA6F0, 0xA6F1},
+      {0xA802, 0xA802}, {0xA806, 0xA806}, {0xA80B, 0xA80B}, {0xA825, 0xA826}, {0xA82C, 0xA82C},
+      {0xA8C4, 0xA8C5}, {0xA8E0, 0xA8F1}, {0xA8FF, 0xA8FF}, {0xA926, 0xA92D}, {0xA947, 0xA951},
+      {0xA980, 0xA982}, {0xA9B3, 0xA9B3}, {0xA9B6, 0xA9B9}, {0xA9BC, 0xA9BD}, {0xA9E5, 0xA9E5},
+      {0xAA29, 0xAA2E}, {0xAA31, 0xAA32}, {0xAA35, 0xAA36}, {0xAA43, 0xAA43}, {0xAA4C, 0xAA4C},
+      {0xAA7C, 0xAA7C}, {0xAAB0, 0xAAB0}, {0xAAB2, 0xAAB4}, {0xAAB7, 0xAAB8}, {0xAABE, 0xAABF},
+      {0xAAC1, 0xAAC1}, {0xAAEC, 0xAAED}, {0xAAF6, 0xAAF6}, {0xABE5, 0xABE5}, {0xABE8, 0xABE8},
+      {0xABED, 0xABED}, {0xD7B0, 0xD7FB}, {0xFB1E, 0xFB1E}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F},
+      {0xFEFF, 0xFEFF}, {0xFFF9, 0xFFFB}, {0x101FD, 0x101FD}, {0x102E0, 0x102E0},
+      {0x10376, 0x1037A}, {0x10A01, 0x10A0F}, {0x10A38, 0x10A3F}, {0x10AE5, 0x10AE6},
+      {0x10D24, 0x10D27}, {0x10EAB, 0x10EAC}, {0x10F46, 0x10F50}, {0x10F82, 0x10F85},
+      {0x11001, 0x11001}, {0x11038, 0x11046}, {0x11070, 0x11070}, {0x11073, 0x11074},
+      {0x1107F, 0x11081}, {0x110B3, 0x110B6}, {0x110B9, 0x110BA}, {0x110C2, 0x110C2},
+      {0x11100, 0x11102}, {0x11127, 0x1112B}, {0x1112D, 0x11134}, {0x11173, 0x11173},
+      {0x11180, 0x11181}, {0x111B6, 0x111BE}, {0x111C9, 0x111CC}, {0x111CF, 0x111CF},
+      {0x1122F, 0x11231}, {0x11234, 0x11234}, {0x11236, 0x11237}, {0x1123E, 0x1123E},
+      {0x112DF, 0x112DF}, {0x112E3, 0x112EA}, {0x11300, 0x11301}, {0x1133B, 0x1133C},
+      {0x11340, 0x11340}, {0x11366, 0x11374}, {0x11438, 0x1143F}, {0x11442, 0x11444},
+      {0x11446, 0x11446}, {0x1145E, 0x1145E}, {0x114B3, 0x114B8}, {0x114BA, 0x114BA},
+      {0x114BF, 0x114C0}, {0x114C2, 0x114C3}, {0x115B2, 0x115B5}, {0x115BC, 0x115BD},
+      {0x115BF, 0x115C0}, {0x115DC, 0x115DD}, {0x11633, 0x1163A}, {0x1163D, 0x1163D},
+      {0x1163F, 0x11640}, {0x116AB, 0x116AB}, {0x116AD, 0x116AD}, {0x116B0, 0x116B5},
+      {0x116B7, 0x116B7}, {0x1171D, 0x1171F}, {0x11722, 0x11725}, {0x11727, 0x1172B},
+      {0x1182F, 0x11837}, {0x11839, 0x1183A}, {0x1193B, 0x1193C}, {0x1193E, 0x1193E},
+      {0x11943, 0x11943}, {0x119D4, 0x119DB}, {0x119E0, 0x119E0}, {0x11A01, 0x11A0A},
+      {0x11A33, 0x11A38}, {0x11A3B, 0x11A3E}, {0x11A47, 0x11A47}, {0x11A51, 0x11A56},
+      {0x11A59, 0x11A5B}, {0x11A8A, 0x11A96}, {0x11A98, 0x11A99}, {0x11C30, 0x11C3D},
+      {0x11C3F, 0x11C3F}, {0x11C92, 0x11CA7}, {0x11CAA, 0x11CB0}, {0x11CB2, 0x11CB3},
+      {0x11CB5, 0x11CB6}, {0x11D31, 0x11D45}, {0x11D47, 0x11D47}, {0x11D90, 0x11D91},
+      {0x11D95, 0x11D95}, {0x11D97, 0x11D97}, {0x11EF3, 0x11EF4}, {0x13430, 0x13438},
+      {0x16AF0, 0x16AF4}, {0x16B30, 0x16B36}, {0x16F4F, 0x16F4F}, {0x16F8F, 0x16F92},
+      {0x16FE4, 0x16FE4}, {0x1BC9D, 0x1BC9E}, {0x1BCA0, 0x1CF46}, {0x1D167, 0x1D169},
+      {0x1D173, 0x1D182}, {0x1D185, 0x1D18B}, {0x1D1AA, 0x1D1AD}, {0x1D242, 0x1D244},
+      {0x1DA00, 0x1DA36}, {0x1DA3B, 0x1DA6C}, {0x1DA75, 0x1DA75}, {0x1DA84, 0x1DA84},
+      {0x1DA9B, 0x1DAAF}, {0x1E000, 0x1E02A}, {0x1E130, 0x1E136}, {0x1E2AE, 0x1E2AE},
+      {0x1E2EC, 0x1E2EF}, {0x1E8D0, 0x1E8D6}, {0x1E944, 0x1E94A}, {0xE0001, 0xE01EF},
+  };
+  return is_in_code_point_ranges(code_point, ranges);
+}
+
+// East Asian Wide and Fullwidth characters, e.g., CJK ideographs, Hangul syllables and emoji
+inline bool is_wide_code_point(char32_t code_point) {
+  static constexpr CodePointRange ranges[] = {
+      {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC}, {0x23F0, 0x23F0},
+      {0x23F3, 0x23F3}, {0x25FD, 0x25FE}, {0x2614, 0x2615}, {0x2648, 0x2653}, {0x267F, 0x267F},
+      {0x2693, 0x2693}, {0x26A1, 0x26A1}, {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5},
+      {0x26CE, 0x26CE}, {0x26D4, 0x26D4}, {0x26EA, 0x26EA}, {0x26F2, 0x26F3}, {0x26F5, 0x26F5},
+      {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B}, {0x2728, 0x2728},
+      {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755}, {0x2757, 0x2757}, {0x2795, 0x2797},
+      {0x27B0, 0x27B0}, {0x27BF, 0x27BF}, {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55},
+      {0x2E80, 0x3029}, {0x302E, 0x303E}, {0x3041, 0x3096}, {0x309B, 0xA4C6}, {0xA960, 0xA97C},
+      {0xAC00, 0xD7A3}, {0xF900, 0xFAD9}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6B}, {0xFF01, 0xFF60},
+      {0xFFE0, 0xFFE6}, {0x16FE0, 0x16FE3}, {0x16FF0, 0x1B2FB}, {0x1F004, 0x1F004},
+      {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A}, {0x1F200, 0x1F320},
+      {0x1F32D, 0x1F335}, {0x1F337, 0x1F37C}, {0x1F37E, 0x1F393}, {0x1F3A0, 0x1F3CA},
+      {0x1F3CF, 0x1F3D3}, {0x1F3E0, 0x1F3F0}, {0x1F3F4, 0x1F3F4}, {0x1F3F8, 0x1F43E},
+      {0x1F440, 0x1F440}, {0x1F442, 0x1F4FC}, {0x1F4FF, 0x1F53D}, {0x1F54B, 0x1F54E},
+      {0x1F550, 0x1F567}, {0x1F57A, 0x1F57A}, {0x1F595, 0x1F596}, {0x1F5A4, 0x1F5A4},
+      {0x1F5FB, 0x1F64F}, {0x1F680, 0x1F6C5}, {0x1F6CC, 0x1F6CC}, {0x1F6D0, 0x1F6D2},
+      {0x1F6D5, 0x1F6DF}, {0x1F6EB, 0x1F6EC}, {0x1F6F4, 0x1F6FC}, {0x1F7E0, 0x1F7F0},
+      {0x1F90C, 0x1F93A}, {0x1F93C, 0x1F945}, {0x1F947, 0x1F9FF}, {0x1FA70, 0x1FAF6},
+      {0x20000, 0x3134A},
+  };
+  return is_in_code_point_ranges(code_point, ranges);
+}
+
+// Number of terminal columns taken by a code point:
+// 0 for combining marks, 2 for wide characters, 1 otherwise
+// and -1 for non-printable (control) characters
+inline int get_code_point_width(char32_t code_point) {
+  if (code_point < 0x7F)
+    return code_point >= 0x20 ? 1 : (code_point == 0 ? 0 : -1);
+  if (code_point < 0xA0)
+    return -1;
+  if (code_point < 0x300)
+    return 1;
+  if (is_zero_width_code_point(code_point))
+    return 0;
+  if (code_point >= 0x1100 && is_wide_code_point(code_point))
+    return 2;
+  return 1;
+}
+
+// Decodes the UTF-8 sequence starting at text[index] and moves index past it
+// Returns false for invalid, overlong or truncated sequences
+inline bool decode_utf8(const char *text, size_t size, size_t &index, char32_t &code_point) {
+  auto byte = [&](size_t i) { return static_cast<uint8_t>(text[i]); };
+  uint8_t lead = byte(index);
+  if (lead < 0x80) {
+    code_point = lead;
+    index += 1;
+    return true;
+  }
 
-  // Compute display width of wide string
-  int result = wcswidth(wide_string, max_column_width);
-  delete[] wide_string;
+  size_t length;
+  uint8_t min_next = 0x80, max_next = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+    code_point = lead & 0x1F;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    code_point = lead & 0x0F;
+    if (lead == 0xE0)
+      min_next = 0xA0; // overlong
+    else if (lead == 0xED)
+      max_next = 0x9F; // surrogates
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    code_point = lead & 0x07;
+    if (lead == 0xF0)
+      min_next = 0x90; // overlong
+    else if (lead == 0xF4)
+      max_next = 0x8F; // > U+10FFFF
+  } else {
+    return false;
+  }
 
-  // Restore old locale
-  std::locale::global(old_locale);
+  if (index + length > size || byte(index + 1) < min_next || byte(index + 1) > max_next)
+    return false;
+  for (size_t i = 1; i < length; ++i) {
+    if ((byte(index + i) & 0xC0) != 0x80)
+      return false;
+    code_point = (code_point << 6) | (byte(index + i) & 0x3F);
+  }
+  index += length;
+  return true;
+}
 
+// Display width of the first max_column_width characters of a UTF-8 string
+// Like wcswidth(), returns -1 if a non-printable character or an invalid
+// sequence is found. Neither the locale nor the heap are touched.
+inline int get_wcswidth(const char *text, size_t size, size_t max_column_width) {
+  int result{0};
+  size_t index{0};
+  for (size_t count = 0; index < size && count < max_column_width; ++count) {
+    char32_t code_point;
+    if (!decode_utf8(text, size, index, code_point))
+      return -1;
+    auto width = get_code_point_width(code_point);
+    if (width < 0)
+      return -1;
+    result += width;
+  }
   return result;
 }
-#endif
 
-inline size_t get_sequence_length(const std::string &text, const std::string &locale,
+// The locale is ignored, text is always decoded as UTF-8
+// Kept for compatibility with the locale based implementation
+inline int get_wcswidth(const std::string &string, const std::string & /*locale*/,
+                        size_t max_column_width) {
+  return get_wcswidth(string.data(), string.size(), max_column_width);
+}
+
+inline size_t get_sequence_length(const char *text, size_t size,
                                   bool is_multi_byte_character_support_enabled) {
   if (!is_multi_byte_character_support_enabled)
-    return text.length();
+    return size;
+  if (is_printable_ascii(classify_text(text, size)))
+    return size;
 
-#if defined(_WIN32) || defined(_WIN64)
-  return (text.length() - std::count_if(text.begin(), text.end(),
-                                        [](char c) -> bool { return (c & 0xC0) == 0x80; }));
-#elif defined(__unix__) || defined(__unix) || defined(__APPLE__)
-  auto result = get_wcswidth(text, locale, text.size());
+  auto result = get_wcswidth(text, size, size);
   if (result >= 0)
     return result;
   else
-    return (text.length() - std::count_if(text.begin(), text.end(),
-                                          [](char c) -> bool { return (c & 0xC0) == 0x80; }));
-#endif
+    return (size - std::count_if(text, text + size,
+                                 [](char c) -> bool { return (c & 0xC0) == 0x80; }));
+}
+
+inline size_t get_sequence_length(const std::string &text, const std::string & /*locale*/,
+                                  bool is_multi_byte_character_support_enabled) {
+  return get_sequence_length(text.data(), text.size(), is_multi_byte_character_support_enabled);
 }
 
 } // namespace tabulate
@@ -4560,7 +4905,7 @@ SOFTWARE.
 
 namespace tabulate {
 
-enum class Color { none, grey, red, green, yellow, blue, magenta, cyan, white };
+enum class Color : unsigned char { none, grey, red, green, yellow, blue, magenta, cyan, white };
 }
 
 /*
@@ -4599,7 +4944,7 @@ SOFTWARE.
 
 namespace tabulate {
 
-enum class FontAlign { left, right, center };
+enum class FontAlign : unsigned char { left, right, center };
 }
 
 /*
@@ -4639,6 +4984,9 @@ SOFTWARE.
 namespace tabulate {
 
 enum class FontStyle { bold, dark, italic, underline, blink, reverse, concealed, crossed };
+
+// Bit of a font style in a set of font styles, e.g., Format::font_style_
+inline unsigned font_style_bit(FontStyle style) { return 1u << static_cast<unsigned>(style); }
 }
 
 /*
@@ -4674,8 +5022,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <iostream>
-#include <memory>
+#include <cstddef>
 #include <string>
 // #include <tabulate/format.hpp>
 /*
@@ -4712,328 +5059,568 @@ SOFTWARE.
 */
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstddef>
-#include <sstream>
+#include <cstdint>
 #include <string>
 // #include <tabulate/color.hpp>
 // #include <tabulate/font_align.hpp>
 // #include <tabulate/font_style.hpp>
-// #include <tabulate/utf8.hpp>
+// #include <tabulate/interned_string.hpp>
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
 
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-// #include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
 
-#include <vector>
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
 
 namespace tabulate {
 
-class Format {
+// A string stored once for the whole process, e.g., a border glyph
+// Copying and comparing interned strings only involves a pointer
+class InternedString {
 public:
-  Format &width(size_t value) {
-    width_ = value;
-    return *this;
-  }
+  InternedString() = default;
 
-  Format &height(size_t value) {
-    height_ = value;
-    return *this;
-  }
+  explicit InternedString(const std::string &value)
+      : string_(value.empty() ? nullptr : &intern(value)) {}
 
-  Format &padding(size_t value) {
-    padding_left_ = value;
-    padding_right_ = value;
-    padding_top_ = value;
-    padding_bottom_ = value;
-    return *this;
-  }
+  const std::string &str() const { return string_ ? *string_ : empty_string(); }
 
-  Format &padding_left(size_t value) {
-    padding_left_ = value;
-    return *this;
-  }
+  bool empty() const { return string_ == nullptr; }
 
-  Format &padding_right(size_t value) {
-    padding_right_ = value;
-    return *this;
-  }
+  bool operator==(const InternedString &other) const { return string_ == other.string_; }
 
-  Format &padding_top(size_t value) {
-    padding_top_ = value;
-    return *this;
-  }
+  bool operator!=(const InternedString &other) const { return string_ != other.string_; }
 
-  Format &padding_bottom(size_t value) {
-    padding_bottom_ = value;
-    return *this;
+private:
+  // Elements of an unordered_set never move, so the returned reference stays
+  // valid until the process exits
+  static const std::string &intern(const std::string &value) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> strings;
+    std::lock_guard<std::mutex> lock(mutex);
+    return *strings.insert(value).first;
   }
 
-  Format &border(const std::string &value) {
-    border_left_ = value;
-    border_right_ = value;
-    border_top_ = value;
-    border_bottom_ = value;
-    return *this;
+  static const std::string &empty_string() {
+    static const std::string empty;
+    return empty;
   }
 
-  Format &border_color(Color value) {
-    border_left_color_ = value;
-    border_right_color_ = value;
-    border_top_color_ = value;
-    border_bottom_color_ = value;
-    return *this;
-  }
+  const std::string *string_{nullptr};
+};
 
-  Format &border_background_color(Color value) {
-    border_left_background_color_ = value;
-    border_right_background_color_ = value;
-    border_top_background_color_ = value;
-    border_bottom_background_color_ = value;
-    return *this;
-  }
+} // namespace tabulate
 
-  Format &border_left(const std::string &value) {
-    border_left_ = value;
-    return *this;
-  }
+// #include <tabulate/layout.hpp>
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
 
-  Format &border_left_color(Color value) {
-    border_left_color_ = value;
-    return *this;
-  }
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
 
-  Format &border_left_background_color(Color value) {
-    border_left_background_color_ = value;
-    return *this;
-  }
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
 
-  Format &border_right(const std::string &value) {
-    border_right_ = value;
-    return *this;
-  }
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
 
-  Format &border_right_color(Color value) {
-    border_right_color_ = value;
-    return *this;
-  }
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
 
-  Format &border_right_background_color(Color value) {
-    border_right_background_color_ = value;
-    return *this;
-  }
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
-  Format &border_top(const std::string &value) {
-    border_top_ = value;
-    return *this;
-  }
+namespace tabulate {
 
-  Format &border_top_color(Color value) {
-    border_top_color_ = value;
-    return *this;
-  }
+// A single visual line of a laid out cell
+// offset and length refer to CellLayout::text(), width is the display width
+struct LineSpan {
+  size_t offset;
+  size_t length;
+  size_t width;
+};
 
-  Format &border_top_background_color(Color value) {
-    border_top_background_color_ = value;
-    return *this;
-  }
+class NestedLayout;
 
-  Format &border_bottom(const std::string &value) {
-    border_bottom_ = value;
-    return *this;
-  }
+// Result of word wrapping a cell exactly once for the width of its column
+class CellLayout {
+public:
+  size_t height() const { return lines.size(); }
 
-  Format &border_bottom_color(Color value) {
-    border_bottom_color_ = value;
-    return *this;
+  std::string line(size_t index) const {
+    return std::string(text() + lines[index].offset, lines[index].length);
   }
 
-  Format &border_bottom_background_color(Color value) {
-    border_bottom_background_color_ = value;
-    return *this;
-  }
+  // Text the lines refer to: the text of the cell in its table, which is not
+  // copied, until the layout rewrites it, e.g., to word wrap it
+  const char *text() const { return view_ != nullptr ? view_ : text_.data(); }
+  size_t text_size() const { return view_ != nullptr ? view_size_ : text_.size(); }
 
-  Format &show_border() {
-    show_border_top_ = true;
-    show_border_bottom_ = true;
-    show_border_left_ = true;
-    show_border_right_ = true;
-    return *this;
+  // Refers to text, which must not change while the layout is in use
+  void view_text(const char *text, size_t size) {
+    view_ = text;
+    view_size_ = size;
+    text_.clear();
   }
 
-  Format &hide_border() {
-    show_border_top_ = false;
-    show_border_bottom_ = false;
-    show_border_left_ = false;
-    show_border_right_ = false;
-    return *this;
+  // Replaces the text with text of the layout's own
+  void set_text(std::string &&text) {
+    text_ = std::move(text);
+    view_ = nullptr;
   }
 
-  Format &show_border_top() {
-    show_border_top_ = true;
-    return *this;
+  std::vector<LineSpan> lines;
+  unsigned text_class{0}; // TextClass flags of text()
+
+  // Layout of the table nested in the cell, if any, which is rendered in
+  // place one line at a time. Its lines have no text, only a width
+  std::unique_ptr<NestedLayout> nested;
+
+private:
+  const char *view_{nullptr};
+  size_t view_size_{0};
+  std::string text_; // rewritten text, used when view_ is nullptr
+};
+
+// Dimensions and per-cell line spans of a whole table
+// Computed once per print by Printer::compute_layout() and then shared by
+// the height, width and printing stages
+// The cells may be laid out for a window of rows only, e.g., the rows shown by
+// a Viewport, see Printer::layout_rows()
+class TableLayout {
+public:
+  size_t num_rows() const { return row_heights.size(); }
+
+  size_t num_columns() const { return column_widths.size(); }
+
+  CellLayout &cell(size_t row, size_t column) {
+    return cells[(row - first_row) * num_columns() + column];
+  }
+
+  const CellLayout &cell(size_t row, size_t column) const {
+    return cells[(row - first_row) * num_columns() + column];
+  }
+
+  std::vector<size_t> row_heights;
+  std::vector<size_t> column_widths;
+  size_t first_row{0};           // row of the first cells
+  std::vector<CellLayout> cells; // row-major, from first_row on
+};
+
+// A table nested in a cell, laid out for the width of the column of the cell
+class NestedLayout {
+public:
+  TableLayout layout;
+  std::vector<size_t> line_offsets; // see Printer::compute_line_offsets()
+};
+
+} // namespace tabulate
+
+// #include <tabulate/overflow.hpp>
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+namespace tabulate {
+
+// What is done with text wider than its column
+//   wrap:     the text is word wrapped over as many lines as it takes
+//   truncate: the first line of text is cut to the width of the column and
+//             ends with an ellipsis, so that the cell takes a single line
+enum class Overflow : unsigned char { wrap, truncate };
+}
+
+// #include <tabulate/utf8.hpp>
+#include <vector>
+
+namespace tabulate {
+
+class Format {
+public:
+  Format &width(size_t value) {
+    set(Property::width, width_, value);
+    return *this;
+  }
+
+  Format &height(size_t value) {
+    set(Property::height, height_, value);
+    return *this;
+  }
+
+  Format &padding(size_t value) {
+    set(Property::padding_left, padding_left_, value);
+    set(Property::padding_right, padding_right_, value);
+    set(Property::padding_top, padding_top_, value);
+    set(Property::padding_bottom, padding_bottom_, value);
+    return *this;
+  }
+
+  Format &padding_left(size_t value) {
+    set(Property::padding_left, padding_left_, value);
+    return *this;
+  }
+
+  Format &padding_right(size_t value) {
+    set(Property::padding_right, padding_right_, value);
+    return *this;
+  }
+
+  Format &padding_top(size_t value) {
+    set(Property::padding_top, padding_top_, value);
+    return *this;
+  }
+
+  Format &padding_bottom(size_t value) {
+    set(Property::padding_bottom, padding_bottom_, value);
+    return *this;
+  }
+
+  Format &border(const std::string &value) {
+    set(Property::border_left, border_left_, value);
+    set(Property::border_right, border_right_, value);
+    set(Property::border_top, border_top_, value);
+    set(Property::border_bottom, border_bottom_, value);
+    return *this;
+  }
+
+  Format &border_color(Color value) {
+    set(Property::border_left_color, border_left_color_, value);
+    set(Property::border_right_color, border_right_color_, value);
+    set(Property::border_top_color, border_top_color_, value);
+    set(Property::border_bottom_color, border_bottom_color_, value);
+    return *this;
+  }
+
+  Format &border_background_color(Color value) {
+    set(Property::border_left_background_color, border_left_background_color_, value);
+    set(Property::border_right_background_color, border_right_background_color_, value);
+    set(Property::border_top_background_color, border_top_background_color_, value);
+    set(Property::border_bottom_background_color, border_bottom_background_color_, value);
+    return *this;
+  }
+
+  Format &border_left(const std::string &value) {
+    set(Property::border_left, border_left_, value);
+    return *this;
+  }
+
+  Format &border_left_color(Color value) {
+    set(Property::border_left_color, border_left_color_, value);
+    return *this;
+  }
+
+  Format &border_left_background_color(Color value) {
+    set(Property::border_left_background_color, border_left_background_color_, value);
+    return *this;
+  }
+
+  Format &border_right(const std::string &value) {
+    set(Property::border_right, border_right_, value);
+    return *this;
+  }
+
+  Format &border_right_color(Color value) {
+    set(Property::border_right_color, border_right_color_, value);
+    return *this;
+  }
+
+  Format &border_right_background_color(Color value) {
+    set(Property::border_right_background_color, border_right_background_color_, value);
+    return *this;
+  }
+
+  Format &border_top(const std::string &value) {
+    set(Property::border_top, border_top_, value);
+    return *this;
+  }
+
+  Format &border_top_color(Color value) {
+    set(Property::border_top_color, border_top_color_, value);
+    return *this;
+  }
+
+  Format &border_top_background_color(Color value) {
+    set(Property::border_top_background_color, border_top_background_color_, value);
+    return *this;
+  }
+
+  Format &border_bottom(const std::string &value) {
+    set(Property::border_bottom, border_bottom_, value);
+    return *this;
+  }
+
+  Format &border_bottom_color(Color value) {
+    set(Property::border_bottom_color, border_bottom_color_, value);
+    return *this;
+  }
+
+  Format &border_bottom_background_color(Color value) {
+    set(Property::border_bottom_background_color, border_bottom_background_color_, value);
+    return *this;
+  }
+
+  Format &show_border() {
+    set(Property::show_border_top, show_border_top_, true);
+    set(Property::show_border_bottom, show_border_bottom_, true);
+    set(Property::show_border_left, show_border_left_, true);
+    set(Property::show_border_right, show_border_right_, true);
+    return *this;
+  }
+
+  Format &hide_border() {
+    set(Property::show_border_top, show_border_top_, false);
+    set(Property::show_border_bottom, show_border_bottom_, false);
+    set(Property::show_border_left, show_border_left_, false);
+    set(Property::show_border_right, show_border_right_, false);
+    return *this;
+  }
+
+  Format &show_border_top() {
+    set(Property::show_border_top, show_border_top_, true);
+    return *this;
   }
 
   Format &hide_border_top() {
-    show_border_top_ = false;
+    set(Property::show_border_top, show_border_top_, false);
     return *this;
   }
 
   Format &show_border_bottom() {
-    show_border_bottom_ = true;
+    set(Property::show_border_bottom, show_border_bottom_, true);
     return *this;
   }
 
   Format &hide_border_bottom() {
-    show_border_bottom_ = false;
+    set(Property::show_border_bottom, show_border_bottom_, false);
     return *this;
   }
 
   Format &show_border_left() {
-    show_border_left_ = true;
+    set(Property::show_border_left, show_border_left_, true);
     return *this;
   }
 
   Format &hide_border_left() {
-    show_border_left_ = false;
+    set(Property::show_border_left, show_border_left_, false);
     return *this;
   }
 
   Format &show_border_right() {
-    show_border_right_ = true;
+    set(Property::show_border_right, show_border_right_, true);
     return *this;
   }
 
   Format &hide_border_right() {
-    show_border_right_ = false;
+    set(Property::show_border_right, show_border_right_, false);
     return *this;
   }
 
   Format &corner(const std::string &value) {
-    corner_top_left_ = value;
-    corner_top_right_ = value;
-    corner_bottom_left_ = value;
-    corner_bottom_right_ = value;
+    set(Property::corner_top_left, corner_top_left_, value);
+    set(Property::corner_top_right, corner_top_right_, value);
+    set(Property::corner_bottom_left, corner_bottom_left_, value);
+    set(Property::corner_bottom_right, corner_bottom_right_, value);
     return *this;
   }
 
   Format &corner_color(Color value) {
-    corner_top_left_color_ = value;
-    corner_top_right_color_ = value;
-    corner_bottom_left_color_ = value;
-    corner_bottom_right_color_ = value;
+    set(Property::corner_top_left_color, corner_top_left_color_, value);
+    set(Property::corner_top_right_color, corner_top_right_color_, value);
+    set(Property::corner_bottom_left_color, corner_bottom_left_color_, value);
+    set(Property::corner_bottom_right_color, corner_bottom_right_color_, value);
     return *this;
   }
 
   Format &corner_background_color(Color value) {
-    corner_top_left_background_color_ = value;
-    corner_top_right_background_color_ = value;
-    corner_bottom_left_background_color_ = value;
-    corner_bottom_right_background_color_ = value;
+    set(Property::corner_top_left_background_color, corner_top_left_background_color_, value);
+    set(Property::corner_top_right_background_color, corner_top_right_background_color_, value);
+    set(Property::corner_bottom_left_background_color, corner_bottom_left_background_color_, value);
+    set(Property::corner_bottom_right_background_color,
+        corner_bottom_right_background_color_, value);
     return *this;
   }
 
   Format &corner_top_left(const std::string &value) {
-    corner_top_left_ = value;
+    set(Property::corner_top_left, corner_top_left_, value);
     return *this;
   }
 
   Format &corner_top_left_color(Color value) {
-    corner_top_left_color_ = value;
+    set(Property::corner_top_left_color, corner_top_left_color_, value);
     return *this;
   }
 
   Format &corner_top_left_background_color(Color value) {
-    corner_top_left_background_color_ = value;
+    set(Property::corner_top_left_background_color, corner_top_left_background_color_, value);
     return *this;
   }
 
   Format &corner_top_right(const std::string &value) {
-    corner_top_right_ = value;
+    set(Property::corner_top_right, corner_top_right_, value);
     return *this;
   }
 
   Format &corner_top_right_color(Color value) {
-    corner_top_right_color_ = value;
+    set(Property::corner_top_right_color, corner_top_right_color_, value);
     return *this;
   }
 
   Format &corner_top_right_background_color(Color value) {
-    corner_top_right_background_color_ = value;
+    set(Property::corner_top_right_background_color, corner_top_right_background_color_, value);
     return *this;
   }
 
   Format &corner_bottom_left(const std::string &value) {
-    corner_bottom_left_ = value;
+    set(Property::corner_bottom_left, corner_bottom_left_, value);
     return *this;
   }
 
   Format &corner_bottom_left_color(Color value) {
-    corner_bottom_left_color_ = value;
+    set(Property::corner_bottom_left_color, corner_bottom_left_color_, value);
     return *this;
   }
 
   Format &corner_bottom_left_background_color(Color value) {
-    corner_bottom_left_background_color_ = value;
+    set(Property::corner_bottom_left_background_color, corner_bottom_left_background_color_, value);
     return *this;
   }
 
   Format &corner_bottom_right(const std::string &value) {
-    corner_bottom_right_ = value;
+    set(Property::corner_bottom_right, corner_bottom_right_, value);
     return *this;
   }
 
   Format &corner_bottom_right_color(Color value) {
-    corner_bottom_right_color_ = value;
+    set(Property::corner_bottom_right_color, corner_bottom_right_color_, value);
     return *this;
   }
 
   Format &corner_bottom_right_background_color(Color value) {
-    corner_bottom_right_background_color_ = value;
+    set(Property::corner_bottom_right_background_color,
+        corner_bottom_right_background_color_, value);
     return *this;
   }
 
   Format &column_separator(const std::string &value) {
-    column_separator_ = value;
+    set(Property::column_separator, column_separator_, value);
     return *this;
   }
 
   Format &column_separator_color(Color value) {
-    column_separator_color_ = value;
+    set(Property::column_separator_color, column_separator_color_, value);
     return *this;
   }
 
   Format &column_separator_background_color(Color value) {
-    column_separator_background_color_ = value;
+    set(Property::column_separator_background_color, column_separator_background_color_, value);
     return *this;
   }
 
   Format &font_align(FontAlign value) {
-    font_align_ = value;
+    set(Property::font_align, font_align_, value);
     return *this;
   }
 
   Format &font_style(const std::vector<FontStyle> &style) {
-    if (font_style_.has_value()) {
-      for (auto &s : style)
-        font_style_->push_back(s);
-    } else {
-      font_style_ = style;
-    }
+    // Font styles add up
+    for (auto &s : style)
+      font_style_ |= static_cast<unsigned char>(font_style_bit(s));
+    properties_ |= bit(Property::font_style);
+    owner_.changed();
     return *this;
   }
 
   Format &font_color(Color value) {
-    font_color_ = value;
+    set(Property::font_color, font_color_, value);
     return *this;
   }
 
   Format &font_background_color(Color value) {
-    font_background_color_ = value;
+    set(Property::font_background_color, font_background_color_, value);
     return *this;
   }
 
@@ -5051,73 +5638,146 @@ public:
     return *this;
   }
 
+  // Text wider than its column is word wrapped by default, truncation keeps
+  // every row of the column a single line high
+  Format &overflow(Overflow value) {
+    set(Property::overflow, overflow_, value);
+    return *this;
+  }
+
   Format &multi_byte_characters(bool value) {
-    multi_byte_characters_ = value;
+    set(Property::multi_byte_characters, multi_byte_characters_, value);
     return *this;
   }
 
+  // Display widths are always computed for UTF-8 text, independently of the
+  // process locale, so this setting is only kept for compatibility
   Format &locale(const std::string &value) {
-    locale_ = value;
+    set(Property::locale, locale_, value);
     return *this;
   }
 
   // Apply word wrap
   // Given an input string and a line length, this will insert \n
   // in strategic places in input string and apply word wrapping
-  static std::string word_wrap(const std::string &str, size_t width, const std::string &locale,
+  static std::string word_wrap(const std::string &str, size_t width,
+                               const std::string & /*locale*/,
                                bool is_multi_byte_character_support_enabled) {
-    std::vector<std::string> words = explode_string(str, {" ", "-", "\t"});
-    size_t current_line_length = 0;
     std::string result;
+    std::vector<LineSpan> lines;
+    word_wrap(str.data(), str.size(), width, is_multi_byte_character_support_enabled, result,
+              lines);
+    return result;
+  }
 
-    for (size_t i = 0; i < words.size(); ++i) {
-      std::string word = words[i];
+  // Word wraps size bytes of text and appends the wrapped lines to result,
+  // separated by '\n'. The span and display width of each line in result is
+  // added to lines, except for a trailing empty line
+  // Words are read in place, only the output is allocated
+  static void word_wrap(const char *text, size_t size, size_t width,
+                        bool is_multi_byte_character_support_enabled, std::string &result,
+                        std::vector<LineSpan> &lines) {
+    // Printable ASCII is as wide as it is long, it is never measured
+    auto text_class = classify_text(text, size);
+    auto ascii = is_printable_ascii(text_class);
+    auto sequence_length = [&](const char *data, size_t length) {
+      return ascii ? length
+                   : get_sequence_length(data, length, is_multi_byte_character_support_enabled);
+    };
+
+    size_t line_start = result.size();
+    auto end_line = [&]() {
+      auto length = result.size() - line_start;
+      lines.push_back({line_start, length, sequence_length(result.data() + line_start, length)});
+      result += '\n';
+      line_start = result.size();
+    };
+
+    size_t current_line_length = 0;
+    auto add_word = [&](const char *word, size_t length) {
+      if (length == 0)
+        return;
+      auto word_length = sequence_length(word, length);
       // If adding the new word to the current line would be too long,
       // then put it on a new line (and split it up if it's too long).
-      if (current_line_length +
-              get_sequence_length(word, locale, is_multi_byte_character_support_enabled) >
-          width) {
+      if (current_line_length + word_length > width) {
         // Only move down to a new line if we have text on the current line.
         // Avoids situation where wrapped whitespace causes emptylines in text.
         if (current_line_length > 0) {
-          result += '\n';
+          end_line();
           current_line_length = 0;
         }
 
         // If the current word is too long to fit on a line even on it's own then
         // split the word up.
-        while (get_sequence_length(word, locale, is_multi_byte_character_support_enabled) > width) {
-          result += word.substr(0, width - 1) + "-";
-          word = word.substr(width - 1);
-          result += '\n';
+        // A single column has no room left for the hyphen.
+        while (word_length > width) {
+          auto chunk = width > 1 ? width - 1 : 1;
+          result.append(word, chunk);
+          if (width > 1)
+            result += '-';
+          end_line();
+          word += chunk;
+          length -= chunk;
+          word_length = sequence_length(word, length);
         }
 
         // Remove leading whitespace from the word so the new line starts flush to the left.
-        word = trim_left(word);
+        while (length > 0 && std::isspace(static_cast<unsigned char>(*word))) {
+          ++word;
+          --length;
+        }
+        word_length = sequence_length(word, length);
       }
-      result += word;
-      current_line_length +=
-          get_sequence_length(word, locale, is_multi_byte_character_support_enabled);
+      result.append(word, length);
+      current_line_length += word_length;
+    };
+
+    // Spaces and tabs are words of their own
+    // Unlike whitespace, dashes and the like should stick to the word occurring before it.
+    // Without a space, a tab or a dash the text is a single word
+    size_t start{0};
+    if ((text_class & (text_space | text_dash | text_control)) == 0) {
+      add_word(text, size);
+      start = size;
     }
-    return result;
+    while (start < size) {
+      auto end = start;
+      while (end < size && text[end] != ' ' && text[end] != '\t' && text[end] != '-')
+        ++end;
+      if (end == size) {
+        add_word(text + start, end - start);
+        break;
+      }
+      if (text[end] == '-') {
+        add_word(text + start, end + 1 - start);
+      } else {
+        add_word(text + start, end - start);
+        add_word(text + end, 1);
+      }
+      start = end + 1;
+    }
+
+    auto length = result.size() - line_start;
+    auto line_width = sequence_length(result.data() + line_start, length);
+    if (line_width > 0)
+      lines.push_back({line_start, length, line_width});
   }
 
   static std::vector<std::string> split_lines(const std::string &text, const std::string &delimiter,
-                                              const std::string &locale,
+                                              const std::string & /*locale*/,
                                               bool is_multi_byte_character_support_enabled) {
     std::vector<std::string> result{};
-    std::string input = text;
-    size_t pos = 0;
-    std::string token;
-    while ((pos = input.find(delimiter)) != std::string::npos) {
-      token = input.substr(0, pos);
-      result.push_back(token);
-      input.erase(0, pos + delimiter.length());
-    }
-    if (get_sequence_length(input, locale, is_multi_byte_character_support_enabled))
-      result.push_back(input);
+    size_t start{0}, pos;
+    while (!delimiter.empty() && (pos = text.find(delimiter, start)) != std::string::npos) {
+      result.push_back(text.substr(start, pos - start));
+      start = pos + delimiter.size();
+    }
+    if (get_sequence_length(text.data() + start, text.size() - start,
+                            is_multi_byte_character_support_enabled))
+      result.push_back(text.substr(start));
     return result;
-  };
+  }
 
   // Merge two formats
   // first has higher precedence
@@ -5125,447 +5785,315 @@ public:
   // second = row-level formatting
   // Result has attributes of both with cell-level
   // formatting taking precedence
-  static Format merge(Format first, Format second) {
-    Format result;
+  static Format merge(const Format &first, const Format &second) {
+    // Start from second and take over every property set in first
+    Format result = second;
+    result.take(first, Property::width, &Format::width_);
+    result.take(first, Property::height, &Format::height_);
+    result.take(first, Property::font_align, &Format::font_align_);
+    result.take(first, Property::font_color, &Format::font_color_);
+    result.take(first, Property::font_background_color, &Format::font_background_color_);
+    result.take(first, Property::padding_left, &Format::padding_left_);
+    result.take(first, Property::padding_top, &Format::padding_top_);
+    result.take(first, Property::padding_right, &Format::padding_right_);
+    result.take(first, Property::padding_bottom, &Format::padding_bottom_);
+    result.take(first, Property::show_border_top, &Format::show_border_top_);
+    result.take(first, Property::border_top, &Format::border_top_);
+    result.take(first, Property::border_top_color, &Format::border_top_color_);
+    result.take(first, Property::border_top_background_color,
+                &Format::border_top_background_color_);
+    result.take(first, Property::show_border_bottom, &Format::show_border_bottom_);
+    result.take(first, Property::border_bottom, &Format::border_bottom_);
+    result.take(first, Property::border_bottom_color, &Format::border_bottom_color_);
+    result.take(first, Property::border_bottom_background_color,
+                &Format::border_bottom_background_color_);
+    result.take(first, Property::show_border_left, &Format::show_border_left_);
+    result.take(first, Property::border_left, &Format::border_left_);
+    result.take(first, Property::border_left_color, &Format::border_left_color_);
+    result.take(first, Property::border_left_background_color,
+                &Format::border_left_background_color_);
+    result.take(first, Property::show_border_right, &Format::show_border_right_);
+    result.take(first, Property::border_right, &Format::border_right_);
+    result.take(first, Property::border_right_color, &Format::border_right_color_);
+    result.take(first, Property::border_right_background_color,
+                &Format::border_right_background_color_);
+    result.take(first, Property::corner_top_left, &Format::corner_top_left_);
+    result.take(first, Property::corner_top_left_color, &Format::corner_top_left_color_);
+    result.take(first, Property::corner_top_left_background_color,
+                &Format::corner_top_left_background_color_);
+    result.take(first, Property::corner_top_right, &Format::corner_top_right_);
+    result.take(first, Property::corner_top_right_color, &Format::corner_top_right_color_);
+    result.take(first, Property::corner_top_right_background_color,
+                &Format::corner_top_right_background_color_);
+    result.take(first, Property::corner_bottom_left, &Format::corner_bottom_left_);
+    result.take(first, Property::corner_bottom_left_color, &Format::corner_bottom_left_color_);
+    result.take(first, Property::corner_bottom_left_background_color,
+                &Format::corner_bottom_left_background_color_);
+    result.take(first, Property::corner_bottom_right, &Format::corner_bottom_right_);
+    result.take(first, Property::corner_bottom_right_color, &Format::corner_bottom_right_color_);
+    result.take(first, Property::corner_bottom_right_background_color,
+                &Format::corner_bottom_right_background_color_);
+    result.take(first, Property::column_separator, &Format::column_separator_);
+    result.take(first, Property::column_separator_color, &Format::column_separator_color_);
+    result.take(first, Property::column_separator_background_color,
+                &Format::column_separator_background_color_);
+    result.take(first, Property::overflow, &Format::overflow_);
+    result.take(first, Property::multi_byte_characters, &Format::multi_byte_characters_);
+    result.take(first, Property::locale, &Format::locale_);
+
+    // Font styles add up
+    if (first.has(Property::font_style))
+      result.font_style_ |= first.font_style_;
+
+    result.properties_ |= first.properties_;
+    return result;
+  }
 
-    // Width and height
-    if (first.width_.has_value())
-      result.width_ = first.width_;
-    else
-      result.width_ = second.width_;
+private:
+  friend class Cell;
+  friend class Row;
+  friend class Column;
+  friend class TableInternal;
+  friend class Printer;
+  friend class MarkdownExporter;
+  friend class LatexExporter;
+  friend class AsciiDocExporter;
 
-    if (first.height_.has_value())
-      result.height_ = first.height_;
-    else
-      result.height_ = second.height_;
+  void set_defaults() {
+    // NOTE: width and height are not set here
+    font_align(FontAlign::left);
+    font_style({});
+    font_color(Color::none);
+    font_background_color(Color::none);
+    padding_left(1);
+    padding_right(1);
+    padding_top(0);
+    padding_bottom(0);
+    border_top("-");
+    border_bottom("-");
+    border_left("|");
+    border_right("|");
+    show_border();
+    border_color(Color::none);
+    border_background_color(Color::none);
+    corner("+");
+    corner_color(Color::none);
+    corner_background_color(Color::none);
+    column_separator("|");
+    column_separator_color(Color::none);
+    column_separator_background_color(Color::none);
+    overflow(Overflow::wrap);
+    multi_byte_characters(false);
+    locale("");
+  }
+
+  // Properties, as bits of properties_
+  enum class Property : unsigned char {
+    width,
+    height,
+    font_align,
+    font_style,
+    font_color,
+    font_background_color,
+    padding_left,
+    padding_top,
+    padding_right,
+    padding_bottom,
+    show_border_top,
+    border_top,
+    border_top_color,
+    border_top_background_color,
+    show_border_bottom,
+    border_bottom,
+    border_bottom_color,
+    border_bottom_background_color,
+    show_border_left,
+    border_left,
+    border_left_color,
+    border_left_background_color,
+    show_border_right,
+    border_right,
+    border_right_color,
+    border_right_background_color,
+    corner_top_left,
+    corner_top_left_color,
+    corner_top_left_background_color,
+    corner_top_right,
+    corner_top_right_color,
+    corner_top_right_background_color,
+    corner_bottom_left,
+    corner_bottom_left_color,
+    corner_bottom_left_background_color,
+    corner_bottom_right,
+    corner_bottom_right_color,
+    corner_bottom_right_background_color,
+    column_separator,
+    column_separator_color,
+    column_separator_background_color,
+    overflow,
+    multi_byte_characters,
+    locale,
+  };
 
-    // Font styling
-    if (first.font_align_.has_value())
-      result.font_align_ = first.font_align_;
-    else
-      result.font_align_ = second.font_align_;
+  static uint64_t bit(Property property) {
+    return uint64_t(1) << static_cast<unsigned>(property);
+  }
 
-    if (first.font_style_.has_value()) {
-      // Merge font styles using std::set_union
-      std::vector<FontStyle> merged_font_style(first.font_style_->size() +
-                                               second.font_style_->size());
-#if defined(_WIN32) || defined(_WIN64)
-      // Fixes error in Windows - Sequence not ordered
-      std::sort(first.font_style_->begin(), first.font_style_->end());
-      std::sort(second.font_style_->begin(), second.font_style_->end());
-#endif
-      std::set_union(first.font_style_->begin(), first.font_style_->end(),
-                     second.font_style_->begin(), second.font_style_->end(),
-                     merged_font_style.begin());
-      result.font_style_ = merged_font_style;
-    } else
-      result.font_style_ = second.font_style_;
-
-    if (first.font_color_.has_value())
-      result.font_color_ = first.font_color_;
-    else
-      result.font_color_ = second.font_color_;
+  bool has(Property property) const { return (properties_ & bit(property)) != 0; }
 
-    if (first.font_background_color_.has_value())
-      result.font_background_color_ = first.font_background_color_;
-    else
-      result.font_background_color_ = second.font_background_color_;
+  template <typename T, typename U> void set(Property property, T &field, const U &value) {
+    field = T(value);
+    properties_ |= bit(property);
+    owner_.changed();
+  }
 
-    // Padding
-    if (first.padding_left_.has_value())
-      result.padding_left_ = first.padding_left_;
-    else
-      result.padding_left_ = second.padding_left_;
+  // Table a format belongs to, told about every change of the format, even
+  // through a Format& kept across prints, see TableInternal::resolve_formats()
+  // A copy of a format belongs to no table, assigning to a format changes it
+  class Owner {
+  public:
+    Owner() = default;
+    Owner(const Owner &) {}
+    Owner &operator=(const Owner &) {
+      changed();
+      return *this;
+    }
 
-    if (first.padding_top_.has_value())
-      result.padding_top_ = first.padding_top_;
-    else
-      result.padding_top_ = second.padding_top_;
+    // generation counts the changes of the formats of the table
+    void attach(std::atomic<uint64_t> *generation) { generation_ = generation; }
 
-    if (first.padding_right_.has_value())
-      result.padding_right_ = first.padding_right_;
-    else
-      result.padding_right_ = second.padding_right_;
+    void changed() {
+      if (generation_ != nullptr)
+        changed_ = generation_->fetch_add(1, std::memory_order_relaxed) + 1;
+    }
 
-    if (first.padding_bottom_.has_value())
-      result.padding_bottom_ = first.padding_bottom_;
-    else
-      result.padding_bottom_ = second.padding_bottom_;
+    // Generation of the table after the last change of the format, 0 if it
+    // was not changed since it was attached
+    uint64_t last_change() const { return changed_; }
 
-    // Border
-    if (first.border_left_.has_value())
-      result.border_left_ = first.border_left_;
-    else
-      result.border_left_ = second.border_left_;
+  private:
+    std::atomic<uint64_t> *generation_{nullptr};
+    uint64_t changed_{0};
+  };
 
-    if (first.border_left_color_.has_value())
-      result.border_left_color_ = first.border_left_color_;
-    else
-      result.border_left_color_ = second.border_left_color_;
+  // Copies a property of other, if it is set there
+  template <typename T> void take(const Format &other, Property property, T Format::*field) {
+    if (other.has(property))
+      this->*field = other.*field;
+  }
 
-    if (first.border_left_background_color_.has_value())
-      result.border_left_background_color_ = first.border_left_background_color_;
-    else
-      result.border_left_background_color_ = second.border_left_background_color_;
+  // Properties set in this format
+  // The fields of the properties that are not set are left zero-initialized
+  uint64_t properties_{0};
 
-    if (first.border_top_.has_value())
-      result.border_top_ = first.border_top_;
-    else
-      result.border_top_ = second.border_top_;
+  // Element width and height
+  size_t width_{0};
+  size_t height_{0};
 
-    if (first.border_top_color_.has_value())
-      result.border_top_color_ = first.border_top_color_;
-    else
-      result.border_top_color_ = second.border_top_color_;
+  // Font styling
+  FontAlign font_align_{};
+  unsigned char font_style_{0}; // font_style_bit() of each style
+  Color font_color_{};
+  Color font_background_color_{};
 
-    if (first.border_top_background_color_.has_value())
-      result.border_top_background_color_ = first.border_top_background_color_;
-    else
-      result.border_top_background_color_ = second.border_top_background_color_;
+  // Element padding
+  size_t padding_left_{0};
+  size_t padding_top_{0};
+  size_t padding_right_{0};
+  size_t padding_bottom_{0};
 
-    if (first.border_bottom_.has_value())
-      result.border_bottom_ = first.border_bottom_;
-    else
-      result.border_bottom_ = second.border_bottom_;
+  // Element border
+  bool show_border_top_{false};
+  InternedString border_top_{};
+  Color border_top_color_{};
+  Color border_top_background_color_{};
+
+  bool show_border_bottom_{false};
+  InternedString border_bottom_{};
+  Color border_bottom_color_{};
+  Color border_bottom_background_color_{};
+
+  bool show_border_left_{false};
+  InternedString border_left_{};
+  Color border_left_color_{};
+  Color border_left_background_color_{};
+
+  bool show_border_right_{false};
+  InternedString border_right_{};
+  Color border_right_color_{};
+  Color border_right_background_color_{};
 
-    if (first.border_bottom_color_.has_value())
-      result.border_bottom_color_ = first.border_bottom_color_;
-    else
-      result.border_bottom_color_ = second.border_bottom_color_;
+  // Element corner
+  InternedString corner_top_left_{};
+  Color corner_top_left_color_{};
+  Color corner_top_left_background_color_{};
 
-    if (first.border_bottom_background_color_.has_value())
-      result.border_bottom_background_color_ = first.border_bottom_background_color_;
-    else
-      result.border_bottom_background_color_ = second.border_bottom_background_color_;
+  InternedString corner_top_right_{};
+  Color corner_top_right_color_{};
+  Color corner_top_right_background_color_{};
 
-    if (first.border_right_.has_value())
-      result.border_right_ = first.border_right_;
-    else
-      result.border_right_ = second.border_right_;
+  InternedString corner_bottom_left_{};
+  Color corner_bottom_left_color_{};
+  Color corner_bottom_left_background_color_{};
 
-    if (first.border_right_color_.has_value())
-      result.border_right_color_ = first.border_right_color_;
-    else
-      result.border_right_color_ = second.border_right_color_;
+  InternedString corner_bottom_right_{};
+  Color corner_bottom_right_color_{};
+  Color corner_bottom_right_background_color_{};
 
-    if (first.border_right_background_color_.has_value())
-      result.border_right_background_color_ = first.border_right_background_color_;
-    else
-      result.border_right_background_color_ = second.border_right_background_color_;
+  // Element column separator
+  InternedString column_separator_{};
+  Color column_separator_color_{};
+  Color column_separator_background_color_{};
 
-    if (first.show_border_top_.has_value())
-      result.show_border_top_ = first.show_border_top_;
-    else
-      result.show_border_top_ = second.show_border_top_;
+  // Text wider than its column
+  Overflow overflow_{};
 
-    if (first.show_border_bottom_.has_value())
-      result.show_border_bottom_ = first.show_border_bottom_;
-    else
-      result.show_border_bottom_ = second.show_border_bottom_;
+  // Internationalization
+  bool multi_byte_characters_{false};
+  InternedString locale_{};
 
-    if (first.show_border_left_.has_value())
-      result.show_border_left_ = first.show_border_left_;
-    else
-      result.show_border_left_ = second.show_border_left_;
+  Owner owner_;
+};
 
-    if (first.show_border_right_.has_value())
-      result.show_border_right_ = first.show_border_right_;
-    else
-      result.show_border_right_ = second.show_border_right_;
+} // namespace tabulate
 
-    // Corner
-    if (first.corner_top_left_.has_value())
-      result.corner_top_left_ = first.corner_top_left_;
-    else
-      result.corner_top_left_ = second.corner_top_left_;
+// #include <tabulate/utf8.hpp>
 
-    if (first.corner_top_left_color_.has_value())
-      result.corner_top_left_color_ = first.corner_top_left_color_;
-    else
-      result.corner_top_left_color_ = second.corner_top_left_color_;
+namespace tabulate {
 
-    if (first.corner_top_left_background_color_.has_value())
-      result.corner_top_left_background_color_ = first.corner_top_left_background_color_;
-    else
-      result.corner_top_left_background_color_ = second.corner_top_left_background_color_;
+// A cell of a table
+// Cells are views over the storage of their table; the text and the format
+// of every cell live in TableInternal
+class Cell {
+public:
+  Cell(class TableInternal &table, size_t index) : table_(&table), index_(index) {}
 
-    if (first.corner_top_right_.has_value())
-      result.corner_top_right_ = first.corner_top_right_;
-    else
-      result.corner_top_right_ = second.corner_top_right_;
+  void set_text(const std::string &text);
 
-    if (first.corner_top_right_color_.has_value())
-      result.corner_top_right_color_ = first.corner_top_right_color_;
-    else
-      result.corner_top_right_color_ = second.corner_top_right_color_;
+  std::string get_text() const;
 
-    if (first.corner_top_right_background_color_.has_value())
-      result.corner_top_right_background_color_ = first.corner_top_right_background_color_;
-    else
-      result.corner_top_right_background_color_ = second.corner_top_right_background_color_;
+  size_t size() const {
+    return get_sequence_length(get_text(), locale(), is_multi_byte_character_support_enabled());
+  }
 
-    if (first.corner_bottom_left_.has_value())
-      result.corner_bottom_left_ = first.corner_bottom_left_;
-    else
-      result.corner_bottom_left_ = second.corner_bottom_left_;
+  std::string locale() const { return resolved_format().locale_.str(); }
 
-    if (first.corner_bottom_left_color_.has_value())
-      result.corner_bottom_left_color_ = first.corner_bottom_left_color_;
-    else
-      result.corner_bottom_left_color_ = second.corner_bottom_left_color_;
+  // Cell-level formatting
+  // Only the properties set here override the column, row and table formats
+  Format &format();
 
-    if (first.corner_bottom_left_background_color_.has_value())
-      result.corner_bottom_left_background_color_ = first.corner_bottom_left_background_color_;
-    else
-      result.corner_bottom_left_background_color_ = second.corner_bottom_left_background_color_;
+  // Cell-level formatting, read only: unlike format(), the cell is left
+  // without a format of its own if it has none
+  const Format &format() const;
 
-    if (first.corner_bottom_right_.has_value())
-      result.corner_bottom_right_ = first.corner_bottom_right_;
-    else
-      result.corner_bottom_right_ = second.corner_bottom_right_;
-
-    if (first.corner_bottom_right_color_.has_value())
-      result.corner_bottom_right_color_ = first.corner_bottom_right_color_;
-    else
-      result.corner_bottom_right_color_ = second.corner_bottom_right_color_;
-
-    if (first.corner_bottom_right_background_color_.has_value())
-      result.corner_bottom_right_background_color_ = first.corner_bottom_right_background_color_;
-    else
-      result.corner_bottom_right_background_color_ = second.corner_bottom_right_background_color_;
-
-    // Column separator
-    if (first.column_separator_.has_value())
-      result.column_separator_ = first.column_separator_;
-    else
-      result.column_separator_ = second.column_separator_;
-
-    if (first.column_separator_color_.has_value())
-      result.column_separator_color_ = first.column_separator_color_;
-    else
-      result.column_separator_color_ = second.column_separator_color_;
-
-    if (first.column_separator_background_color_.has_value())
-      result.column_separator_background_color_ = first.column_separator_background_color_;
-    else
-      result.column_separator_background_color_ = second.column_separator_background_color_;
-
-    // Internationlization
-    if (first.multi_byte_characters_.has_value())
-      result.multi_byte_characters_ = first.multi_byte_characters_;
-    else
-      result.multi_byte_characters_ = second.multi_byte_characters_;
-
-    if (first.locale_.has_value())
-      result.locale_ = first.locale_;
-    else
-      result.locale_ = second.locale_;
-
-    return result;
-  }
-
-private:
-  friend class Cell;
-  friend class Row;
-  friend class Column;
-  friend class TableInternal;
-  friend class Printer;
-  friend class MarkdownExporter;
-  friend class LatexExporter;
-  friend class AsciiDocExporter;
-
-  void set_defaults() {
-    // NOTE: width and height are not set here
-    font_align_ = FontAlign::left;
-    font_style_ = std::vector<FontStyle>{};
-    font_color_ = font_background_color_ = Color::none;
-    padding_left_ = padding_right_ = 1;
-    padding_top_ = padding_bottom_ = 0;
-    border_top_ = border_bottom_ = "-";
-    border_left_ = border_right_ = "|";
-    show_border_left_ = show_border_right_ = show_border_top_ = show_border_bottom_ = true;
-    border_top_color_ = border_top_background_color_ = border_bottom_color_ =
-        border_bottom_background_color_ = border_left_color_ = border_left_background_color_ =
-            border_right_color_ = border_right_background_color_ = Color::none;
-    corner_top_left_ = corner_top_right_ = corner_bottom_left_ = corner_bottom_right_ = "+";
-    corner_top_left_color_ = corner_top_left_background_color_ = corner_top_right_color_ =
-        corner_top_right_background_color_ = corner_bottom_left_color_ =
-            corner_bottom_left_background_color_ = corner_bottom_right_color_ =
-                corner_bottom_right_background_color_ = Color::none;
-    column_separator_ = "|";
-    column_separator_color_ = column_separator_background_color_ = Color::none;
-    multi_byte_characters_ = false;
-    locale_ = "";
-  }
-
-  // Helper methods for word wrapping:
-
-  // trim white spaces from the left end of an input string
-  static std::string trim_left(const std::string &input_string) {
-    std::string result = input_string;
-    result.erase(result.begin(), std::find_if(result.begin(), result.end(),
-                                              [](int ch) { return !std::isspace(ch); }));
-    return result;
-  }
-
-  // trim white spaces from right end of an input string
-  static std::string trim_right(const std::string &input_string) {
-    std::string result = input_string;
-    result.erase(
-        std::find_if(result.rbegin(), result.rend(), [](int ch) { return !std::isspace(ch); })
-            .base(),
-        result.end());
-    return result;
-  }
-
-  // trim white spaces from either end of an input string
-  static std::string trim(const std::string &input_string) {
-    return trim_left(trim_right(input_string));
-  }
-
-  static size_t index_of_any(const std::string &input, size_t start_index,
-                             const std::vector<std::string> &split_characters) {
-    std::vector<size_t> indices{};
-    for (auto &c : split_characters) {
-      auto index = input.find(c, start_index);
-      if (index != std::string::npos)
-        indices.push_back(index);
-    }
-    if (indices.size() > 0)
-      return *std::min_element(indices.begin(), indices.end());
-    else
-      return std::string::npos;
-  }
-
-  static std::vector<std::string> explode_string(const std::string &input,
-                                                 const std::vector<std::string> &split_characters) {
-    std::vector<std::string> result{};
-    size_t start_index{0};
-    while (true) {
-      auto index = index_of_any(input, start_index, split_characters);
-
-      if (index == std::string::npos) {
-        result.push_back(input.substr(start_index));
-        return result;
-      }
-
-      std::string word = input.substr(start_index, index - start_index);
-      char next_character = input.substr(index, 1)[0];
-      // Unlike whitespace, dashes and the like should stick to the word occurring before it.
-      if (isspace(next_character)) {
-        result.push_back(word);
-        result.push_back(std::string(1, next_character));
-      } else {
-        result.push_back(word + next_character);
-      }
-      start_index = index + 1;
-    }
-
-    return result;
-  }
-
-  // Element width and height
-  optional<size_t> width_{};
-  optional<size_t> height_{};
-
-  // Font styling
-  optional<FontAlign> font_align_{};
-  optional<std::vector<FontStyle>> font_style_{};
-  optional<Color> font_color_{};
-  optional<Color> font_background_color_{};
-
-  // Element padding
-  optional<size_t> padding_left_{};
-  optional<size_t> padding_top_{};
-  optional<size_t> padding_right_{};
-  optional<size_t> padding_bottom_{};
-
-  // Element border
-  optional<bool> show_border_top_{};
-  optional<std::string> border_top_{};
-  optional<Color> border_top_color_{};
-  optional<Color> border_top_background_color_{};
-
-  optional<bool> show_border_bottom_{};
-  optional<std::string> border_bottom_{};
-  optional<Color> border_bottom_color_{};
-  optional<Color> border_bottom_background_color_{};
-
-  optional<bool> show_border_left_{};
-  optional<std::string> border_left_{};
-  optional<Color> border_left_color_{};
-  optional<Color> border_left_background_color_{};
-
-  optional<bool> show_border_right_{};
-  optional<std::string> border_right_{};
-  optional<Color> border_right_color_{};
-  optional<Color> border_right_background_color_{};
-
-  // Element corner
-  optional<std::string> corner_top_left_{};
-  optional<Color> corner_top_left_color_{};
-  optional<Color> corner_top_left_background_color_{};
+  // Effective formatting of the cell, i.e., cell > column > row > table
+  const Format &resolved_format() const;
 
-  optional<std::string> corner_top_right_{};
-  optional<Color> corner_top_right_color_{};
-  optional<Color> corner_top_right_background_color_{};
-
-  optional<std::string> corner_bottom_left_{};
-  optional<Color> corner_bottom_left_color_{};
-  optional<Color> corner_bottom_left_background_color_{};
-
-  optional<std::string> corner_bottom_right_{};
-  optional<Color> corner_bottom_right_color_{};
-  optional<Color> corner_bottom_right_background_color_{};
-
-  // Element column separator
-  optional<std::string> column_separator_{};
-  optional<Color> column_separator_color_{};
-  optional<Color> column_separator_background_color_{};
-
-  // Internationalization
-  optional<bool> multi_byte_characters_{};
-  optional<std::string> locale_{};
-};
-
-} // namespace tabulate
-
-// #include <tabulate/utf8.hpp>
-
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-// #include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
-
-#include <vector>
-
-namespace tabulate {
-
-class Cell {
-public:
-  explicit Cell(std::shared_ptr<class Row> parent) : parent_(parent) {}
-
-  void set_text(const std::string &text) { data_ = text; }
-
-  const std::string &get_text() { return data_; }
-
-  size_t size() {
-    return get_sequence_length(data_, locale(), is_multi_byte_character_support_enabled());
-  }
-
-  std::string locale() { return *format().locale_; }
-
-  Format &format();
-
-  bool is_multi_byte_character_support_enabled();
+  bool is_multi_byte_character_support_enabled() const;
 
 private:
-  std::string data_;
-  std::weak_ptr<class Row> parent_;
-  optional<Format> format_;
+  class TableInternal *table_;
+  size_t index_; // position of the cell in the cell storage of table_
 };
 
 } // namespace tabulate
@@ -5603,160 +6131,56 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <iostream>
-#include <memory>
-#include <string>
+#include <cstddef>
+#include <deque>
 // #include <tabulate/cell.hpp>
 
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-// #include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
-
-#include <vector>
-#ifdef max
-#undef max
-#endif
-#ifdef min
-#undef min
-#endif
-
 namespace tabulate {
 
+// A row of a table
+// Like cells, rows are views over the storage of their table
 class Row {
 public:
-  explicit Row(std::shared_ptr<class TableInternal> parent) : parent_(parent) {}
-
-  void add_cell(std::shared_ptr<Cell> cell) { cells_.push_back(cell); }
+  Row(class TableInternal &table, size_t index) : table_(&table), index_(index) {}
 
   Cell &operator[](size_t index) { return cell(index); }
 
-  Cell &cell(size_t index) { return *(cells_[index]); }
+  const Cell &operator[](size_t index) const { return cell(index); }
+
+  Cell &cell(size_t index);
 
-  std::vector<std::shared_ptr<Cell>> cells() const { return cells_; }
+  const Cell &cell(size_t index) const;
 
-  size_t size() const { return cells_.size(); }
+  size_t size() const;
 
+  // Row-level formatting
+  // Only the properties set here override the table format
   Format &format();
 
+  // Row-level formatting, read only
+  const Format &format() const;
+
   class CellIterator {
   public:
-    explicit CellIterator(std::vector<std::shared_ptr<Cell>>::iterator ptr) : ptr(ptr) {}
+    explicit CellIterator(std::deque<Cell>::iterator ptr) : ptr(ptr) {}
 
     CellIterator operator++() {
       ++ptr;
       return *this;
     }
     bool operator!=(const CellIterator &other) const { return ptr != other.ptr; }
-    Cell &operator*() { return **ptr; }
+    Cell &operator*() { return *ptr; }
 
   private:
-    std::vector<std::shared_ptr<Cell>>::iterator ptr;
+    std::deque<Cell>::iterator ptr;
   };
 
-  auto begin() -> CellIterator { return CellIterator(cells_.begin()); }
-  auto end() -> CellIterator { return CellIterator(cells_.end()); }
+  CellIterator begin();
+  CellIterator end();
 
 private:
-  friend class Printer;
-
-  // Returns the row height as configured
-  // For each cell in the row, check the cell.format.height
-  // property and return the largest configured row height
-  // This is used to ensure that all cells in a row are
-  // aligned when printing the column
-  size_t get_configured_height() {
-    size_t result{0};
-    for (size_t i = 0; i < size(); ++i) {
-      auto cell = cells_[i];
-      auto format = cell->format();
-      if (format.height_.has_value())
-        result = std::max(result, *format.height_);
-    }
-    return result;
-  }
-
-  // Computes the height of the row based on cell contents
-  // and configured cell padding
-  // For each cell, compute:
-  //   padding_top + (cell_contents / column height) + padding_bottom
-  // and return the largest value
-  //
-  // This is useful when no cell.format.height is configured
-  // Call get_configured_height()
-  // - If this returns 0, then use get_computed_height()
-  size_t get_computed_height(const std::vector<size_t> &column_widths) {
-    size_t result{0};
-    for (size_t i = 0; i < size(); ++i) {
-      result = std::max(result, get_cell_height(i, column_widths[i]));
-    }
-    return result;
-  }
-
-  // Returns padding_top + cell_contents / column_height + padding_bottom
-  // for a given cell in the column
-  // e.g.,
-  // column width = 5
-  // cell_contents = "I love tabulate" (size/length = 15)
-  // padding top and padding bottom are 1
-  // then, cell height = 1 + (15 / 5) + 1 = 1 + 3 + 1 = 5
-  // The cell will look like this:
-  //
-  // .....
-  // I lov
-  // e tab
-  // ulate
-  // .....
-  size_t get_cell_height(size_t cell_index, size_t column_width) {
-    size_t result{0};
-    Cell &cell = *(cells_[cell_index]);
-    auto format = cell.format();
-    auto text = cell.get_text();
-
-    auto padding_left = *format.padding_left_;
-    auto padding_right = *format.padding_right_;
-
-    result += *format.padding_top_;
-
-    if (column_width > (padding_left + padding_right)) {
-      column_width -= (padding_left + padding_right);
-    }
-
-    // Check if input text has embedded newline characters
-    auto newlines_in_text = std::count(text.begin(), text.end(), '\n');
-    std::string word_wrapped_text;
-    if (newlines_in_text == 0) {
-      // No new lines in input
-      // Apply automatic word wrapping and compute row height
-      word_wrapped_text = Format::word_wrap(text, column_width, cell.locale(),
-                                            cell.is_multi_byte_character_support_enabled());
-    } else {
-      // There are embedded '\n' characters
-      // Respect these characters
-      word_wrapped_text = text;
-    }
-
-    auto newlines_in_wrapped_text =
-        std::count(word_wrapped_text.begin(), word_wrapped_text.end(), '\n');
-    auto estimated_row_height = newlines_in_wrapped_text;
-
-    if (!word_wrapped_text.empty() &&
-        word_wrapped_text[word_wrapped_text.size() - 1] != '\n') // text doesn't end with a newline
-      estimated_row_height += 1;
-
-    result += estimated_row_height;
-
-    result += *format.padding_bottom_;
-
-    return result;
-  }
-
-  std::vector<std::shared_ptr<Cell>> cells_;
-  std::weak_ptr<class TableInternal> parent_;
-  optional<Format> format_;
+  class TableInternal *table_;
+  size_t index_; // position of the row in table_
 };
 
 } // namespace tabulate
@@ -5846,6 +6270,9 @@ public:
   ColumnFormat &color(Color value);
   ColumnFormat &background_color(Color value);
 
+  // Overflow
+  ColumnFormat &overflow(Overflow value);
+
   // Locale
   ColumnFormat &multi_byte_characters(bool value);
   ColumnFormat &locale(const std::string &value);
@@ -5893,10 +6320,10 @@ SOFTWARE.
 #include <functional>
 #include <iostream>
 #include <memory>
-#include <optional>
 #include <string>
 // #include <tabulate/cell.hpp>
 // #include <tabulate/column_format.hpp>
+#include <utility>
 #include <vector>
 #ifdef max
 #undef max
@@ -5907,327 +6334,233 @@ SOFTWARE.
 
 namespace tabulate {
 
+// A column of a table, i.e., the cell at the same position in every row
 class Column {
 public:
-  explicit Column(std::shared_ptr<class TableInternal> parent) : parent_(parent) {}
-
-  void add_cell(Cell &cell) { cells_.push_back(cell); }
+  Column(std::shared_ptr<class TableInternal> table, size_t index)
+      : table_(std::move(table)), index_(index) {}
 
-  Cell &operator[](size_t index) { return cells_[index]; }
+  // Cell of the column in the given row
+  Cell &operator[](size_t index);
 
-  std::vector<std::reference_wrapper<Cell>> cells() const { return cells_; }
-
-  size_t size() const { return cells_.size(); }
+  size_t size() const;
 
+  // Column-level formatting
+  // The format is stored once for the column, whatever its number of rows,
+  // and also applies to rows added later. Only the properties set here
+  // override the row and table formats, cell formats override it
   ColumnFormat format() { return ColumnFormat(*this); }
 
   class CellIterator {
   public:
-    explicit CellIterator(std::vector<std::reference_wrapper<Cell>>::iterator ptr) : ptr(ptr) {}
+    CellIterator(Column &column, size_t row) : column_(column), row_(row) {}
 
     CellIterator operator++() {
-      ++ptr;
+      ++row_;
       return *this;
     }
-    bool operator!=(const CellIterator &other) const { return ptr != other.ptr; }
-    Cell &operator*() { return *ptr; }
+    bool operator!=(const CellIterator &other) const { return row_ != other.row_; }
+    Cell &operator*() { return column_[row_]; }
 
   private:
-    std::vector<std::reference_wrapper<Cell>>::iterator ptr;
+    Column &column_;
+    size_t row_;
   };
 
-  auto begin() -> CellIterator { return CellIterator(cells_.begin()); }
-  auto end() -> CellIterator { return CellIterator(cells_.end()); }
+  auto begin() -> CellIterator { return CellIterator(*this, 0); }
+  auto end() -> CellIterator { return CellIterator(*this, size()); }
 
 private:
   friend class ColumnFormat;
-  friend class Printer;
-
-  // Returns the column width as configured
-  // For each cell in the column, check the cell.format.width
-  // property and return the largest configured column width
-  // This is used to ensure that all cells in a column are
-  // aligned when printing the column
-  size_t get_configured_width() {
-    size_t result{0};
-    for (size_t i = 0; i < size(); ++i) {
-      auto cell = cells_[i];
-      auto format = cell.get().format();
-      if (format.width_.has_value())
-        result = std::max(result, *format.width_);
-    }
-    return result;
-  }
 
-  // Computes the width of the column based on cell contents
-  // and configured cell padding
-  // For each cell, compute padding_left + cell_contents + padding_right
-  // and return the largest value
-  //
-  // This is useful when no cell.format.width is configured
-  // Call get_configured_width()
-  // - If this returns 0, then use get_computed_width()
-  size_t get_computed_width() {
-    size_t result{0};
-    for (size_t i = 0; i < size(); ++i) {
-      result = std::max(result, get_cell_width(i));
-    }
-    return result;
-  }
-
-  // Returns padding_left + cell_contents.size() + padding_right
-  // for a given cell in the column
-  size_t get_cell_width(size_t cell_index) {
-    size_t result{0};
-    Cell &cell = cells_[cell_index].get();
-    auto format = cell.format();
-    if (format.padding_left_.has_value())
-      result += *format.padding_left_;
-
-    // Check if input text has newlines
-    auto text = cell.get_text();
-    auto split_lines = Format::split_lines(text, "\n", cell.locale(),
-                                           cell.is_multi_byte_character_support_enabled());
-
-    // If there are no newlines in input, set column_width = text.size()
-    if (split_lines.size() == 1) {
-      result += cell.size();
-    } else {
-      // There are newlines in input
-      // Find widest substring in input and use this as column_width
-      size_t widest_sub_string_size{0};
-      for (auto &line : split_lines)
-        if (get_sequence_length(line, cell.locale(),
-                                cell.is_multi_byte_character_support_enabled()) >
-            widest_sub_string_size)
-          widest_sub_string_size = get_sequence_length(
-              line, cell.locale(), cell.is_multi_byte_character_support_enabled());
-      result += widest_sub_string_size;
-    }
-
-    if (format.padding_right_.has_value())
-      result += *format.padding_right_;
-
-    return result;
-  }
+  Format &style();
 
-  std::vector<std::reference_wrapper<Cell>> cells_;
-  std::weak_ptr<class TableInternal> parent_;
+  std::shared_ptr<class TableInternal> table_;
+  size_t index_; // position of the column in every row
 };
 
 inline ColumnFormat &ColumnFormat::width(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().width(value);
+  column_.get().style().width(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::height(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().height(value);
+  column_.get().style().height(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::padding(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().padding(value);
+  column_.get().style().padding(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::padding_left(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().padding_left(value);
+  column_.get().style().padding_left(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::padding_right(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().padding_right(value);
+  column_.get().style().padding_right(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::padding_top(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().padding_top(value);
+  column_.get().style().padding_top(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::padding_bottom(size_t value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().padding_bottom(value);
+  column_.get().style().padding_bottom(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border(value);
+  column_.get().style().border(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_color(value);
+  column_.get().style().border_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_background_color(value);
+  column_.get().style().border_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_left(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_left(value);
+  column_.get().style().border_left(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_left_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_left_color(value);
+  column_.get().style().border_left_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_left_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_left_background_color(value);
+  column_.get().style().border_left_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_right(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_right(value);
+  column_.get().style().border_right(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_right_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_right_color(value);
+  column_.get().style().border_right_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_right_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_right_background_color(value);
+  column_.get().style().border_right_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_top(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_top(value);
+  column_.get().style().border_top(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_top_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_top_color(value);
+  column_.get().style().border_top_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_top_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_top_background_color(value);
+  column_.get().style().border_top_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_bottom(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_bottom(value);
+  column_.get().style().border_bottom(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_bottom_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_bottom_color(value);
+  column_.get().style().border_bottom_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::border_bottom_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().border_bottom_background_color(value);
+  column_.get().style().border_bottom_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::corner(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().corner(value);
+  column_.get().style().corner(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::corner_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().corner_color(value);
+  column_.get().style().corner_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::corner_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().corner_background_color(value);
+  column_.get().style().corner_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::column_separator(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().column_separator(value);
+  column_.get().style().column_separator(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::column_separator_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().column_separator_color(value);
+  column_.get().style().column_separator_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::column_separator_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().column_separator_background_color(value);
+  column_.get().style().column_separator_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::font_align(FontAlign value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().font_align(value);
+  column_.get().style().font_align(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::font_style(const std::vector<FontStyle> &style) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().font_style(style);
+  column_.get().style().font_style(style);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::font_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().font_color(value);
+  column_.get().style().font_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::font_background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().font_background_color(value);
+  column_.get().style().font_background_color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().color(value);
+  column_.get().style().color(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::background_color(Color value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().background_color(value);
+  column_.get().style().background_color(value);
+  return *this;
+}
+
+inline ColumnFormat &ColumnFormat::overflow(Overflow value) {
+  column_.get().style().overflow(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::multi_byte_characters(bool value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().multi_byte_characters(value);
+  column_.get().style().multi_byte_characters(value);
   return *this;
 }
 
 inline ColumnFormat &ColumnFormat::locale(const std::string &value) {
-  for (auto &cell : column_.get().cells_)
-    cell.get().format().locale(value);
+  column_.get().style().locale(value);
   return *this;
 }
 
@@ -6268,177 +6601,155 @@ SOFTWARE.
 #pragma once
 // #include <tabulate/color.hpp>
 // #include <tabulate/font_style.hpp>
+// #include <tabulate/layout.hpp>
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace tabulate {
 
-class Printer {
+// Tracks the colors and font styles last written to a rendered table so that
+// escape sequences are only emitted when the style of the printed text changes.
+// Nothing is emitted for streams that are not colorized, e.g., files and pipes,
+// nor for tables rendered into a string
+class StyleState {
 public:
-  static std::pair<std::vector<size_t>, std::vector<size_t>>
-  compute_cell_dimensions(TableInternal &table);
+  // Styles the text rendered into buffer before it is written to stream
+  StyleState(std::string &buffer, std::ostream &stream)
+      : buffer_(buffer), stream_(&stream),
+        colorized_(termcolor::_internal::is_colorized(stream)) {}
 
-  static void print_table(std::ostream &stream, TableInternal &table);
+  explicit StyleState(std::string &buffer) : buffer_(buffer), stream_(nullptr), colorized_(false) {}
 
-  static void print_row_in_cell(std::ostream &stream, TableInternal &table,
-                                const std::pair<size_t, size_t> &index,
-                                const std::pair<size_t, size_t> &dimension, size_t num_columns,
-                                size_t row_index);
+  // Styles the text rendered into another buffer for the same stream as
+  // other, starting from the default style, see can_fork()
+  StyleState(std::string &buffer, const StyleState &other)
+      : buffer_(buffer), stream_(other.stream_), colorized_(other.colorized_) {}
 
-  static bool print_cell_border_top(std::ostream &stream, TableInternal &table,
-                                    const std::pair<size_t, size_t> &index,
-                                    const std::pair<size_t, size_t> &dimension, size_t num_columns);
-  static bool print_cell_border_bottom(std::ostream &stream, TableInternal &table,
-                                       const std::pair<size_t, size_t> &index,
-                                       const std::pair<size_t, size_t> &dimension,
-                                       size_t num_columns);
+  // Whether colors and font styles are rendered at all
+  bool colorized() const { return colorized_; }
 
-  static void apply_element_style(std::ostream &stream, Color foreground_color,
-                                  Color background_color,
-                                  const std::vector<FontStyle> &font_style) {
-    apply_foreground_color(stream, foreground_color);
-    apply_background_color(stream, background_color);
-    for (auto &style : font_style)
-      apply_font_style(stream, style);
+  // Whether parts of a table can be styled into separate buffers and
+  // concatenated afterwards, which is not the case where colors are set
+  // through the console API as the buffer is written
+  bool can_fork() const {
+#if defined(_WIN32) || defined(_WIN64)
+    return !colorized_;
+#else
+    return true;
+#endif
   }
 
-  static void reset_element_style(std::ostream &stream) { stream << termcolor::reset; }
-
-private:
-  static void print_content_left_aligned(std::ostream &stream, const std::string &cell_content,
-                                         const Format &format, size_t text_with_padding_size,
-                                         size_t column_width) {
+  // font_styles is a bitmask of font_style_bit values
+  void apply(Color foreground_color, Color background_color, unsigned font_styles) {
+    if (!colorized_)
+      return;
 
-    // Apply font style
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                        *format.font_style_);
-    stream << cell_content;
-    // Only apply font_style to the font
-    // Not the padding. So calling apply_element_style with font_style = {}
-    reset_element_style(stream);
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
+    // Colors and font styles can only be switched off all at once
+    if ((font_styles_ & ~font_styles) != 0 ||
+        (foreground_color == Color::none && foreground_color_ != Color::none) ||
+        (background_color == Color::none && background_color_ != Color::none))
+      reset();
 
-    if (text_with_padding_size < column_width) {
-      for (size_t j = 0; j < (column_width - text_with_padding_size); ++j) {
-        stream << " ";
-      }
+    if (foreground_color != foreground_color_)
+      apply_foreground_color(foreground_color);
+    if (background_color != background_color_)
+      apply_background_color(background_color);
+    for (auto style : {FontStyle::bold, FontStyle::dark, FontStyle::italic, FontStyle::underline,
+                       FontStyle::blink, FontStyle::reverse, FontStyle::concealed,
+                       FontStyle::crossed}) {
+      if ((font_styles & ~font_styles_ & font_style_bit(style)) != 0)
+        apply_font_style(style);
     }
-  }
-
-  static void print_content_center_aligned(std::ostream &stream, const std::string &cell_content,
-                                           const Format &format, size_t text_with_padding_size,
-                                           size_t column_width) {
-    auto num_spaces = column_width - text_with_padding_size;
-    if (num_spaces % 2 == 0) {
-      // Even spacing on either side
-      for (size_t j = 0; j < num_spaces / 2; ++j)
-        stream << " ";
-
-      // Apply font style
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                          *format.font_style_);
-      stream << cell_content;
-      // Only apply font_style to the font
-      // Not the padding. So calling apply_element_style with font_style = {}
-      reset_element_style(stream);
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-
-      for (size_t j = 0; j < num_spaces / 2; ++j)
-        stream << " ";
-    } else {
-      auto num_spaces_before = num_spaces / 2 + 1;
-      for (size_t j = 0; j < num_spaces_before; ++j)
-        stream << " ";
-
-      // Apply font style
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                          *format.font_style_);
-      stream << cell_content;
-      // Only apply font_style to the font
-      // Not the padding. So calling apply_element_style with font_style = {}
-      reset_element_style(stream);
-      apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
 
-      for (size_t j = 0; j < num_spaces - num_spaces_before; ++j)
-        stream << " ";
-    }
+    foreground_color_ = foreground_color;
+    background_color_ = background_color;
+    font_styles_ = font_styles;
   }
 
-  static void print_content_right_aligned(std::ostream &stream, const std::string &cell_content,
-                                          const Format &format, size_t text_with_padding_size,
-                                          size_t column_width) {
-    if (text_with_padding_size < column_width) {
-      for (size_t j = 0; j < (column_width - text_with_padding_size); ++j) {
-        stream << " ";
-      }
-    }
+  // Returns the text to its default style, if anything was applied
+  void reset() {
+    if (foreground_color_ == Color::none && background_color_ == Color::none &&
+        font_styles_ == 0)
+      return;
+    emit("\033[00m", termcolor::reset);
+    foreground_color_ = Color::none;
+    background_color_ = Color::none;
+    font_styles_ = 0;
+  }
 
-    // Apply font style
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_,
-                        *format.font_style_);
-    stream << cell_content;
-    // Only apply font_style to the font
-    // Not the padding. So calling apply_element_style with font_style = {}
-    reset_element_style(stream);
-    apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
+private:
+  void emit(const char *sequence, std::ostream &(*manipulator)(std::ostream &)) {
+#if defined(_WIN32) || defined(_WIN64)
+    // The console colors are changed through the console API and not with
+    // escape sequences, so the text rendered so far has to be written first
+    (void)sequence;
+    stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+    *stream_ << manipulator;
+#else
+    (void)manipulator;
+    buffer_ += sequence;
+#endif
   }
 
-  static void apply_font_style(std::ostream &stream, FontStyle style) {
+  void apply_font_style(FontStyle style) {
     switch (style) {
     case FontStyle::bold:
-      stream << termcolor::bold;
+      emit("\033[1m", termcolor::bold);
       break;
     case FontStyle::dark:
-      stream << termcolor::dark;
+      emit("\033[2m", termcolor::dark);
       break;
     case FontStyle::italic:
-      stream << termcolor::italic;
+      emit("\033[3m", termcolor::italic);
       break;
     case FontStyle::underline:
-      stream << termcolor::underline;
+      emit("\033[4m", termcolor::underline);
       break;
     case FontStyle::blink:
-      stream << termcolor::blink;
+      emit("\033[5m", termcolor::blink);
       break;
     case FontStyle::reverse:
-      stream << termcolor::reverse;
+      emit("\033[7m", termcolor::reverse);
       break;
     case FontStyle::concealed:
-      stream << termcolor::concealed;
+      emit("\033[8m", termcolor::concealed);
       break;
     case FontStyle::crossed:
-      stream << termcolor::crossed;
+      emit("\033[9m", termcolor::crossed);
       break;
     default:
       break;
     }
   }
 
-  static void apply_foreground_color(std::ostream &stream, Color foreground_color) {
+  void apply_foreground_color(Color foreground_color) {
     switch (foreground_color) {
     case Color::grey:
-      stream << termcolor::grey;
+      emit("\033[30m", termcolor::grey);
       break;
     case Color::red:
-      stream << termcolor::red;
+      emit("\033[31m", termcolor::red);
       break;
     case Color::green:
-      stream << termcolor::green;
+      emit("\033[32m", termcolor::green);
       break;
     case Color::yellow:
-      stream << termcolor::yellow;
+      emit("\033[33m", termcolor::yellow);
       break;
     case Color::blue:
-      stream << termcolor::blue;
+      emit("\033[34m", termcolor::blue);
       break;
     case Color::magenta:
-      stream << termcolor::magenta;
+      emit("\033[35m", termcolor::magenta);
       break;
     case Color::cyan:
-      stream << termcolor::cyan;
+      emit("\033[36m", termcolor::cyan);
       break;
     case Color::white:
-      stream << termcolor::white;
+      emit("\033[37m", termcolor::white);
       break;
     case Color::none:
     default:
@@ -6446,77 +6757,467 @@ private:
     }
   }
 
-  static void apply_background_color(std::ostream &stream, Color background_color) {
+  void apply_background_color(Color background_color) {
     switch (background_color) {
     case Color::grey:
-      stream << termcolor::on_grey;
+      emit("\033[40m", termcolor::on_grey);
       break;
     case Color::red:
-      stream << termcolor::on_red;
+      emit("\033[41m", termcolor::on_red);
       break;
     case Color::green:
-      stream << termcolor::on_green;
+      emit("\033[42m", termcolor::on_green);
       break;
     case Color::yellow:
-      stream << termcolor::on_yellow;
+      emit("\033[43m", termcolor::on_yellow);
       break;
     case Color::blue:
-      stream << termcolor::on_blue;
+      emit("\033[44m", termcolor::on_blue);
       break;
     case Color::magenta:
-      stream << termcolor::on_magenta;
+      emit("\033[45m", termcolor::on_magenta);
       break;
     case Color::cyan:
-      stream << termcolor::on_cyan;
+      emit("\033[46m", termcolor::on_cyan);
       break;
     case Color::white:
-      stream << termcolor::on_white;
+      emit("\033[47m", termcolor::on_white);
       break;
     case Color::none:
     default:
       break;
     }
   }
+
+  std::string &buffer_;
+  std::ostream *stream_;
+  bool colorized_;
+  Color foreground_color_{Color::none};
+  Color background_color_{Color::none};
+  unsigned font_styles_{0};
 };
 
-} // namespace tabulate
+// Top borders of the rows printed so far within one layout of a table
+// Rows whose cells resolve to the same formats have the same top border: it
+// is rendered for the first of them and copied for the others
+class BorderLines {
+public:
+  void clear() { lines_.clear(); }
 
-/*
-  __        ___.         .__          __
-_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
-\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
- |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
- |__| (____  /___  /____/|____(____  /__|  \___  >
-           \/    \/                \/          \/
-Table Maker for Modern C++
-https://github.com/p-ranav/tabulate
+private:
+  friend class Printer;
 
-Licensed under the MIT License <http://opensource.org/licenses/MIT>.
-SPDX-License-Identifier: MIT
-Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+  struct Line {
+    std::vector<uint32_t> formats; // resolved format of each cell of the row
+    std::string text;              // rendered top border, reset and newline included
+  };
 
-Permission is hereby  granted, free of charge, to any  person obtaining a copy
-of this software and associated  documentation files (the "Software"), to deal
-in the Software  without restriction, including without  limitation the rights
-to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
-copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
-furnished to do so, subject to the following conditions:
+  // Rows with more distinct formats than this render their top border
+  static const size_t max_lines = 8;
 
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
+  std::vector<Line> lines_;
+};
 
-THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
-IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
-FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
-AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
-LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-*/
+class Printer {
+public:
+  // Measures, word wraps and sizes every cell of the table exactly once
+  static TableLayout compute_layout(const TableInternal &table);
+
+  // Lays out the table for the given column widths instead of measuring its
+  // columns, columns past the end of column_widths are still measured
+  static TableLayout compute_layout(const TableInternal &table,
+                                    const std::vector<size_t> &column_widths);
+
+  // Measures the cells of a row of layout, then raises configured_widths and
+  // computed_widths to the widths its cells are given and need
+  static void measure_row(const TableInternal &table, TableLayout &layout, size_t row,
+                          std::vector<size_t> &configured_widths,
+                          std::vector<size_t> &computed_widths);
+
+  // Word wraps the measured cells of a row for the column widths of layout
+  // and works out the height of the row
+  static void wrap_row(const TableInternal &table, TableLayout &layout, size_t row);
+
+  // Column widths and row heights of the table, the same as compute_layout()
+  // works out, with no cells laid out: rows are laid out batch_rows at a
+  // time and dropped, see layout_rows()
+  static TableLayout compute_dimensions(const TableInternal &table, size_t batch_rows = 1024);
+
+  // Lays out the cells of the rows [first, last) of the table for the column
+  // widths of layout, in place of the cells layout had
+  static void layout_rows(const TableInternal &table, TableLayout &layout, size_t first,
+                          size_t last);
+
+  static std::pair<std::vector<size_t>, std::vector<size_t>>
+  compute_cell_dimensions(const TableInternal &table);
+
+  // Display width of the first line and number of lines of the rendered
+  // table, worked out from its layout without rendering it, the lines being
+  // separated by '\n'
+  static std::pair<size_t, size_t> compute_shape(const TableInternal &table);
+
+  // Index of the line of the rendered table on which each row starts, its
+  // top border included, followed by the number of lines of the table
+  // The last row also spans the bottom border of the table
+  static std::vector<size_t> compute_line_offsets(const TableInternal &table,
+                                                  const TableLayout &layout);
+
+  // Display width of each line of the rendered table, an empty last line
+  // included, e.g., below a hidden bottom border
+  static std::vector<size_t> compute_line_widths(const TableInternal &table,
+                                                 const TableLayout &layout);
+
+  // Renders the whole table into one buffer and writes it to stream at once
+  static void print_table(std::ostream &stream, const TableInternal &table);
+
+  // Appends the rendered table, without colors, to buffer
+  static void print_table(std::string &buffer, const TableInternal &table);
+
+  // Appends the rendered table to buffer, styled through style
+  static void print_table(std::string &buffer, StyleState &style, const TableInternal &table);
+
+  // Same as print_table() for a table caching its rows: only the rows changed
+  // since the last print are measured, and rendered again along with the
+  // last row, the others are copied as they were rendered
+  // Every row is rendered again when the column widths change
+  static void print_cached_table(std::string &buffer, StyleState &style,
+                                 const TableInternal &table);
+
+  // Prints the rows [first, last) of the table, each but the first row of the
+  // table preceded by a newline, then the bottom border of the table if last
+  // is its number of rows, and leaves style reset
+  static void print_rows(std::string &buffer, StyleState &style, const TableInternal &table,
+                         const TableLayout &layout, size_t first, size_t last);
+
+  // Prints the top border and the word-wrapped lines of a row of the table
+  // The lines are separated by '\n', there is none after the last line
+  // The row has to start a line, in the default style. Given borders, which
+  // must only be used with layout, top borders are copied from earlier rows
+  static void print_row(std::string &buffer, StyleState &style, const TableInternal &table,
+                        const TableLayout &layout, size_t row,
+                        BorderLines *borders = nullptr);
+
+  // Prints a single line of the rendered table, given the line offsets of
+  // its layout, without newline and leaving style reset
+  static void print_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                         const TableLayout &layout, const std::vector<size_t> &line_offsets,
+                         size_t line);
+
+  // Prints the bottom borders of the cells of a row, on a single line
+  static void print_bottom_border(std::string &buffer, StyleState &style, const TableInternal &table,
+                                  const std::vector<size_t> &column_widths, size_t row);
+
+  static void print_row_in_cell(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const CellLayout &cell_layout,
+                                const std::pair<size_t, size_t> &index,
+                                const std::pair<size_t, size_t> &dimension, size_t num_columns,
+                                size_t row_index);
+
+  static bool print_cell_border_top(std::string &buffer, StyleState &style, const TableInternal &table,
+                                    const std::pair<size_t, size_t> &index,
+                                    const std::pair<size_t, size_t> &dimension, size_t num_columns);
+  static bool print_cell_border_bottom(std::string &buffer, StyleState &style,
+                                       const TableInternal &table,
+                                       const std::pair<size_t, size_t> &index,
+                                       const std::pair<size_t, size_t> &dimension,
+                                       size_t num_columns);
+
+private:
+
+  // Display widths of what print_row_in_cell, print_cell_border_top and
+  // print_cell_border_bottom print, the border functions return false where
+  // their counterparts print nothing
+  static size_t row_in_cell_width(const Format &format, const CellLayout &cell_layout,
+                                  size_t column_width, bool last_column, size_t row_index);
+  static bool cell_border_top_width(const Format &format, size_t column_width, bool last_column,
+                                    size_t &width);
+  static bool cell_border_bottom_width(const Format &format, size_t column_width,
+                                       bool last_column, size_t &width);
+
+  // Upper bound of the size of the rendered table, escape sequences aside
+  static size_t estimate_rendered_size(const TableInternal &table, const TableLayout &layout);
+
+  // Replaces every '\t' of the text of cell_layout with spaces up to the next
+  // multiple of 8 columns of its line, so that the printed text is as wide as
+  // it was measured, tabs being as wide as the column they start at allows
+  static void expand_tabs(CellLayout &cell_layout, const Format &format);
+
+  // Splits the text of cell_layout at its embedded '\n' characters into lines,
+  // text_class has to describe the text
+  // A trailing empty line is dropped, e.g., "abc\n" is a single line
+  static void split_cell_lines(CellLayout &cell_layout, const Format &format);
+
+  // Lays out the table nested in a cell with the given column widths, or at
+  // its natural width if there are none, and gives the cell a line of that
+  // width for every line of the table
+  static void layout_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                  const std::vector<size_t> &column_widths = {});
+
+  // Lays the table nested in a cell out again, its widest columns narrowed,
+  // if it is wider than width
+  static void fit_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                               size_t width);
+
+  // Prints a line of table, nested in a cell laid out as cell_layout, aligned
+  // like text between the paddings of the cell
+  static void print_nested_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const CellLayout &cell_layout, const Format &format,
+                                size_t column_width, size_t line);
+
+  // Replaces the natural lines of cell_layout with the lines to print for the
+  // given column width, word wrapping or truncating its text if it does not
+  // fit, depending on the overflow of format
+  static void wrap_cell_lines(CellLayout &cell_layout, const Format &format,
+                              size_t column_width);
+
+  // Cuts the first line of cell_layout to width display columns and drops the
+  // other lines, the cut line ends with an ellipsis if any text is left out
+  // The text is scanned once, up to the cut
+  static void truncate_cell_lines(CellLayout &cell_layout, const Format &format, size_t width);
+
+  // Trims white spaces from both ends of a line and updates its display width
+  static LineSpan trim_line(const char *text, LineSpan line, const Format &format);
+
+  // Appends count copies of glyph, which may be a multi-byte character
+  static void append_repeated(std::string &buffer, const std::string &glyph, size_t count) {
+    if (glyph.size() == 1) {
+      buffer.append(count, glyph[0]);
+      return;
+    }
+    for (size_t i = 0; i < count; ++i)
+      buffer += glyph;
+  }
+
+  static void print_content_left_aligned(std::string &buffer, StyleState &style,
+                                         const char *text, const LineSpan &line,
+                                         const Format &format, size_t text_with_padding_size,
+                                         size_t column_width) {
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+
+    if (text_with_padding_size < column_width)
+      buffer.append(column_width - text_with_padding_size, ' ');
+  }
+
+  static void print_content_center_aligned(std::string &buffer, StyleState &style,
+                                           const char *text, const LineSpan &line,
+                                           const Format &format, size_t text_with_padding_size,
+                                           size_t column_width) {
+    // A line wider than the column, e.g. with padding wider than a fixed
+    // column width, is printed without any space around it
+    auto num_spaces =
+        text_with_padding_size < column_width ? column_width - text_with_padding_size : 0;
+    // Odd spacing puts the extra space before the text
+    auto num_spaces_before = num_spaces / 2 + num_spaces % 2;
+    buffer.append(num_spaces_before, ' ');
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+
+    buffer.append(num_spaces - num_spaces_before, ' ');
+  }
+
+  static void print_content_right_aligned(std::string &buffer, StyleState &style,
+                                          const char *text, const LineSpan &line,
+                                          const Format &format, size_t text_with_padding_size,
+                                          size_t column_width) {
+    if (text_with_padding_size < column_width)
+      buffer.append(column_width - text_with_padding_size, ' ');
+
+    // Apply font style
+    style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+    buffer.append(text + line.offset, line.length);
+    // Only apply font_style to the font
+    // Not the padding. So applying the colors with font_style = {}
+    style.apply(format.font_color_, format.font_background_color_, 0);
+  }
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
 #pragma once
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+// #include <tabulate/bands.hpp>
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#if !defined(TABULATE_DISABLE_THREADS)
+#include <system_error>
+#include <thread>
+#endif
+
+namespace tabulate {
+
+// Contiguous rows [first, last) of a table laid out or rendered by one thread
+struct RowBand {
+  size_t first;
+  size_t last;
+};
+
+// Rows per band below which a table is not worth splitting
+static const size_t min_band_rows = 4096;
+
+namespace details {
+
+inline std::atomic<size_t> &max_bands_override() {
+  static std::atomic<size_t> max_bands{0};
+  return max_bands;
+}
+
+} // namespace details
+
+// Splits tables into up to max_bands bands instead of one per core, e.g., so
+// that tests render tables in bands on single core machines too. Bands still
+// hold at least min_band_rows rows, and a max_bands of 0 goes back to one
+// band per core. With TABULATE_DISABLE_THREADS defined, bands are rendered
+// one after the other
+inline void set_max_bands(size_t max_bands) { details::max_bands_override() = max_bands; }
+
+// Splits the rows of a table into one band per core, each band holding at
+// least min_band_rows rows. Small tables, single core machines and builds
+// with TABULATE_DISABLE_THREADS defined get a single band, unless
+// set_max_bands() was called
+inline std::vector<RowBand> split_rows(size_t num_rows) {
+  size_t max_bands = details::max_bands_override();
+  if (max_bands == 0) {
+    max_bands = 1;
+#if !defined(TABULATE_DISABLE_THREADS)
+    static const size_t num_cores = std::max(1u, std::thread::hardware_concurrency());
+    max_bands = num_cores;
+#endif
+  }
+  auto num_bands = std::max<size_t>(1, std::min(max_bands, num_rows / min_band_rows));
+  std::vector<RowBand> bands;
+  bands.reserve(num_bands);
+  for (size_t i = 0; i < num_bands; ++i)
+    bands.push_back({num_rows * i / num_bands, num_rows * (i + 1) / num_bands});
+  return bands;
+}
+
+// Calls fn(band) for every band index, the first band on the calling thread
+// and every other one on a thread of its own, and returns once all are done.
+// Bands run on the calling thread too when no thread can be started. The
+// first exception thrown by fn is rethrown
+template <typename Function> void for_each_band(size_t num_bands, Function fn) {
+  std::vector<std::exception_ptr> errors(num_bands);
+  auto run = [&](size_t band) {
+    try {
+      fn(band);
+    } catch (...) {
+      errors[band] = std::current_exception();
+    }
+  };
+
+#if !defined(TABULATE_DISABLE_THREADS)
+  std::vector<std::thread> threads;
+  threads.reserve(num_bands);
+  for (size_t band = 1; band < num_bands; ++band) {
+    try {
+      threads.emplace_back(run, band);
+    } catch (const std::system_error &) {
+      run(band);
+    }
+  }
+  run(0);
+  for (auto &thread : threads)
+    thread.join();
+#else
+  for (size_t band = 0; band < num_bands; ++band)
+    run(band);
+#endif
+
+  for (auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+} // namespace tabulate
+
 // #include <tabulate/column.hpp>
 // #include <tabulate/font_style.hpp>
 // #include <tabulate/printer.hpp>
@@ -6540,392 +7241,3153 @@ public:
     return result;
   }
 
-  void add_row(const std::vector<std::string> &cells) {
-    auto row = std::make_shared<Row>(shared_from_this());
-    for (auto &c : cells) {
-      auto cell = std::make_shared<Cell>(row);
-      cell->set_text(c);
-      row->add_cell(cell);
-    }
-    rows_.push_back(row);
+  void add_row(const std::vector<std::string> &cells) { insert_row(size(), cells); }
+
+  // Adds a row with a cell for every argument, std::string or C string,
+  // whose text is copied once, straight into the storage of the table
+  template <typename... Cells> void emplace_row(const Cells &...cells) {
+    insert_row(size(), std::initializer_list<TextRef>{text_ref(cells)...});
   }
 
-  Row &operator[](size_t index) { return *(rows_[index]); }
+  // Makes room for rows rows of columns cells in total, so that adding them
+  // does not grow the storage of the table several times
+  void reserve(size_t rows, size_t columns) {
+    cell_texts_.reserve(rows * columns);
+    cell_styles_.reserve(rows * columns);
+    row_offsets_.reserve(rows + 1);
+    row_styles_.reserve(rows);
+  }
 
-  const Row &operator[](size_t index) const { return *(rows_[index]); }
+  Row &operator[](size_t index) { return rows_[index]; }
 
-  Column column(size_t index) {
-    Column column(shared_from_this());
-    for (size_t i = 0; i < rows_.size(); ++i) {
-      auto row = rows_[i];
-      auto &cell = row->cell(index);
-      column.add_cell(cell);
-    }
-    return column;
-  }
+  const Row &operator[](size_t index) const { return rows_[index]; }
+
+  Column column(size_t index) { return Column(shared_from_this(), index); }
 
   size_t size() const { return rows_.size(); }
 
-  std::pair<size_t, size_t> shape() {
-    std::pair<size_t, size_t> result{0, 0};
-    std::stringstream stream;
-    print(stream);
-    auto buffer = stream.str();
-    auto lines = Format::split_lines(buffer, "\n", "", true);
-    if (lines.size()) {
-      result = {get_sequence_length(lines[0], "", true), lines.size()};
-    }
-    return result;
-  }
+  std::pair<size_t, size_t> shape() const { return Printer::compute_shape(*this); }
 
   Format &format() { return format_; }
 
-  void print(std::ostream &stream) { Printer::print_table(stream, *this); }
-
-  size_t estimate_num_columns() const {
-    size_t result{0};
-    if (size()) {
-      auto first_row = operator[](size_t(0));
-      result = first_row.size();
+  // Keeps the measurements and the rendered lines of every row between
+  // prints, see Printer::print_cached_table()
+  void cache_rows(bool enabled) {
+    cache_rows_ = enabled;
+    cached_rows_.clear();
+    cached_column_widths_.clear();
+    cached_cells_.clear();
+    if (enabled)
+      cached_rows_.resize(size());
+  }
+
+  // Flattens the table, row, column and cell formats into one immutable record
+  // per distinct combination: cells without a format of their own share the
+  // record of their column, or of their row, or of the table
+  // Column formats take precedence over row formats, so in rows with a format
+  // of their own they are merged once per formatted column
+  // The records are reused by every print until a format is changed, which
+  // every setter of Format counts in format_generation_
+  // Prints of the same table from several threads may resolve concurrently,
+  // the first one does the work while the others wait for it
+  void resolve_formats() const {
+    auto generation = format_generation_.load(std::memory_order_acquire);
+    if (resolved_generation_.load(std::memory_order_acquire) == generation)
+      return;
+    std::lock_guard<std::mutex> lock(resolve_mutex_);
+    if (resolved_generation_.load(std::memory_order_relaxed) == generation)
+      return;
+    resolved_formats_.clear();
+    resolved_formats_.push_back(format_);
+    resolved_styles_.resize(cell_texts_.size());
+    std::vector<uint32_t> column_records(column_styles_.size(), 0);
+    for (size_t column = 0; column < column_styles_.size(); ++column) {
+      if (column_styles_[column] != no_style) {
+        resolved_formats_.push_back(
+            Format::merge(style(column_styles_[column]), resolved_formats_[0]));
+        column_records[column] = static_cast<uint32_t>(resolved_formats_.size() - 1);
+      }
     }
-    return result;
+    for (size_t i = 0; i < size(); ++i) {
+      uint32_t row_record{0};
+      if (row_styles_[i] != no_style) {
+        resolved_formats_.push_back(Format::merge(style(row_styles_[i]), resolved_formats_[0]));
+        row_record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+      }
+      for (size_t cell = row_offsets_[i]; cell < row_offsets_[i + 1]; ++cell) {
+        auto column = cell - row_offsets_[i];
+        uint32_t record{row_record};
+        if (column < column_styles_.size() && column_styles_[column] != no_style) {
+          if (row_record == 0) {
+            record = column_records[column];
+          } else {
+            resolved_formats_.push_back(
+                Format::merge(style(column_styles_[column]), resolved_formats_[row_record]));
+            record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+          }
+        }
+        if (cell_styles_[cell] != no_style) {
+          resolved_formats_.push_back(
+              Format::merge(style(cell_styles_[cell]), resolved_formats_[record]));
+          record = static_cast<uint32_t>(resolved_formats_.size() - 1);
+        }
+        resolved_styles_[cell] = record;
+      }
+    }
+    resolved_generation_.store(generation, std::memory_order_release);
+  }
+
+  void invalidate_formats() { format_generation_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Whether a format the cells of the row are printed with, the format of the
+  // table, of the row, of its columns or of its cells, was changed after
+  // generation of format_generation_
+  bool row_formats_changed(size_t row, uint64_t generation) const {
+    if (format_.owner_.last_change() > generation ||
+        style_or_empty(row_styles_[row]).owner_.last_change() > generation)
+      return true;
+    for (size_t cell = row_offsets_[row]; cell < row_offsets_[row + 1]; ++cell) {
+      auto column = cell - row_offsets_[row];
+      if (style_or_empty(cell_styles_[cell]).owner_.last_change() > generation ||
+          (column < column_styles_.size() &&
+           style_or_empty(column_styles_[column]).owner_.last_change() > generation))
+        return true;
+    }
+    return false;
   }
 
+  void print(std::ostream &stream) const { Printer::print_table(stream, *this); }
+
+  // Appends the rendered table to buffer
+  void print(std::string &buffer) const { Printer::print_table(buffer, *this); }
+
+  size_t estimate_num_columns() const { return size() ? row_size(0) : 0; }
+
 private:
+  friend class Cell;
+  friend class Row;
+  friend class Column;
+  friend class Printer;
   friend class Table;
+  friend class TableStream;
   friend class MarkdownExporter;
+  friend class CsvExporter;
+  friend class TsvExporter;
+  friend class JsonExporter;
+  friend class Viewport;
 
-  TableInternal() {}
+  TableInternal() { format_.owner_.attach(&format_generation_); }
   TableInternal &operator=(const TableInternal &);
   TableInternal(const TableInternal &);
 
-  std::vector<std::shared_ptr<Row>> rows_;
-  Format format_;
-};
+  // Where the text of a cell is stored in text_
+  struct TextSpan {
+    size_t offset;
+    size_t length;
+  };
 
-inline Format &Cell::format() {
-  std::shared_ptr<Row> parent = parent_.lock();
-  if (!format_.has_value()) {   // no cell format
-    format_ = parent->format(); // Use parent row format
-  } else {
-    // Cell has formatting
-    // Merge cell formatting with parent row formatting
-    format_ = Format::merge(*format_, parent->format());
-  }
-  return *format_;
-}
+  // Text of a cell to be added, referenced without being copied
+  struct TextRef {
+    const char *data;
+    size_t size;
+  };
 
-inline bool Cell::is_multi_byte_character_support_enabled() {
-  return (*format().multi_byte_characters_);
-}
+  static TextRef text_ref(const std::string &text) { return {text.data(), text.size()}; }
 
-inline Format &Row::format() {
-  std::shared_ptr<TableInternal> parent = parent_.lock();
-  if (!format_.has_value()) {   // no row format
-    format_ = parent->format(); // Use parent table format
-  } else {
-    // Row has formatting rules
-    // Merge with parent table format
-    format_ = Format::merge(*format_, parent->format());
-  }
-  return *format_;
-}
+  static TextRef text_ref(const char *text) { return {text, std::strlen(text)}; }
 
-inline std::pair<std::vector<size_t>, std::vector<size_t>>
-Printer::compute_cell_dimensions(TableInternal &table) {
-  std::pair<std::vector<size_t>, std::vector<size_t>> result;
-  size_t num_rows = table.size();
-  size_t num_columns = table.estimate_num_columns();
+  static TextRef text_ref(const TextRef &text) { return text; }
 
-  std::vector<size_t> row_heights, column_widths{};
+  // Style id of rows and cells without a format of their own
+  enum : uint32_t { no_style = 0 };
 
-  for (size_t i = 0; i < num_columns; ++i) {
-    Column column = table.column(i);
-    size_t configured_width = column.get_configured_width();
-    size_t computed_width = column.get_computed_width();
-    if (configured_width != 0)
-      column_widths.push_back(configured_width);
-    else
-      column_widths.push_back(computed_width);
+  // What the last print measured and rendered of a row, dropped when the row
+  // changes, see Printer::print_cached_table()
+  struct CachedRow {
+    bool measured{false};
+    bool rendered{false};
+    uint64_t generation{0}; // of format_generation_ when the row was measured
+    std::vector<size_t> configured_widths; // widths the row needs, see measure_row()
+    std::vector<size_t> computed_widths;
+    std::string text; // top border and lines of the row, ending in the default style
+  };
+
+  // Copy of the table with rows and cells of its own, nested tables are shared
+  std::shared_ptr<TableInternal> clone() const {
+    auto result = std::shared_ptr<TableInternal>(new TableInternal());
+    result->format_ = format_;
+    result->text_ = text_;
+    result->text_garbage_ = text_garbage_;
+    result->cell_texts_ = cell_texts_;
+    result->cell_styles_ = cell_styles_;
+    result->cell_tables_ = cell_tables_;
+    result->row_offsets_ = row_offsets_;
+    result->row_styles_ = row_styles_;
+    result->column_styles_ = column_styles_;
+    result->styles_ = styles_;
+    for (auto &style : result->styles_)
+      style.owner_.attach(&result->format_generation_);
+    result->free_styles_ = free_styles_;
+    for (size_t i = 0; i < rows_.size(); ++i)
+      result->rows_.emplace_back(*result, i);
+    for (size_t i = 0; i < cells_.size(); ++i)
+      result->cells_.emplace_back(*result, i);
+    return result;
   }
 
-  for (size_t i = 0; i < num_rows; ++i) {
-    Row row = table[i];
-    size_t configured_height = row.get_configured_height();
-    size_t computed_height = row.get_computed_height(column_widths);
+  // Inserts a row before the row at the given position, with a cell for every
+  // text of cells, std::string, C string or TextRef, then empty cells up to
+  // min_cells
+  template <typename Cells>
+  void insert_row(size_t index, const Cells &cells, size_t min_cells = 0) {
+    auto first = row_offsets_[index];
+    auto end = cell_texts_.size();
+
+    // Spans are appended, then rotated in place before the cells of the row at
+    // index, which leaves them in place when the row is added last
+    for (auto &cell : cells) {
+      auto text = text_ref(cell);
+      cell_texts_.push_back({text_.size(), text.size});
+      text_.append(text.data, text.size);
+    }
+    if (cell_texts_.size() - end < min_cells)
+      cell_texts_.resize(end + min_cells, TextSpan{text_.size(), 0});
+    auto count = cell_texts_.size() - end;
+    std::rotate(cell_texts_.begin() + first, cell_texts_.begin() + end, cell_texts_.end());
+    cell_styles_.insert(cell_styles_.begin() + first, count, no_style);
+    if (!cell_tables_.empty())
+      cell_tables_.insert(cell_tables_.begin() + first, count, nullptr);
+
+    row_offsets_.insert(row_offsets_.begin() + index, first);
+    for (size_t i = index + 1; i < row_offsets_.size(); ++i)
+      row_offsets_[i] += count;
+    row_styles_.insert(row_styles_.begin() + index, no_style);
+    if (cache_rows_)
+      cached_rows_.insert(cached_rows_.begin() + index, CachedRow());
+
+    // Views are positional, there is one for every row and every cell
+    rows_.emplace_back(*this, rows_.size());
+    for (size_t i = 0; i < count; ++i)
+      cells_.emplace_back(*this, cells_.size());
+    invalidate_formats();
+  }
+
+  // Removes the rows in [first, last)
+  void erase_rows(size_t first, size_t last) {
+    if (first >= last)
+      return;
+    auto first_cell = row_offsets_[first], last_cell = row_offsets_[last];
+    auto count = last_cell - first_cell;
+
+    for (auto cell = first_cell; cell < last_cell; ++cell) {
+      text_garbage_ += cell_texts_[cell].length;
+      release_style(cell_styles_[cell]);
+    }
+    cell_texts_.erase(cell_texts_.begin() + first_cell, cell_texts_.begin() + last_cell);
+    cell_styles_.erase(cell_styles_.begin() + first_cell, cell_styles_.begin() + last_cell);
+    if (!cell_tables_.empty())
+      cell_tables_.erase(cell_tables_.begin() + first_cell, cell_tables_.begin() + last_cell);
+
+    for (auto row = first; row < last; ++row)
+      release_style(row_styles_[row]);
+    row_offsets_.erase(row_offsets_.begin() + first, row_offsets_.begin() + last);
+    for (size_t i = first; i < row_offsets_.size(); ++i)
+      row_offsets_[i] -= count;
+    row_styles_.erase(row_styles_.begin() + first, row_styles_.begin() + last);
+    if (cache_rows_)
+      cached_rows_.erase(cached_rows_.begin() + first, cached_rows_.begin() + last);
+
+    rows_.erase(rows_.end() - (last - first), rows_.end());
+    cells_.erase(cells_.end() - count, cells_.end());
+    compact_text();
+    invalidate_formats();
+  }
+
+  size_t row_size(size_t row) const { return row_offsets_[row + 1] - row_offsets_[row]; }
+
+  size_t cell_index(size_t row, size_t column) const { return row_offsets_[row] + column; }
+
+  // Row holding a cell, the last of the rows starting at it if some are empty
+  size_t row_of_cell(size_t cell) const {
+    return static_cast<size_t>(std::upper_bound(row_offsets_.begin(), row_offsets_.end(), cell) -
+                               row_offsets_.begin()) -
+           1;
+  }
+
+  // Whether a table is nested in one of the cells of a row
+  bool row_has_tables(size_t row) const {
+    for (auto cell = row_offsets_[row]; cell < row_offsets_[row + 1]; ++cell) {
+      if (cell_table(cell))
+        return true;
+    }
+    return false;
+  }
 
-    // NOTE: Unlike column width, row height is calculated as the max
-    // b/w configured height and computed height
-    // which means that .width() has higher precedence than .height()
-    // when both are configured by the user
-    //
-    // TODO: Maybe this can be configured?
-    // If such a configuration is exposed, i.e., prefer height over width
-    // then the logic will be reversed, i.e.,
-    // column_widths.push_back(std::max(configured_width, computed_width))
-    // and
-    // row_height = configured_height if != 0 else computed_height
+  // Drops what the last print kept of a row, or of every row
+  void invalidate_cached_row(size_t row) {
+    if (row < cached_rows_.size())
+      cached_rows_[row] = CachedRow();
+  }
 
-    row_heights.push_back(std::max(configured_height, computed_height));
+  void invalidate_cached_rows() {
+    for (auto &cached : cached_rows_)
+      cached = CachedRow();
   }
 
-  result.first = row_heights;
-  result.second = column_widths;
+  std::string cell_text(size_t cell) const {
+    if (auto nested = cell_table(cell)) {
+      std::string text;
+      nested->print(text);
+      return text;
+    }
+    return text_.substr(cell_texts_[cell].offset, cell_texts_[cell].length);
+  }
 
-  return result;
-}
+  // Calls fn(data, size) with the text of a cell, only the text of a nested
+  // table is rendered into a temporary string
+  template <typename Function> void visit_cell_text(size_t cell, Function fn) const {
+    if (auto nested = cell_table(cell)) {
+      std::string text;
+      nested->print(text);
+      fn(text.data(), text.size());
+    } else {
+      fn(text_.data() + cell_texts_[cell].offset, cell_texts_[cell].length);
+    }
+  }
 
-inline void Printer::print_table(std::ostream &stream, TableInternal &table) {
-  size_t num_rows = table.size();
-  size_t num_columns = table.estimate_num_columns();
-  auto dimensions = compute_cell_dimensions(table);
-  auto row_heights = dimensions.first;
-  auto column_widths = dimensions.second;
+  // Table nested in a cell, nullptr for a cell holding text
+  TableInternal *cell_table(size_t cell) const {
+    return cell < cell_tables_.size() ? cell_tables_[cell].get() : nullptr;
+  }
 
-  // For each row,
-  for (size_t i = 0; i < num_rows; ++i) {
+  // Nests table in an empty cell, it is laid out and rendered along with this
+  // table, so later changes to it show up in the next print
+  void set_cell_table(size_t cell, std::shared_ptr<TableInternal> table) {
+    if (cell_tables_.empty())
+      cell_tables_.resize(cell_texts_.size());
+    cell_tables_[cell] = std::move(table);
+    invalidate_cached_row(row_of_cell(cell));
+  }
 
-    // Print top border
-    bool border_top_printed{true};
-    for (size_t j = 0; j < num_columns; ++j) {
-      border_top_printed &= print_cell_border_top(stream, table, {i, j},
-                                                  {row_heights[i], column_widths[j]}, num_columns);
+  void set_cell_text(size_t cell, const std::string &text) {
+    if (!cell_tables_.empty())
+      cell_tables_[cell].reset();
+    auto &span = cell_texts_[cell];
+    if (text.size() <= span.length) {
+      // Overwrite in place, the tail of the old text is left unused
+      text_.replace(span.offset, text.size(), text);
+      text_garbage_ += span.length - text.size();
+    } else {
+      text_garbage_ += span.length;
+      span.offset = text_.size();
+      text_ += text;
     }
-    if (border_top_printed)
-      stream << termcolor::reset << "\n";
+    span.length = text.size();
+    compact_text();
+    invalidate_cached_row(row_of_cell(cell));
+  }
 
-    // Print row contents with word wrapping
-    for (size_t k = 0; k < row_heights[i]; ++k) {
-      for (size_t j = 0; j < num_columns; ++j) {
-        print_row_in_cell(stream, table, {i, j}, {row_heights[i], column_widths[j]}, num_columns,
-                          k);
+  // Drops the unused text of erased cells and replaced texts once it takes
+  // more room than the text in use
+  void compact_text() {
+    if (text_garbage_ <= text_.size() / 2)
+      return;
+    std::string text;
+    text.reserve(text_.size() - text_garbage_);
+    for (auto &span : cell_texts_) {
+      auto offset = text.size();
+      text.append(text_, span.offset, span.length);
+      span.offset = offset;
+    }
+    text_.swap(text);
+    text_garbage_ = 0;
+  }
+
+  // Format of a row or a cell, created on first use
+  Format &style_of(uint32_t &id) {
+    if (id == no_style) {
+      if (!free_styles_.empty()) {
+        id = free_styles_.back();
+        free_styles_.pop_back();
+      } else {
+        styles_.emplace_back();
+        styles_.back().owner_.attach(&format_generation_);
+        id = static_cast<uint32_t>(styles_.size());
       }
-      if (k + 1 < row_heights[i])
-        stream << termcolor::reset << "\n";
+      invalidate_formats();
     }
+    return style(id);
+  }
 
-    if (i + 1 == num_rows) {
+  // Format of a column, created on first use
+  Format &column_style(size_t column) {
+    if (column >= column_styles_.size())
+      column_styles_.resize(column + 1, no_style);
+    return style_of(column_styles_[column]);
+  }
 
-      // Check if there is bottom border to print:
-      auto bottom_border_needed{true};
-      for (size_t j = 0; j < num_columns; ++j) {
-        auto cell = table[i][j];
-        auto format = cell.format();
-        auto corner = *format.corner_bottom_left_;
-        auto border_bottom = *format.border_bottom_;
-        if (corner == "" && border_bottom == "") {
-          bottom_border_needed = false;
-          break;
-        }
-      }
+  Format &style(uint32_t id) { return styles_[id - 1]; }
 
-      if (bottom_border_needed)
-        stream << termcolor::reset << "\n";
-      // Print bottom border for table
-      for (size_t j = 0; j < num_columns; ++j) {
-        print_cell_border_bottom(stream, table, {i, j}, {row_heights[i], column_widths[j]},
-                                 num_columns);
+  const Format &style(uint32_t id) const { return styles_[id - 1]; }
+
+  // Format of a row or a cell, without creating it if there is none
+  const Format &style_or_empty(uint32_t id) const {
+    static const Format empty;
+    return id == no_style ? empty : style(id);
+  }
+
+  void release_style(uint32_t id) {
+    if (id == no_style)
+      return;
+    style(id) = Format();
+    free_styles_.push_back(id);
+  }
+
+  // Effective format of the cell, valid after resolve_formats()
+  const Format &resolved_format(size_t row, size_t column) const {
+    return resolved_formats_[resolved_styles_[cell_index(row, column)]];
+  }
+
+  Format format_;
+
+  // Cells of every row, stored row after row as parallel arrays
+  std::string text_;                  // text of every cell, back to back
+  size_t text_garbage_{0};            // bytes of text_ no longer used by any cell
+  std::vector<TextSpan> cell_texts_;  // text of each cell in text_
+  std::vector<uint32_t> cell_styles_; // style id of each cell
+  std::vector<std::shared_ptr<TableInternal>> cell_tables_; // empty until a table is nested
+
+  std::vector<size_t> row_offsets_{0}; // first cell of each row, then the number of cells
+  std::vector<uint32_t> row_styles_;   // style id of each row
+
+  // Style id of each column, up to the last formatted one
+  std::vector<uint32_t> column_styles_;
+
+  // Row, column and cell formats, style id i is styles_[i - 1]
+  std::deque<Format> styles_;
+  std::vector<uint32_t> free_styles_; // ids released by erased rows and cells
+
+  // Flattened formats, see resolve_formats()
+  mutable std::vector<Format> resolved_formats_;
+  mutable std::vector<uint32_t> resolved_styles_; // index in resolved_formats_ of each cell
+  // Changes of the formats and of the cells they apply to, counted up by the
+  // setters of the formats of the table and by invalidate_formats()
+  std::atomic<uint64_t> format_generation_{1};
+  mutable std::atomic<uint64_t> resolved_generation_{0}; // of the resolved formats
+  mutable std::mutex resolve_mutex_;
+
+  // Rows kept between prints, one for every row while cache_rows_ is set
+  bool cache_rows_{false};
+  mutable std::vector<CachedRow> cached_rows_;
+  mutable std::vector<size_t> cached_column_widths_; // widths the rows are rendered for
+  mutable bool cached_colorized_{false};
+  mutable std::vector<CellLayout> cached_cells_; // empty, reused by every print
+  mutable std::mutex cache_mutex_;
+
+  // Views returned by operator[] and Row::cell(), i-th view on i-th row or cell
+  std::deque<Row> rows_;
+  std::deque<Cell> cells_;
+};
+
+inline void Cell::set_text(const std::string &text) { table_->set_cell_text(index_, text); }
+
+inline std::string Cell::get_text() const { return table_->cell_text(index_); }
+
+inline Format &Cell::format() {
+  return table_->style_of(table_->cell_styles_[index_]);
+}
+
+inline const Format &Cell::format() const {
+  return table_->style_or_empty(table_->cell_styles_[index_]);
+}
+
+inline const Format &Cell::resolved_format() const {
+  table_->resolve_formats();
+  return table_->resolved_formats_[table_->resolved_styles_[index_]];
+}
+
+inline bool Cell::is_multi_byte_character_support_enabled() const {
+  return resolved_format().multi_byte_characters_;
+}
+
+inline Cell &Row::cell(size_t index) {
+  return table_->cells_[table_->cell_index(index_, index)];
+}
+
+inline const Cell &Row::cell(size_t index) const {
+  return table_->cells_[table_->cell_index(index_, index)];
+}
+
+inline size_t Row::size() const { return table_->row_size(index_); }
+
+inline Format &Row::format() {
+  return table_->style_of(table_->row_styles_[index_]);
+}
+
+inline const Format &Row::format() const {
+  return table_->style_or_empty(table_->row_styles_[index_]);
+}
+
+inline Row::CellIterator Row::begin() {
+  return CellIterator(table_->cells_.begin() + table_->row_offsets_[index_]);
+}
+
+inline Row::CellIterator Row::end() {
+  return CellIterator(table_->cells_.begin() + table_->row_offsets_[index_ + 1]);
+}
+
+inline Cell &Column::operator[](size_t index) { return (*table_)[index][index_]; }
+
+inline size_t Column::size() const { return table_->size(); }
+
+inline Format &Column::style() { return table_->column_style(index_); }
+
+inline TableLayout Printer::compute_layout(const TableInternal &table) {
+  return compute_layout(table, {});
+}
+
+inline TableLayout Printer::compute_layout(const TableInternal &table,
+                                           const std::vector<size_t> &column_widths) {
+  TableLayout layout;
+  size_t num_rows = table.size();
+  size_t num_columns = table.estimate_num_columns();
+  table.resolve_formats();
+
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  layout.cells.resize(num_rows * num_columns);
+
+  // Column widths
+  // For each column, the largest configured cell.format.width wins.
+  // If no width is configured, use the widest
+  //   padding_left + cell_contents + padding_right
+  // where cell_contents is the widest line of the cell
+  // Large tables are measured in bands of rows, the widths measured by each
+  // band are then reduced to the widest
+  auto bands = split_rows(num_rows);
+  std::vector<std::vector<size_t>> configured_widths(bands.size()), computed_widths(bands.size());
+  for_each_band(bands.size(), [&](size_t band) {
+    configured_widths[band].resize(num_columns, 0);
+    computed_widths[band].resize(num_columns, 0);
+    for (size_t i = bands[band].first; i < bands[band].last; ++i)
+      measure_row(table, layout, i, configured_widths[band], computed_widths[band]);
+  });
+  for (size_t j = 0; j < num_columns; ++j) {
+    size_t configured_width{0}, computed_width{0};
+    for (size_t band = 0; band < bands.size(); ++band) {
+      configured_width = std::max(configured_width, configured_widths[band][j]);
+      computed_width = std::max(computed_width, computed_widths[band][j]);
+    }
+    if (j < column_widths.size())
+      layout.column_widths[j] = column_widths[j];
+    else
+      layout.column_widths[j] = configured_width != 0 ? configured_width : computed_width;
+  }
+
+  for_each_band(bands.size(), [&](size_t band) {
+    for (size_t i = bands[band].first; i < bands[band].last; ++i)
+      wrap_row(table, layout, i);
+  });
+
+  return layout;
+}
+
+inline void Printer::measure_row(const TableInternal &table, TableLayout &layout, size_t row,
+                                 std::vector<size_t> &configured_widths,
+                                 std::vector<size_t> &computed_widths) {
+  for (size_t j = 0; j < layout.num_columns() && j < table.row_size(row); ++j) {
+    const Format &format = table.resolved_format(row, j);
+    CellLayout &cell_layout = layout.cell(row, j);
+    if (auto nested = table.cell_table(table.cell_index(row, j))) {
+      layout_nested_table(cell_layout, *nested);
+    } else {
+      // The layout refers to the text of the cell until it rewrites it
+      const auto &span = table.cell_texts_[table.cell_index(row, j)];
+      cell_layout.view_text(table.text_.data() + span.offset, span.length);
+      cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
+      if ((cell_layout.text_class & text_control) != 0)
+        expand_tabs(cell_layout, format);
+      split_cell_lines(cell_layout, format);
+    }
+
+    size_t widest_line{0};
+    for (auto &line : cell_layout.lines)
+      widest_line = std::max(widest_line, line.width);
+
+    if (format.has(Format::Property::width))
+      configured_widths[j] = std::max(configured_widths[j], format.width_);
+    computed_widths[j] = std::max(computed_widths[j], format.padding_left_ + widest_line +
+                                                          format.padding_right_);
+  }
+}
+
+inline void Printer::wrap_row(const TableInternal &table, TableLayout &layout, size_t row) {
+  // Row heights
+  // Word wrap each cell once for the width of its column, then
+  //   padding_top + number of lines + padding_bottom
+  // is the computed height of the cell
+  //
+  // NOTE: Unlike column width, row height is calculated as the max
+  // b/w configured height and computed height
+  // which means that .width() has higher precedence than .height()
+  // when both are configured by the user
+  //
+  // TODO: Maybe this can be configured?
+  // If such a configuration is exposed, i.e., prefer height over width
+  // then the logic will be reversed, i.e.,
+  // column_widths.push_back(std::max(configured_width, computed_width))
+  // and
+  // row_height = configured_height if != 0 else computed_height
+  size_t configured_height{0}, computed_height{0};
+  for (size_t j = 0; j < layout.num_columns() && j < table.row_size(row); ++j) {
+    const Format &format = table.resolved_format(row, j);
+    CellLayout &cell_layout = layout.cell(row, j);
+    // A nested table is laid out again if it is wider than the column
+    if (auto nested = table.cell_table(table.cell_index(row, j))) {
+      auto padding = format.padding_left_ + format.padding_right_;
+      auto column_width = layout.column_widths[j];
+      fit_nested_table(cell_layout, *nested, column_width > padding ? column_width - padding : 0);
+    } else {
+      wrap_cell_lines(cell_layout, format, layout.column_widths[j]);
+    }
+
+    if (format.has(Format::Property::height))
+      configured_height = std::max(configured_height, format.height_);
+    computed_height = std::max(computed_height, format.padding_top_ + cell_layout.height() +
+                                                    format.padding_bottom_);
+  }
+  layout.row_heights[row] = std::max(configured_height, computed_height);
+}
+
+inline TableLayout Printer::compute_dimensions(const TableInternal &table, size_t batch_rows) {
+  TableLayout layout;
+  size_t num_rows = table.size();
+  size_t num_columns = table.estimate_num_columns();
+  table.resolve_formats();
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  batch_rows = std::max<size_t>(batch_rows, 1);
+
+  // Column widths are measured like compute_layout() does, then the rows are
+  // measured again to be word wrapped for them
+  std::vector<size_t> configured_widths(num_columns, 0), computed_widths(num_columns, 0);
+  for (size_t first = 0; first < num_rows; first += batch_rows) {
+    auto last = std::min(first + batch_rows, num_rows);
+    layout.first_row = first;
+    layout.cells.clear();
+    layout.cells.resize((last - first) * num_columns);
+    for (auto i = first; i < last; ++i)
+      measure_row(table, layout, i, configured_widths, computed_widths);
+  }
+  for (size_t j = 0; j < num_columns; ++j)
+    layout.column_widths[j] = configured_widths[j] != 0 ? configured_widths[j] : computed_widths[j];
+
+  for (size_t first = 0; first < num_rows; first += batch_rows)
+    layout_rows(table, layout, first, std::min(first + batch_rows, num_rows));
+  layout.first_row = 0;
+  layout.cells.clear();
+  return layout;
+}
+
+inline void Printer::layout_rows(const TableInternal &table, TableLayout &layout, size_t first,
+                                 size_t last) {
+  table.resolve_formats();
+  layout.first_row = first;
+  layout.cells.clear();
+  layout.cells.resize((last - first) * layout.num_columns());
+  std::vector<size_t> configured_widths(layout.num_columns()), computed_widths(layout.num_columns());
+  for (auto i = first; i < last; ++i) {
+    measure_row(table, layout, i, configured_widths, computed_widths);
+    wrap_row(table, layout, i);
+  }
+}
+
+inline std::pair<std::vector<size_t>, std::vector<size_t>>
+Printer::compute_cell_dimensions(const TableInternal &table) {
+  auto layout = compute_layout(table);
+  return {std::move(layout.row_heights), std::move(layout.column_widths)};
+}
+
+inline std::pair<size_t, size_t> Printer::compute_shape(const TableInternal &table) {
+  // An empty last line is printed, after a '\n', unless it is the only one
+  auto widths = compute_line_widths(table, compute_layout(table));
+  if (widths.empty() || (widths.size() == 1 && widths[0] == 0))
+    return {0, 0};
+  return {widths[0], widths.size()};
+}
+
+inline std::vector<size_t> Printer::compute_line_widths(const TableInternal &table,
+                                                        const TableLayout &layout) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  const auto &column_widths = layout.column_widths;
+
+  // Follows print_table() line by line, adding up display widths instead of
+  // printing
+  std::vector<size_t> widths;
+  widths.reserve(num_rows * 2 + 1);
+  size_t line_width{0};
+  auto new_line = [&]() {
+    widths.push_back(line_width);
+    line_width = 0;
+  };
+
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (i > 0)
+      new_line();
+
+    bool border_top_printed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      border_top_printed &= cell_border_top_width(table.resolved_format(i, j), column_widths[j],
+                                                  j + 1 == num_columns, line_width);
+    }
+    if (border_top_printed)
+      new_line();
+
+    auto row_height = layout.row_heights[i];
+    for (size_t k = 0; k < row_height; ++k) {
+      for (size_t j = 0; j < num_columns; ++j) {
+        line_width += row_in_cell_width(table.resolved_format(i, j), layout.cell(i, j),
+                                        column_widths[j], j + 1 == num_columns, k);
+      }
+      if (k + 1 < row_height)
+        new_line();
+    }
+  }
+
+  if (num_rows > 0) {
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
+        break;
+      }
+    }
+    if (bottom_border_needed)
+      new_line();
+    for (size_t j = 0; j < num_columns; ++j) {
+      cell_border_bottom_width(table.resolved_format(i, j), column_widths[j],
+                               j + 1 == num_columns, line_width);
+    }
+  }
+
+  if (num_rows > 0)
+    widths.push_back(line_width);
+  return widths;
+}
+
+inline std::vector<size_t> Printer::compute_line_offsets(const TableInternal &table,
+                                                        const TableLayout &layout) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  std::vector<size_t> offsets;
+  offsets.reserve(num_rows + 1);
+
+  // Rows are separated by a newline, a row prints one more newline after its
+  // top border and between each of its lines
+  size_t line{0};
+  for (size_t i = 0; i < num_rows; ++i) {
+    offsets.push_back(line);
+    size_t width{0};
+    bool border_top_printed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      border_top_printed &= cell_border_top_width(table.resolved_format(i, j),
+                                                  layout.column_widths[j],
+                                                  j + 1 == num_columns, width);
+    }
+    auto row_height = layout.row_heights[i];
+    line += 1 + (border_top_printed ? 1 : 0) + (row_height > 0 ? row_height - 1 : 0);
+  }
+
+  if (num_rows > 0) {
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
+        break;
+      }
+    }
+    if (bottom_border_needed)
+      ++line;
+  }
+  offsets.push_back(line);
+  return offsets;
+}
+
+inline void Printer::layout_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                         const std::vector<size_t> &column_widths) {
+  if (!cell_layout.nested)
+    cell_layout.nested.reset(new NestedLayout());
+  auto &nested = *cell_layout.nested;
+  nested.layout = compute_layout(table, column_widths);
+  nested.line_offsets = compute_line_offsets(table, nested.layout);
+  auto widths = compute_line_widths(table, nested.layout);
+  // An empty last line, e.g., below a hidden bottom border, takes no room
+  if (!widths.empty() && widths.back() == 0)
+    widths.pop_back();
+  cell_layout.lines.clear();
+  cell_layout.lines.reserve(widths.size());
+  for (auto width : widths)
+    cell_layout.lines.push_back({0, 0, width});
+}
+
+inline void Printer::fit_nested_table(CellLayout &cell_layout, const TableInternal &table,
+                                      size_t width) {
+  size_t widest_line{0};
+  for (auto &line : cell_layout.lines)
+    widest_line = std::max(widest_line, line.width);
+  if (widest_line <= width)
+    return;
+
+  // The widest column loses one character at a time, down to its padding
+  // and one character of text, then the cells are word wrapped for the
+  // narrower columns
+  // A nested table still too wide overflows the cell, like natural lines do
+  auto column_widths = cell_layout.nested->layout.column_widths;
+  std::vector<size_t> min_widths(column_widths.size(), 1);
+  for (size_t i = 0; i < table.size(); ++i) {
+    for (size_t j = 0; j < min_widths.size() && j < table.row_size(i); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      min_widths[j] =
+          std::max(min_widths[j], format.padding_left_ + format.padding_right_ + 1);
+    }
+  }
+  for (auto excess = widest_line - width; excess > 0; --excess) {
+    size_t widest = column_widths.size();
+    for (size_t j = 0; j < column_widths.size(); ++j) {
+      if (column_widths[j] > min_widths[j] &&
+          (widest == column_widths.size() || column_widths[j] > column_widths[widest]))
+        widest = j;
+    }
+    if (widest == column_widths.size())
+      break;
+    --column_widths[widest];
+  }
+  layout_nested_table(cell_layout, table, column_widths);
+}
+
+inline void Printer::expand_tabs(CellLayout &cell_layout, const Format &format) {
+  const char *text = cell_layout.text();
+  auto size = cell_layout.text_size();
+  if (std::memchr(text, '\t', size) == nullptr)
+    return;
+
+  std::string result;
+  result.reserve(size + 8);
+  size_t column{0};  // of the line, up to segment
+  size_t segment{0}; // start of the text of result not measured yet
+  for (size_t i = 0; i < size; ++i) {
+    auto c = text[i];
+    if (c == '\t') {
+      column += get_sequence_length(result.data() + segment, result.size() - segment,
+                                    format.multi_byte_characters_);
+      auto spaces = 8 - column % 8;
+      result.append(spaces, ' ');
+      column += spaces;
+      segment = result.size();
+    } else {
+      result += c;
+      if (c == '\n') {
+        column = 0;
+        segment = result.size();
+      }
+    }
+  }
+  cell_layout.set_text(std::move(result));
+  cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
+}
+
+inline void Printer::split_cell_lines(CellLayout &cell_layout, const Format &format) {
+  const char *text = cell_layout.text();
+  auto size = cell_layout.text_size();
+  cell_layout.lines.clear();
+
+  if ((cell_layout.text_class & text_newline) == 0) {
+    // A single line, which is as wide as it is long if it is printable ASCII
+    auto width = is_printable_ascii(cell_layout.text_class)
+                     ? size
+                     : get_sequence_length(text, size, format.multi_byte_characters_);
+    if (width > 0)
+      cell_layout.lines.push_back({0, size, width});
+    return;
+  }
+
+  size_t start{0};
+  while (true) {
+    auto newline = static_cast<const char *>(std::memchr(text + start, '\n', size - start));
+    auto end = newline != nullptr ? static_cast<size_t>(newline - text) : std::string::npos;
+    auto length = (end == std::string::npos ? size : end) - start;
+    auto width = get_sequence_length(text + start, length, format.multi_byte_characters_);
+    if (end == std::string::npos) {
+      if (width > 0)
+        cell_layout.lines.push_back({start, length, width});
+      break;
+    }
+    cell_layout.lines.push_back({start, length, width});
+    start = end + 1;
+  }
+}
+
+inline void Printer::wrap_cell_lines(CellLayout &cell_layout, const Format &format,
+                                     size_t column_width) {
+  auto padding_left = format.padding_left_;
+  auto padding_right = format.padding_right_;
+
+  // A column no wider than its padding leaves no room for text, the cell
+  // keeps a single empty line so that its row is still printed
+  if (format.overflow_ == Overflow::truncate) {
+    if (column_width <= padding_left + padding_right) {
+      cell_layout.lines.assign(1, LineSpan{0, 0, 0});
+      return;
+    }
+    if (!cell_layout.lines.empty())
+      truncate_cell_lines(cell_layout, format, column_width - padding_left - padding_right);
+  } else if ((cell_layout.text_class & text_newline) != 0) {
+    // There are embedded '\n' characters
+    // Respect these characters, the natural lines are printed as they are
+  } else if (column_width <= (padding_left + padding_right)) {
+    // Configured column width cannot be lower than (padding_left + padding_right)
+    // This is a bad configuration
+    // E.g., the user is trying to force the column width to be 5
+    // when padding_left and padding_right are each configured to 3
+    // (padding_left + padding_right) = 6 > column_width
+    cell_layout.lines.assign(1, LineSpan{0, 0, 0});
+    return;
+  } else if (cell_layout.lines.empty() ||
+             cell_layout.lines[0].width <= column_width - padding_left - padding_right) {
+    // Fits in the column, word wrapping would not change anything
+  } else {
+    // Apply word wrapping to input text
+    // (column_width - padding_left - padding_right) is the amount of space
+    // available for cell text
+    std::string text;
+    std::vector<LineSpan> lines;
+    Format::word_wrap(cell_layout.text(), cell_layout.text_size(),
+                      column_width - padding_left - padding_right,
+                      format.multi_byte_characters_, text, lines);
+    cell_layout.set_text(std::move(text));
+    cell_layout.lines.swap(lines);
+    cell_layout.text_class |= text_newline | text_dash;
+  }
+
+  // Only spaces and control characters, e.g., '\t', are trimmed
+  if ((cell_layout.text_class & (text_space | text_control)) == 0)
+    return;
+  for (auto &line : cell_layout.lines)
+    line = trim_line(cell_layout.text(), line, format);
+}
+
+inline void Printer::truncate_cell_lines(CellLayout &cell_layout, const Format &format,
+                                         size_t width) {
+  auto line = cell_layout.lines[0];
+  if (cell_layout.lines.size() == 1 && line.width <= width)
+    return;
+
+  // The ellipsis is left out if the column is too narrow for it
+  auto multi_byte = format.multi_byte_characters_;
+  // U+2026 and "..." both take 3 bytes
+  const char *ellipsis = multi_byte ? "\xe2\x80\xa6" : "...";
+  size_t ellipsis_size{3}, ellipsis_width = multi_byte ? 1 : 3;
+  if (ellipsis_width > width)
+    ellipsis_size = ellipsis_width = 0;
+
+  // Cuts between characters, never inside of a UTF-8 sequence, which is as
+  // wide as it is long without multi-byte character support
+  const char *text = cell_layout.text();
+  auto room = width - ellipsis_width;
+  auto end = line.offset + line.length;
+  size_t cut{line.offset}, cut_width{0};
+  while (cut < end) {
+    auto next = cut;
+    char32_t code_point;
+    size_t character_width{1};
+    if (!decode_utf8(text, end, next, code_point))
+      next = cut + 1;
+    else if (!multi_byte)
+      character_width = next - cut;
+    else if (get_code_point_width(code_point) >= 0)
+      character_width = static_cast<size_t>(get_code_point_width(code_point));
+    if (cut_width + character_width > room)
+      break;
+    cut = next;
+    cut_width += character_width;
+  }
+  while (cut > line.offset && text[cut - 1] == ' ') {
+    --cut;
+    --cut_width;
+  }
+
+  std::string result(text, cut);
+  result.append(ellipsis, ellipsis_size);
+  cell_layout.set_text(std::move(result));
+  cell_layout.text_class = classify_text(cell_layout.text(), cell_layout.text_size());
+  cell_layout.lines.assign(
+      1, LineSpan{line.offset, cell_layout.text_size() - line.offset, cut_width + ellipsis_width});
+}
+
+inline LineSpan Printer::trim_line(const char *text, LineSpan line, const Format &format) {
+  auto is_space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+  auto begin = line.offset, end = line.offset + line.length;
+  while (begin < end && is_space(text[begin]))
+    ++begin;
+  while (end > begin && is_space(text[end - 1]))
+    --end;
+  if (end - begin != line.length)
+    line.width = get_sequence_length(text + begin, end - begin, format.multi_byte_characters_);
+  line.offset = begin;
+  line.length = end - begin;
+  return line;
+}
+
+inline void Printer::print_table(std::ostream &stream, const TableInternal &table) {
+  std::string buffer;
+  StyleState style(buffer, stream);
+  print_table(buffer, style, table);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+inline void Printer::print_table(std::string &buffer, const TableInternal &table) {
+  StyleState style(buffer);
+  print_table(buffer, style, table);
+}
+
+inline size_t Printer::estimate_rendered_size(const TableInternal &table, const TableLayout &layout) {
+  size_t result{0}, line_size{1};
+  for (size_t i = 0; i < layout.num_rows(); ++i) {
+    // Text lines and padding are as wide as the column, borders may use
+    // multi-byte glyphs and multi-byte text takes more bytes than columns
+    size_t text_size{0};
+    line_size = 1;
+    for (size_t j = 0; j < layout.num_columns(); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      auto glyph_size = std::max({size_t(1), format.border_top_.str().size(),
+                                  format.border_bottom_.str().size()});
+      line_size += layout.column_widths[j] * glyph_size + format.border_left_.str().size() +
+                   format.border_right_.str().size() + format.corner_top_left_.str().size() +
+                   format.corner_top_right_.str().size();
+      text_size += layout.cell(i, j).text_size();
+    }
+    // Top border and text lines of the row
+    result += line_size * (layout.row_heights[i] + 1) + text_size;
+  }
+  // Bottom border of the last row
+  return result + line_size;
+}
+
+inline void Printer::print_table(std::string &buffer, StyleState &style, const TableInternal &table) {
+  if (table.cache_rows_ && style.can_fork()) {
+    print_cached_table(buffer, style, table);
+    return;
+  }
+  size_t num_rows = table.size();
+  auto layout = compute_layout(table);
+  auto estimated_size = estimate_rendered_size(table, layout);
+
+  auto bands = style.can_fork() ? split_rows(num_rows) : std::vector<RowBand>{{0, num_rows}};
+  if (bands.size() == 1) {
+    buffer.reserve(buffer.size() + estimated_size);
+    print_rows(buffer, style, table, layout, 0, num_rows);
+    return;
+  }
+
+  // Large tables are rendered in bands of rows, each into a buffer of its own,
+  // which are then appended in order. A band ends in the default style like
+  // every line does, so the bands render exactly what a single pass would
+  std::vector<std::string> band_buffers(bands.size());
+  for_each_band(bands.size(), [&](size_t band) {
+    auto &band_buffer = band_buffers[band];
+    band_buffer.reserve(estimated_size / num_rows * (bands[band].last - bands[band].first + 1));
+    StyleState band_style(band_buffer, style);
+    print_rows(band_buffer, band_style, table, layout, bands[band].first, bands[band].last);
+  });
+
+  auto size = buffer.size();
+  for (auto &band_buffer : band_buffers)
+    size += band_buffer.size();
+  buffer.reserve(size);
+  for (auto &band_buffer : band_buffers)
+    buffer += band_buffer;
+}
+
+inline void Printer::print_cached_table(std::string &buffer, StyleState &style,
+                                        const TableInternal &table) {
+  std::lock_guard<std::mutex> lock(table.cache_mutex_);
+  size_t num_rows = table.size();
+  size_t num_columns = table.estimate_num_columns();
+  if (num_rows == 0)
+    return;
+  table.resolve_formats();
+  auto &cached_rows = table.cached_rows_;
+
+  // The cell layouts are kept empty between prints, only the rows laid out
+  // by this print are emptied again afterwards
+  TableLayout layout;
+  layout.row_heights.resize(num_rows);
+  layout.column_widths.resize(num_columns);
+  layout.cells.swap(table.cached_cells_);
+  layout.cells.resize(num_rows * num_columns);
+
+  // Only the rows changed since the last print are measured, rows with a
+  // nested table every time as the nested table may have changed
+  auto bands = split_rows(num_rows);
+  std::vector<char> measured(num_rows, 0), laid_out(num_rows, 0);
+  for_each_band(bands.size(), [&](size_t band) {
+    for (size_t i = bands[band].first; i < bands[band].last; ++i) {
+      auto &cached = cached_rows[i];
+      if (cached.measured && cached.configured_widths.size() == num_columns &&
+          !table.row_formats_changed(i, cached.generation))
+        continue;
+      cached.generation = table.format_generation_.load(std::memory_order_relaxed);
+      cached.configured_widths.assign(num_columns, 0);
+      cached.computed_widths.assign(num_columns, 0);
+      measure_row(table, layout, i, cached.configured_widths, cached.computed_widths);
+      cached.measured = !table.row_has_tables(i);
+      cached.rendered = false;
+      measured[i] = 1;
+    }
+  });
+  for (size_t j = 0; j < num_columns; ++j) {
+    size_t configured_width{0}, computed_width{0};
+    for (auto &cached : cached_rows) {
+      configured_width = std::max(configured_width, cached.configured_widths[j]);
+      computed_width = std::max(computed_width, cached.computed_widths[j]);
+    }
+    layout.column_widths[j] = configured_width != 0 ? configured_width : computed_width;
+  }
+
+  // Rows are rendered for the widths of the columns and for colors or not
+  if (layout.column_widths != table.cached_column_widths_ ||
+      style.colorized() != table.cached_colorized_) {
+    for (auto &cached : cached_rows)
+      cached.rendered = false;
+    table.cached_column_widths_ = layout.column_widths;
+    table.cached_colorized_ = style.colorized();
+  }
+
+  // Every row but the last is rendered on its own, from and back to the
+  // default style, the last row is followed by the bottom border so it is
+  // always printed along with it
+  auto prepare_row = [&](size_t i) {
+    if (!measured[i]) {
+      std::vector<size_t> configured(num_columns, 0), computed(num_columns, 0);
+      measure_row(table, layout, i, configured, computed);
+    }
+    wrap_row(table, layout, i);
+    laid_out[i] = 1;
+  };
+  for_each_band(bands.size(), [&](size_t band) {
+    BorderLines borders;
+    for (size_t i = bands[band].first; i < bands[band].last && i + 1 < num_rows; ++i) {
+      auto &cached = cached_rows[i];
+      if (cached.rendered)
+        continue;
+      prepare_row(i);
+      cached.text.clear();
+      StyleState row_style(cached.text, style);
+      print_row(cached.text, row_style, table, layout, i, &borders);
+      row_style.reset();
+      cached.rendered = cached.measured;
+    }
+  });
+  prepare_row(num_rows - 1);
+
+  // The last row and the bottom border take about as much as two other rows
+  auto start = buffer.size(), size = start;
+  for (size_t i = 0; i + 1 < num_rows; ++i)
+    size += cached_rows[i].text.size() + 1;
+  buffer.reserve(size + (size - start) / num_rows * 2);
+  for (size_t i = 0; i + 1 < num_rows; ++i) {
+    if (i > 0)
+      buffer += "\n";
+    buffer += cached_rows[i].text;
+  }
+  print_rows(buffer, style, table, layout, num_rows - 1, num_rows);
+
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (!measured[i] && !laid_out[i])
+      continue;
+    for (size_t j = 0; j < num_columns; ++j)
+      layout.cell(i, j) = CellLayout();
+  }
+  layout.cells.swap(table.cached_cells_);
+}
+
+inline void Printer::print_rows(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const TableLayout &layout, size_t first, size_t last) {
+  size_t num_rows = table.size();
+
+  // For each row,
+  // Rows are separated by newlines, there is none after the last row
+  BorderLines borders;
+  for (size_t i = first; i < last; ++i) {
+    if (i > 0) {
+      style.reset();
+      buffer += "\n";
+    }
+    print_row(buffer, style, table, layout, i, &borders);
+  }
+
+  if (last == num_rows && num_rows > 0) {
+    // Check if there is bottom border to print:
+    size_t i = num_rows - 1;
+    auto bottom_border_needed{true};
+    for (size_t j = 0; j < layout.num_columns(); ++j) {
+      const Format &format = table.resolved_format(i, j);
+      if (format.corner_bottom_left_.empty() && format.border_bottom_.empty()) {
+        bottom_border_needed = false;
+        break;
+      }
+    }
+
+    if (bottom_border_needed) {
+      style.reset();
+      buffer += "\n";
+    }
+    // Print bottom border for table
+    print_bottom_border(buffer, style, table, layout.column_widths, i);
+  }
+  style.reset();
+}
+
+inline void Printer::print_row(std::string &buffer, StyleState &style, const TableInternal &table,
+                               const TableLayout &layout, size_t row, BorderLines *borders) {
+  size_t num_columns = layout.num_columns();
+  const auto &column_widths = layout.column_widths;
+  auto row_height = layout.row_heights[row];
+
+  // Print top border, or copy the one of an earlier row with the same formats
+  const uint32_t *formats = table.resolved_styles_.data() + table.cell_index(row, 0);
+  const std::string *border_line{nullptr};
+  if (borders != nullptr) {
+    for (auto &line : borders->lines_) {
+      if (std::equal(line.formats.begin(), line.formats.end(), formats)) {
+        border_line = &line.text;
+        break;
+      }
+    }
+  }
+  if (border_line != nullptr) {
+    buffer += *border_line;
+  } else {
+    auto start = buffer.size();
+    bool border_top_printed{true};
+    for (size_t j = 0; j < num_columns; ++j) {
+      border_top_printed &= print_cell_border_top(buffer, style, table, {row, j},
+                                                  {row_height, column_widths[j]}, num_columns);
+    }
+    if (border_top_printed) {
+      style.reset();
+      buffer += "\n";
+      // A whole line starts and ends in the default style, it can be copied
+      if (borders != nullptr && borders->lines_.size() < BorderLines::max_lines)
+        borders->lines_.push_back({std::vector<uint32_t>(formats, formats + num_columns),
+                                   buffer.substr(start)});
+    }
+  }
+
+  // Print row contents with word wrapping
+  for (size_t k = 0; k < row_height; ++k) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_row_in_cell(buffer, style, table, layout.cell(row, j), {row, j},
+                        {row_height, column_widths[j]}, num_columns, k);
+    }
+    if (k + 1 < row_height) {
+      style.reset();
+      buffer += "\n";
+    }
+  }
+}
+
+inline void Printer::print_line(std::string &buffer, StyleState &style, const TableInternal &table,
+                                const TableLayout &layout, const std::vector<size_t> &line_offsets,
+                                size_t line) {
+  size_t num_rows = layout.num_rows();
+  size_t num_columns = layout.num_columns();
+  if (num_rows == 0)
+    return;
+
+  // Every row spans at least one line, the line is in the last row starting
+  // at or before it
+  auto row = static_cast<size_t>(std::upper_bound(line_offsets.begin(), line_offsets.end() - 1,
+                                                  line) -
+                                 line_offsets.begin()) -
+             1;
+  auto row_height = layout.row_heights[row];
+  auto row_lines = std::max(row_height, size_t(1));
+  auto k = line - line_offsets[row];
+
+  // Lines of the row as print_rows() prints them: the top border, on a line
+  // of its own if every cell has one, then the lines of the cells
+  bool border_top_printed{true};
+  for (size_t j = 0; j < num_columns; ++j) {
+    const Format &format = table.resolved_format(row, j);
+    border_top_printed &= format.show_border_top_ &&
+                          !(format.corner_top_left_.empty() && format.border_top_.empty());
+  }
+  if (k == 0) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_cell_border_top(buffer, style, table, {row, j},
+                            {row_height, layout.column_widths[j]}, num_columns);
+    }
+    if (border_top_printed) {
+      style.reset();
+      return;
+    }
+  } else if (border_top_printed) {
+    --k;
+  }
+
+  if (k < row_height) {
+    for (size_t j = 0; j < num_columns; ++j) {
+      print_row_in_cell(buffer, style, table, layout.cell(row, j), {row, j},
+                        {row_height, layout.column_widths[j]}, num_columns, k);
+    }
+  }
+
+  // Then the bottom border of the table, on a line of its own if it was
+  // counted for it, or after the last line of the last row
+  if (row + 1 == num_rows) {
+    auto bottom_line = line_offsets[row + 1] - line_offsets[row] >
+                       row_lines + (border_top_printed ? 1 : 0);
+    if (k == (bottom_line ? row_lines : row_lines - 1))
+      print_bottom_border(buffer, style, table, layout.column_widths, row);
+  }
+  style.reset();
+}
+
+inline void Printer::print_bottom_border(std::string &buffer, StyleState &style,
+                                         const TableInternal &table,
+                                         const std::vector<size_t> &column_widths, size_t row) {
+  size_t num_columns = column_widths.size();
+  for (size_t j = 0; j < num_columns; ++j)
+    print_cell_border_bottom(buffer, style, table, {row, j}, {0, column_widths[j]}, num_columns);
+}
+
+inline void Printer::print_row_in_cell(std::string &buffer, StyleState &style,
+                                       const TableInternal &table, const CellLayout &cell_layout,
+                                       const std::pair<size_t, size_t> &index,
+                                       const std::pair<size_t, size_t> &dimension,
+                                       size_t num_columns, size_t row_index) {
+  auto column_width = dimension.second;
+  const Format &format = table.resolved_format(index.first, index.second);
+  auto padding_top = format.padding_top_;
+
+  if (format.show_border_left_) {
+    style.apply(format.border_left_color_, format.border_left_background_color_, 0);
+    buffer += format.border_left_.str();
+  }
+
+  style.apply(format.font_color_, format.font_background_color_, 0);
+  if (cell_layout.nested && row_index >= padding_top &&
+      row_index - padding_top < cell_layout.height()) {
+    auto nested = table.cell_table(table.cell_index(index.first, index.second));
+    print_nested_line(buffer, style, *nested, cell_layout, format, column_width,
+                      row_index - padding_top);
+  } else if (row_index >= padding_top && row_index - padding_top < cell_layout.height()) {
+    // Row contents, one word-wrapped line at a time
+    const auto &line = cell_layout.lines[row_index - padding_top];
+    auto padding_left = format.padding_left_;
+    auto padding_right = format.padding_right_;
+
+    // Print left padding characters
+    buffer.append(padding_left, ' ');
+
+    // Print word-wrapped line
+    auto line_with_padding_size = line.width + padding_left + padding_right;
+    switch (format.font_align_) {
+    case FontAlign::left:
+      print_content_left_aligned(buffer, style, cell_layout.text(), line, format,
+                                 line_with_padding_size, column_width);
+      break;
+    case FontAlign::center:
+      print_content_center_aligned(buffer, style, cell_layout.text(), line, format,
+                                   line_with_padding_size, column_width);
+      break;
+    case FontAlign::right:
+      print_content_right_aligned(buffer, style, cell_layout.text(), line, format,
+                                  line_with_padding_size, column_width);
+      break;
+    }
+
+    // Print right padding characters
+    buffer.append(padding_right, ' ');
+  } else {
+    // Padding top, padding bottom or below the last line of a shorter cell
+    buffer.append(column_width, ' ');
+  }
+
+  if (index.second + 1 == num_columns) {
+    // Print right border after last column
+    if (format.show_border_right_) {
+      style.apply(format.border_right_color_, format.border_right_background_color_, 0);
+      buffer += format.border_right_.str();
+    }
+  }
+}
+
+inline void Printer::print_nested_line(std::string &buffer, StyleState &style,
+                                       const TableInternal &table, const CellLayout &cell_layout,
+                                       const Format &format, size_t column_width, size_t line) {
+  auto line_with_padding_size =
+      cell_layout.lines[line].width + format.padding_left_ + format.padding_right_;
+  auto num_spaces =
+      line_with_padding_size < column_width ? column_width - line_with_padding_size : 0;
+  size_t num_spaces_before{0};
+  if (format.font_align_ == FontAlign::center)
+    num_spaces_before = num_spaces / 2 + num_spaces % 2;
+  else if (format.font_align_ == FontAlign::right)
+    num_spaces_before = num_spaces;
+
+  buffer.append(format.padding_left_ + num_spaces_before, ' ');
+  // Like text, the nested table has no colors of its own and takes the font
+  // style of the cell
+  style.apply(format.font_color_, format.font_background_color_, format.font_style_);
+  StyleState nested_style(buffer);
+  auto &nested = *cell_layout.nested;
+  print_line(buffer, nested_style, table, nested.layout, nested.line_offsets, line);
+  style.apply(format.font_color_, format.font_background_color_, 0);
+  buffer.append(num_spaces - num_spaces_before + format.padding_right_, ' ');
+}
+
+inline bool Printer::print_cell_border_top(std::string &buffer, StyleState &style,
+                                           const TableInternal &table,
+                                           const std::pair<size_t, size_t> &index,
+                                           const std::pair<size_t, size_t> &dimension,
+                                           size_t num_columns) {
+  const Format &format = table.resolved_format(index.first, index.second);
+  auto column_width = dimension.second;
+
+  auto corner = format.corner_top_left_;
+  auto corner_color = format.corner_top_left_color_;
+  auto corner_background_color = format.corner_top_left_background_color_;
+  auto border_top = format.border_top_;
+
+  if ((corner.empty() && border_top.empty()) || !format.show_border_top_)
+    return false;
+
+  style.apply(corner_color, corner_background_color, 0);
+  buffer += corner.str();
+
+  style.apply(format.border_top_color_, format.border_top_background_color_, 0);
+  append_repeated(buffer, border_top.str(), column_width);
+
+  if (index.second + 1 == num_columns) {
+    // Print corner after last column
+    corner = format.corner_top_right_;
+    corner_color = format.corner_top_right_color_;
+    corner_background_color = format.corner_top_right_background_color_;
+
+    style.apply(corner_color, corner_background_color, 0);
+    buffer += corner.str();
+  }
+  return true;
+}
+
+inline bool Printer::print_cell_border_bottom(std::string &buffer, StyleState &style,
+                                              const TableInternal &table,
+                                              const std::pair<size_t, size_t> &index,
+                                              const std::pair<size_t, size_t> &dimension,
+                                              size_t num_columns) {
+  const Format &format = table.resolved_format(index.first, index.second);
+  auto column_width = dimension.second;
+
+  auto corner = format.corner_bottom_left_;
+  auto corner_color = format.corner_bottom_left_color_;
+  auto corner_background_color = format.corner_bottom_left_background_color_;
+  auto border_bottom = format.border_bottom_;
+
+  if ((corner.empty() && border_bottom.empty()) || !format.show_border_bottom_)
+    return false;
+
+  style.apply(corner_color, corner_background_color, 0);
+  buffer += corner.str();
+
+  style.apply(format.border_bottom_color_, format.border_bottom_background_color_, 0);
+  append_repeated(buffer, border_bottom.str(), column_width);
+
+  if (index.second + 1 == num_columns) {
+    // Print corner after last column
+    corner = format.corner_bottom_right_;
+    corner_color = format.corner_bottom_right_color_;
+    corner_background_color = format.corner_bottom_right_background_color_;
+
+    style.apply(corner_color, corner_background_color, 0);
+    buffer += corner.str();
+  }
+  return true;
+}
+
+inline size_t Printer::row_in_cell_width(const Format &format, const CellLayout &cell_layout,
+                                         size_t column_width, bool last_column,
+                                         size_t row_index) {
+  size_t width{0};
+  if (format.show_border_left_)
+    width += get_sequence_length(format.border_left_.str(), "", true);
+
+  auto padding_top = format.padding_top_;
+  if (row_index >= padding_top && row_index - padding_top < cell_layout.height()) {
+    // The padding is computed from the width measured by the layout, the text
+    // itself is measured the way shape() always did, with multi-byte support
+    const auto &line = cell_layout.lines[row_index - padding_top];
+    auto line_with_padding_size = line.width + format.padding_left_ + format.padding_right_;
+    auto text_width = format.multi_byte_characters_ || cell_layout.nested
+                          ? line.width
+                          : get_sequence_length(cell_layout.text() + line.offset,
+                                                line.length, true);
+    width += format.padding_left_ + text_width + format.padding_right_;
+    if (line_with_padding_size < column_width)
+      width += column_width - line_with_padding_size;
+  } else {
+    width += column_width;
+  }
+
+  if (last_column && format.show_border_right_)
+    width += get_sequence_length(format.border_right_.str(), "", true);
+  return width;
+}
+
+inline bool Printer::cell_border_top_width(const Format &format, size_t column_width,
+                                           bool last_column, size_t &width) {
+  if ((format.corner_top_left_.empty() && format.border_top_.empty()) ||
+      !format.show_border_top_)
+    return false;
+  width += get_sequence_length(format.corner_top_left_.str(), "", true) +
+           get_sequence_length(format.border_top_.str(), "", true) * column_width;
+  if (last_column)
+    width += get_sequence_length(format.corner_top_right_.str(), "", true);
+  return true;
+}
+
+inline bool Printer::cell_border_bottom_width(const Format &format, size_t column_width,
+                                              bool last_column, size_t &width) {
+  if ((format.corner_bottom_left_.empty() && format.border_bottom_.empty()) ||
+      !format.show_border_bottom_)
+    return false;
+  width += get_sequence_length(format.corner_bottom_left_.str(), "", true) +
+           get_sequence_length(format.border_bottom_.str(), "", true) * column_width;
+  if (last_column)
+    width += get_sequence_length(format.corner_bottom_right_.str(), "", true);
+  return true;
+}
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+// #include <tabulate/table_internal.hpp>
+
+#if __cplusplus >= 201703L
+#include <variant>
+using std::get_if;
+using std::holds_alternative;
+using std::variant;
+using std::visit;
+#else
+// #include <tabulate/variant_lite.hpp>
+using nonstd::get_if;
+using nonstd::holds_alternative;
+using nonstd::variant;
+using nonstd::visit;
+#endif
+
+#include <algorithm>
+#include <deque>
+// #include <tabulate/table_model.hpp>
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace tabulate {
+
+// Source of the cells of a table, pulled from it row by row as they are added
+// to a Table or a TableStream, or shown by a Viewport, so that the data behind
+// a table does not have to be copied into strings all at once beforehand
+//
+//   auto model = make_table_model(contacts.size(), 2, [&](size_t row, size_t column) {
+//     return column == 0 ? contacts[row].name : contacts[row].uri;
+//   });
+//   TableStream table(std::cout);
+//   table.add_rows(model);
+class TableModel {
+public:
+  virtual ~TableModel() {}
+
+  virtual size_t num_rows() const = 0;
+
+  virtual size_t num_columns() const = 0;
+
+  // Text of the cell at the given row and column, pulled once when its row
+  // is added, and whenever a Viewport lays out, shows or searches its row
+  virtual std::string cell(size_t row, size_t column) const = 0;
+};
+
+// Table model reading its cells from a function of the row and the column
+template <typename Function> class FunctionTableModel : public TableModel {
+public:
+  FunctionTableModel(size_t num_rows, size_t num_columns, Function cell)
+      : num_rows_(num_rows), num_columns_(num_columns), cell_(std::move(cell)) {}
+
+  size_t num_rows() const override { return num_rows_; }
+
+  size_t num_columns() const override { return num_columns_; }
+
+  std::string cell(size_t row, size_t column) const override { return cell_(row, column); }
+
+private:
+  size_t num_rows_;
+  size_t num_columns_;
+  Function cell_;
+};
+
+template <typename Function>
+FunctionTableModel<Function> make_table_model(size_t num_rows, size_t num_columns,
+                                              Function cell) {
+  return FunctionTableModel<Function>(num_rows, num_columns, std::move(cell));
+}
+
+} // namespace tabulate
+
+#include <type_traits>
+#include <utility>
+
+namespace tabulate {
+
+class Table {
+public:
+  Table() : table_(TableInternal::create()) {}
+
+  Table &add_row(const std::vector<variant<std::string, const char *, Table>> &cells) {
+    // Texts are copied once, straight from cells into the table
+    std::vector<TableInternal::TextRef> texts;
+    texts.reserve(cells.size());
+    std::string self;
+    bool self_printed{false};
+    for (auto &cell : cells) {
+      if (auto text = get_if<std::string>(&cell)) {
+        texts.push_back(TableInternal::text_ref(*text));
+      } else if (auto text = get_if<const char *>(&cell)) {
+        texts.push_back(TableInternal::text_ref(*text));
+      } else if (get_if<Table>(&cell)->table_ == table_) {
+        // A table nested in itself is rendered as it is now
+        if (!self_printed)
+          print(self);
+        self_printed = true;
+        texts.push_back(TableInternal::text_ref(self));
+      } else {
+        texts.push_back(TableInternal::text_ref(""));
+      }
+    }
+
+    auto row = table_->size();
+    append_row(texts);
+
+    // Other nested tables are kept as they are and rendered with this table
+    for (size_t i = 0; i < cells.size(); ++i) {
+      auto nested = get_if<Table>(&cells[i]);
+      if (nested != nullptr && nested->table_ != table_)
+        table_->set_cell_table(table_->cell_index(row, i), nested->table_);
+    }
+    return *this;
+  }
+
+  // Adds a row with a cell for every argument, std::string or C string
+  // Unlike add_row(), no vector of cells is built, every text is copied once,
+  // straight into the table
+  //
+  //   table.emplace_row(contact.alias, contact.uri, "online");
+  template <typename... Cells> Table &emplace_row(const Cells &...cells) {
+    append_row(std::initializer_list<TableInternal::TextRef>{TableInternal::text_ref(cells)...});
+    return *this;
+  }
+
+  // Adds a row for every element of rows, itself a range of std::string or C
+  // strings, e.g., a std::vector<std::vector<std::string>>
+  template <typename Rows,
+            typename std::enable_if<!std::is_base_of<TableModel, Rows>::value, int>::type = 0>
+  Table &add_rows(const Rows &rows) {
+    for (auto &cells : rows)
+      append_row(cells);
+    return *this;
+  }
+
+  // Adds the rows of a table model, pulling their cells one row at a time
+  // Every cell is copied into the table, a Viewport or a TableStream shows
+  // the rows of a model without holding all of them
+  Table &add_rows(const TableModel &model) {
+    table_->reserve(table_->size() + model.num_rows(), std::max(cols_, model.num_columns()));
+    std::vector<std::string> cells(model.num_columns());
+    for (size_t row = 0; row < model.num_rows(); ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model.cell(row, column);
+      append_row(cells);
+    }
+    return *this;
+  }
+
+  // Makes room for rows rows of columns cells in total, e.g., before adding a
+  // known number of rows
+  Table &reserve(size_t rows, size_t columns) {
+    table_->reserve(rows, columns);
+    return *this;
+  }
+
+  // Keeps every row rendered between prints, so that printing the table
+  // again only renders the rows changed since and copies the others, at the
+  // cost of keeping a copy of the rendered table
+  Table &cache_rows(bool enabled = true) {
+    table_->cache_rows(enabled);
+    return *this;
+  }
+
+  Row &operator[](size_t index) { return row(index); }
+
+  Row &row(size_t index) { return (*table_)[index]; }
+
+  const Row &operator[](size_t index) const { return row(index); }
+
+  const Row &row(size_t index) const { return static_cast<const TableInternal &>(*table_)[index]; }
+
+  Column column(size_t index) { return table_->column(index); }
+
+  Format &format() { return table_->format(); }
+
+  // Printing does not modify the table, so tables, the same one included,
+  // can be printed from several threads as long as none is being modified
+  void print(std::ostream &stream) const { table_->print(stream); }
+
+  // Appends the rendered table to buffer, e.g., to collect several tables
+  // before writing them out at once
+  void print(std::string &buffer) const { table_->print(buffer); }
+
+  std::string str() const {
+    std::string buffer;
+    print(buffer);
+    return buffer;
+  }
+
+  std::pair<size_t, size_t> shape() const { return table_->shape(); }
+
+  class RowIterator {
+  public:
+    explicit RowIterator(std::deque<Row>::iterator ptr) : ptr(ptr) {}
+
+    RowIterator operator++() {
+      ++ptr;
+      return *this;
+    }
+    bool operator!=(const RowIterator &other) const { return ptr != other.ptr; }
+    Row &operator*() { return *ptr; }
+
+  private:
+    std::deque<Row>::iterator ptr;
+  };
+
+  auto begin() -> RowIterator { return RowIterator(table_->rows_.begin()); }
+  auto end() -> RowIterator { return RowIterator(table_->rows_.end()); }
+
+private:
+  friend class MarkdownExporter;
+  friend class LatexExporter;
+  friend class AsciiDocExporter;
+  friend class CsvExporter;
+  friend class TsvExporter;
+  friend class JsonExporter;
+  friend class LiveView;
+  friend class Viewport;
+
+  friend std::ostream &operator<<(std::ostream &stream, const Table &table);
+
+  // Adds a row of cells, padded with empty cells up to the number of cells of
+  // the first row, which is the number of columns of the table
+  template <typename Cells> void append_row(const Cells &cells) {
+    table_->insert_row(table_->size(), cells, cols_);
+    if (rows_ == 0)
+      cols_ = table_->row_size(table_->size() - 1);
+    rows_ += 1;
+  }
+
+  size_t rows_{0};
+  size_t cols_{0};
+  std::shared_ptr<TableInternal> table_;
+};
+
+inline std::ostream &operator<<(std::ostream &stream, const Table &table) {
+  table.print(stream);
+  return stream;
+}
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+// #include <tabulate/table_internal.hpp>
+// #include <tabulate/table_model.hpp>
+#include <utility>
+#include <vector>
+
+namespace tabulate {
+
+// Prints a table row by row, for result sets too large to be held in a Table
+//
+// A Table has to measure all of its rows before the first one is printed.
+// TableStream instead uses declared column widths, or measures the first
+// sample_rows rows, and then prints every row once the next one is added,
+// keeping only the rows not printed yet in memory. Text wider than its column
+// is word wrapped, like in a Table with configured column widths.
+//
+//   TableStream table(std::cout);
+//   table.add_row({"username", "hash"});
+//   for (auto &contact : contacts)
+//     table.add_row({contact.name, contact.uri});
+//   table.close();
+//
+// Unlike Table, every printed line, including the last one, ends with '\n'.
+class TableStream {
+public:
+  explicit TableStream(std::ostream &stream, size_t sample_rows = 100)
+      : stream_(stream), table_(TableInternal::create()), sample_rows_(sample_rows) {}
+
+  TableStream(const TableStream &) = delete;
+  TableStream &operator=(const TableStream &) = delete;
+
+  ~TableStream() { close(); }
+
+  // Format shared by all rows
+  // Changes only apply to the rows that are not printed yet
+  Format &format() { return table_->format(); }
+
+  // Format of a column, shared by the cells of all rows in that column
+  // Like format(), changes only apply to the rows that are not printed yet
+  Column column(size_t index) { return table_->column(index); }
+
+  // Declares the width of the first widths.size() columns, so that rows can be
+  // printed without measuring the first sample_rows rows
+  TableStream &column_widths(std::vector<size_t> widths) {
+    declared_widths_ = std::move(widths);
+    return *this;
+  }
+
+  // Adds a row and prints the previous one
+  // The returned row is printed once the next row is added or the table is
+  // closed, so it can still be formatted, e.g., to style a header row
+  Row &add_row(const std::vector<std::string> &cells) { return append_row(cells); }
+
+  // Same as add_row(), with a cell for every argument, std::string or C
+  // string, without building a vector of cells
+  template <typename... Cells> Row &emplace_row(const Cells &...cells) {
+    using TextRef = TableInternal::TextRef;
+    return append_row(std::initializer_list<TextRef>{TableInternal::text_ref(cells)...});
+  }
+
+  // Adds the rows of a table model, pulling them as the previous ones are
+  // printed, so that no more than sample_rows rows are held at once
+  // Rows are printed sample_rows at a time, even with known column widths
+  TableStream &add_rows(const TableModel &model) {
+    std::vector<std::string> cells(model.num_columns());
+    for (size_t row = 0; row < model.num_rows(); ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model.cell(row, column);
+      append_row(cells, sample_rows_);
+    }
+    return *this;
+  }
+
+  // Same as add_rows(), with every column as wide as in a Table of the rows
+  // not printed yet and of every row of model, so that longer text past the
+  // first sample_rows rows is not word wrapped. The rows of model are pulled
+  // twice, first to be measured sample_rows at a time, then to be printed
+  // Once the column widths are known, e.g., rows were printed, this is
+  // add_rows()
+  TableStream &add_measured_rows(const TableModel &model) {
+    if (column_widths_.empty()) {
+      auto num_columns = std::max(table_->estimate_num_columns(), model.num_columns());
+      std::vector<size_t> configured(num_columns, 0), computed(num_columns, 0);
+      measure_rows(0, configured, computed);
+
+      auto first = table_->size();
+      std::vector<std::string> cells(model.num_columns());
+      for (size_t row = 0; row < model.num_rows();) {
+        auto last = std::min(row + sample_rows_, model.num_rows());
+        for (; row < last; ++row) {
+          for (size_t column = 0; column < cells.size(); ++column)
+            cells[column] = model.cell(row, column);
+          table_->insert_row(table_->size(), cells);
+        }
+        measure_rows(first, configured, computed);
+        table_->erase_rows(first, table_->size());
+      }
+
+      column_widths_.resize(num_columns);
+      for (size_t j = 0; j < num_columns; ++j) {
+        if (j < declared_widths_.size())
+          column_widths_[j] = declared_widths_[j];
+        else
+          column_widths_[j] = configured[j] != 0 ? configured[j] : computed[j];
+      }
+    }
+    return add_rows(model);
+  }
+
+  // Prints the rows not printed yet and the bottom border of the table
+  // Rows added afterwards start a new table
+  void close() {
+    if (table_->size() == 0)
+      return;
+    print_pending_rows();
+
+    StyleState style(buffer_, stream_);
+    Printer::print_bottom_border(buffer_, style, *table_, column_widths_, table_->size() - 1);
+    if (!buffer_.empty()) {
+      style.reset();
+      buffer_ += "\n";
+    }
+    write_buffer();
+
+    table_->erase_rows(0, table_->size());
+    has_printed_row_ = false;
+    column_widths_.clear();
+  }
+
+private:
+  // Once the column widths are known, rows are printed batch_rows at a time
+  template <typename Cells> Row &append_row(const Cells &cells, size_t batch_rows = 1) {
+    if ((widths_known() && pending_rows() >= batch_rows) || pending_rows() >= sample_rows_)
+      print_pending_rows();
+    table_->insert_row(table_->size(), cells);
+    return (*table_)[table_->size() - 1];
+  }
+
+  size_t pending_rows() const { return table_->size() - (has_printed_row_ ? 1 : 0); }
+
+  // Raises configured and computed to the widths the rows of the table from
+  // first on are given and need, see Printer::measure_row()
+  void measure_rows(size_t first, std::vector<size_t> &configured,
+                    std::vector<size_t> &computed) const {
+    TableLayout layout;
+    layout.column_widths.resize(configured.size());
+    layout.row_heights.resize(table_->size());
+    layout.cells.resize(table_->size() * configured.size());
+    table_->resolve_formats();
+    for (auto row = first; row < table_->size(); ++row)
+      Printer::measure_row(*table_, layout, row, configured, computed);
+  }
+
+  bool widths_known() const {
+    return !column_widths_.empty() ||
+           (table_->size() > 0 && declared_widths_.size() >= table_->estimate_num_columns());
+  }
+
+  // Prints every row not printed yet, then drops all the rows but the last one,
+  // which is kept for the bottom border of the table
+  void print_pending_rows() {
+    if (pending_rows() == 0)
+      return;
+
+    // Columns without a declared width are measured on the first rows only
+    auto layout = Printer::compute_layout(
+        *table_, column_widths_.empty() ? declared_widths_ : column_widths_);
+    column_widths_ = layout.column_widths;
+
+    StyleState style(buffer_, stream_);
+    BorderLines borders;
+    for (size_t i = has_printed_row_ ? 1 : 0; i < table_->size(); ++i) {
+      Printer::print_row(buffer_, style, *table_, layout, i, &borders);
+      style.reset();
+      buffer_ += "\n";
+    }
+    write_buffer();
+
+    table_->erase_rows(0, table_->size() - 1);
+    has_printed_row_ = true;
+  }
+
+  void write_buffer() {
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+  std::ostream &stream_;
+  std::shared_ptr<TableInternal> table_;
+  size_t sample_rows_;
+  std::vector<size_t> declared_widths_;
+  std::vector<size_t> column_widths_; // of the table being printed
+  bool has_printed_row_{false};
+  std::string buffer_; // reused by every print
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <string>
+// #include <tabulate/table.hpp>
+// #include <tabulate/table_stream.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tabulate {
+
+// Borders of a TypedTable
+enum class BorderTheme : unsigned char {
+  ascii, // the default borders and corners of tables
+  none   // no borders around the table and between rows, columns are still separated
+};
+
+// Column of a TypedTable holding values of type T, aligned with Align
+// A Width other than 0 fixes the width of the column, padding included, and
+// longer values are truncated with an ellipsis instead of being word wrapped
+// Plain types can be used for left aligned columns
+template <typename T, FontAlign Align = FontAlign::left, size_t Width = 0> struct Field {};
+
+namespace details {
+
+template <typename Column> struct column_traits {
+  using type = Column;
+  static constexpr FontAlign align = FontAlign::left;
+  static constexpr size_t width = 0;
+};
+
+template <typename T, FontAlign Align, size_t Width>
+struct column_traits<Field<T, Align, Width>> {
+  using type = T;
+  static constexpr FontAlign align = Align;
+  static constexpr size_t width = Width;
+};
+
+// Text of a cell, strings are passed on without being copied
+inline const std::string &to_cell(const std::string &value) { return value; }
+
+inline const char *to_cell(const char *value) { return value; }
+
+inline const char *to_cell(bool value) { return value ? "true" : "false"; }
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, std::string>::type
+to_cell(T value) {
+  return std::to_string(value);
+}
+
+// Appends a row of cells to a table or a table stream, returns the new row
+template <typename... Cells>
+inline Row &append_row(Table &table, size_t index, const Cells &...cells) {
+  table.emplace_row(cells...);
+  return table[index];
+}
+
+template <typename... Cells>
+inline Row &append_row(TableStream &table, size_t, const Cells &...cells) {
+  return table.emplace_row(cells...);
+}
+
+inline void reserve(Table &table, size_t rows, size_t columns) { table.reserve(rows, columns); }
+
+// A table stream only holds the rows not printed yet
+inline void reserve(TableStream &, size_t, size_t) {}
+
+} // namespace details
+
+// Number, types and alignment of the columns of a table, and its borders,
+// fixed at compile time
+template <BorderTheme Theme, typename... Columns> struct TableSchema {
+  static constexpr BorderTheme theme = Theme;
+  static constexpr size_t num_columns = sizeof...(Columns);
+  using row_type = std::tuple<typename details::column_traits<Columns>::type...>;
+};
+
+// Table model with a column for each column of Schema, reading its cells from
+// a function of the row and the column
+template <typename Schema, typename Function>
+class TypedTableModel : public FunctionTableModel<Function> {
+public:
+  TypedTableModel(size_t num_rows, Function cell)
+      : FunctionTableModel<Function>(num_rows, Schema::num_columns, std::move(cell)) {}
+};
+
+// Table model for a TypedTable, whose number of columns is the one of Schema
+//
+//   auto model = make_table_model<Schema>(contacts.size(), [&](size_t row, size_t column) {
+//     return column == 0 ? contacts[row].name : contacts[row].uri;
+//   });
+template <typename Schema, typename Function>
+TypedTableModel<Schema, Function> make_table_model(size_t num_rows, Function cell) {
+  return TypedTableModel<Schema, Function>(num_rows, std::move(cell));
+}
+
+// Table, or table stream, following a TableSchema
+//
+//   using Schema = TableSchema<BorderTheme::ascii, std::string, Field<int, FontAlign::right>>;
+//   TypedTable<Schema> table;
+//   table.add_header("name", "age");
+//   table.add_row("alice", 42);
+//   std::cout << table.target();
+//
+// Rows take exactly one value of the type of each column, anything else
+// does not compile. The formats of the theme and the header are built once
+// per schema, so setting up a table only copies them, and aligned or fixed
+// width columns are formatted once as columns, so adding a row does not touch
+// any format.
+template <typename Schema, typename Target = Table> class TypedTable;
+
+template <BorderTheme Theme, typename... Columns, typename Target>
+class TypedTable<TableSchema<Theme, Columns...>, Target> {
+public:
+  using schema = TableSchema<Theme, Columns...>;
+  using row_type = typename schema::row_type;
+
+  // Arguments are forwarded to the target, e.g., the stream of a TableStream
+  template <typename... Args> explicit TypedTable(Args &&...args)
+      : target_(std::forward<Args>(args)...) {
+    target_.format() = Format::merge(theme_format(), target_.format());
+    format_columns(std::index_sequence_for<Columns...>());
+  }
+
+  // Adds a row of headers, underlined and centered
+  // Headers are formatted cell by cell, to take precedence over the alignment
+  // of their column
+  template <typename... Headers> Row &add_header(const Headers &...headers) {
+    static_assert(sizeof...(Headers) == schema::num_columns,
+                  "a header is needed for every column");
+    auto &row = details::append_row(target_, size_++, details::to_cell(headers)...);
+    for (auto &cell : row)
+      cell.format() = header_format();
+    return row;
+  }
+
+  Row &add_row(const typename details::column_traits<Columns>::type &...values) {
+    return details::append_row(target_, size_++, details::to_cell(values)...);
+  }
+
+  Row &add_row(const row_type &values) {
+    return add_row(values, std::index_sequence_for<Columns...>());
+  }
+
+  // Adds the rows of a table model made for the schema, see make_table_model()
+  // Cells of a model are text already, their type is not checked
+  template <typename Function> void add_rows(const TypedTableModel<schema, Function> &model) {
+    target_.add_rows(model);
+    size_ += model.num_rows();
+  }
+
+  // Same as add_rows(), for a TableStream, with the columns measured on every
+  // row of the model, see TableStream::add_measured_rows()
+  template <typename Function>
+  void add_measured_rows(const TypedTableModel<schema, Function> &model) {
+    target_.add_measured_rows(model);
+    size_ += model.num_rows();
+  }
+
+  // Makes room for rows rows, header included
+  void reserve(size_t rows) { details::reserve(target_, rows, schema::num_columns); }
+
+  // Number of rows added, header included
+  size_t size() const { return size_; }
+
+  Target &target() { return target_; }
+
+private:
+  template <size_t... Indices>
+  Row &add_row(const row_type &values, std::index_sequence<Indices...>) {
+    return add_row(std::get<Indices>(values)...);
+  }
+
+  template <size_t... Indices> void format_columns(std::index_sequence<Indices...>) {
+    // Left aligned columns without a width follow the format of the table,
+    // nothing is done for them
+    using expand = int[];
+    (void)expand{0, (format_column<Indices, Columns>(), 0)...};
+  }
+
+  template <size_t Index, typename Column> void format_column() {
+    using traits = details::column_traits<Column>;
+    if (traits::align != FontAlign::left)
+      target_.column(Index).format().font_align(traits::align);
+    if (traits::width != 0)
+      target_.column(Index).format().width(traits::width).overflow(Overflow::truncate);
+  }
+
+  static const Format &theme_format() {
+    static const Format format = [] {
+      Format result;
+      if (Theme == BorderTheme::none)
+        result.corner_top_left("")
+            .corner_top_right("")
+            .corner_bottom_left("")
+            .corner_bottom_right("")
+            .border_top("")
+            .border_bottom("")
+            .border_left("")
+            .border_right("");
+      return result;
+    }();
+    return format;
+  }
+
+  static const Format &header_format() {
+    static const Format format = [] {
+      Format result;
+      result.font_style({FontStyle::underline}).font_align(FontAlign::center);
+      return result;
+    }();
+    return format;
+  }
+
+  Target target_;
+  size_t size_{0};
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+// #include <tabulate/table.hpp>
+// #include <tabulate/table_model.hpp>
+#include <vector>
+
+namespace tabulate {
+
+// A window of a fixed number of lines over a table too tall for the
+// terminal, e.g., for a pager
+//
+//   Viewport viewport(table, 24);
+//   viewport.scroll(10);
+//   viewport.find("alice");
+//   viewport.print(std::cout);
+//
+// The columns and rows of the table are measured once, then only the rows
+// intersecting the window are laid out and rendered, so a print allocates for
+// the rows on the screen. The line on which each row starts is kept in a
+// prefix sum, so the window moves to any row in constant time, and to any
+// line with a binary search, however far it is. refresh() has to be called
+// after the table or its formats change.
+//
+// A viewport over a table model only holds the rows in the window, see the
+// second constructor.
+class Viewport {
+public:
+  Viewport(Table &table, size_t height) : table_(table.table_), height_(height) { refresh(); }
+
+  // Window over the rows of table followed by the rows of model, e.g., the
+  // header of a listing and its rows, which are read from model as they
+  // come into the window or are searched, and dropped afterwards. Like in a
+  // TableStream, columns without a configured width are measured on table
+  // and the first sample_rows rows of model only, longer text further down
+  // is word wrapped. refresh() reads every row of model once, to count its
+  // lines. model must outlive the viewport, table is left untouched.
+  Viewport(Table &table, const TableModel &model, size_t height, size_t sample_rows = 100)
+      : source_(table.table_), model_(&model), sample_rows_(std::max<size_t>(sample_rows, 1)),
+        height_(height) {
+    refresh();
+  }
+
+  // Lays the table out again, keeping the window on the same line if it
+  // still exists
+  void refresh() {
+    if (model_ != nullptr) {
+      measure_model();
+    } else {
+      layout_ = Printer::compute_dimensions(*table_);
+      offsets_ = Printer::compute_line_offsets(*table_, layout_);
+    }
+    borders_.clear();
+    scroll_to(top_);
+  }
+
+  // Number of lines of the rendered table
+  size_t num_lines() const { return offsets_.back(); }
+
+  size_t num_rows() const { return offsets_.size() - 1; }
+
+  size_t height() const { return height_; }
+
+  void set_height(size_t height) {
+    height_ = height;
+    scroll_to(top_);
+  }
+
+  // First line and row in the window
+  size_t top() const { return top_; }
+  size_t top_row() const { return top_row_; }
+
+  // Moves the window so that it starts at line, or as close to it as possible
+  // while staying filled
+  void scroll_to(size_t line) {
+    auto last_top = num_lines() > height_ ? num_lines() - height_ : 0;
+    top_ = std::min(line, last_top);
+    // Last row starting at or before top_
+    top_row_ = static_cast<size_t>(std::upper_bound(offsets_.begin(), offsets_.end() - 1, top_) -
+                                   offsets_.begin());
+    top_row_ = top_row_ > 0 ? top_row_ - 1 : 0;
+    row_ = top_row_;
+  }
+
+  // Moves the window by a number of lines, up if negative
+  void scroll(long lines) {
+    if (lines < 0)
+      scroll_to(top_ - std::min(top_, static_cast<size_t>(-lines)));
+    else
+      scroll_to(top_ + static_cast<size_t>(lines));
+  }
+
+  // Moves the window so that it starts at the top border of row
+  void scroll_to_row(size_t row) {
+    scroll_to(offsets_[std::min(row, num_rows())]);
+    if (row < num_rows())
+      row_ = row;
+  }
+
+  // Moves the window to the next row containing text in any of its cells,
+  // wrapping around at the end of the table. The search starts after the row
+  // the window was last moved to, which differs from top_row() when the
+  // window could not scroll that far. Returns false, without moving, if no
+  // row contains text
+  bool find(const std::string &text) { return find(text, true); }
+
+  // Same as find(), towards the beginning of the table
+  bool find_previous(const std::string &text) { return find(text, false); }
+
+  // Appends the lines in the window to buffer, styled through style
+  // The lines are separated by '\n', there is none after the last line
+  void print(std::string &buffer, StyleState &style) {
+    auto bottom = std::min(top_ + height_, num_lines());
+    auto last_row = top_row_;
+    while (last_row < num_rows() && offsets_[last_row] < bottom)
+      ++last_row;
+
+    // Rows of a model are read into the table for the time of the print, and
+    // laid out for the column widths measured by refresh(), the rows of a
+    // table are laid out in place
+    auto first_read = std::max(top_row_, fixed_rows_);
+    if (model_ != nullptr) {
+      if (first_read < last_row)
+        read_rows(first_read - fixed_rows_, last_row - fixed_rows_);
+      layout_ = Printer::compute_layout(*table_, column_widths_);
+      borders_.clear();
+    } else {
+      Printer::layout_rows(*table_, layout_, top_row_, last_row);
+    }
+
+    std::string lines;
+    for (size_t row = top_row_; row < last_row; ++row) {
+      auto table_row = row;
+      if (model_ != nullptr && row >= fixed_rows_)
+        table_row = fixed_rows_ + row - first_read;
+      lines.clear();
+      Printer::print_row(lines, style, *table_, layout_, table_row, &borders_);
+      if (row + 1 == num_rows()) {
+        // The bottom border of the table is on a line of its own if one was
+        // counted for it
+        style.reset();
+        auto row_lines = 1 + static_cast<size_t>(std::count(lines.begin(), lines.end(), '\n'));
+        if (offsets_[row + 1] - offsets_[row] > row_lines)
+          lines += '\n';
+        Printer::print_bottom_border(lines, style, *table_, layout_.column_widths, table_row);
+      }
+      style.reset();
+
+      // Keep the lines of the row falling in the window
+      auto line = offsets_[row];
+      size_t start{0};
+      while (start <= lines.size() && line < bottom) {
+        auto end = lines.find('\n', start);
+        if (end == std::string::npos)
+          end = lines.size();
+        if (line >= top_) {
+          if (line > top_)
+            buffer += '\n';
+          buffer.append(lines, start, end - start);
+        }
+        start = end + 1;
+        ++line;
+      }
+    }
+
+    if (model_ != nullptr)
+      table_->erase_rows(fixed_rows_, table_->size());
+    else
+      layout_.cells.clear();
+  }
+
+  // Writes the lines in the window to stream at once
+  void print(std::ostream &stream) {
+    std::string buffer;
+    StyleState style(buffer, stream);
+    print(buffer, style);
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+
+private:
+  bool find(const std::string &text, bool forward) {
+    auto rows = num_rows();
+    if (rows == 0)
+      return false;
+    for (size_t n = 1; n <= rows; ++n) {
+      auto row = forward ? (row_ + n) % rows : (row_ + rows - n % rows) % rows;
+      // The text of the cells is searched as it was given, matches can span
+      // the lines it is word wrapped into
+      bool found{false};
+      if (model_ != nullptr && row >= fixed_rows_) {
+        for (size_t j = 0; j < model_->num_columns() && !found; ++j) {
+          auto cell = model_->cell(row - fixed_rows_, j);
+          found = std::search(cell.begin(), cell.end(), text.begin(), text.end()) != cell.end();
+        }
+      } else {
+        for (size_t j = 0; j < table_->row_size(row) && !found; ++j) {
+          table_->visit_cell_text(table_->cell_index(row, j), [&](const char *data, size_t size) {
+            found = std::search(data, data + size, text.begin(), text.end()) != data + size;
+          });
+        }
+      }
+      if (found) {
+        scroll_to_row(row);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Measures the columns of a copy of the table with the first rows of the
+  // model, then counts the lines of every row of the model, laying them out
+  // sample_rows_ at a time. The last row of a batch is laid out again with
+  // the next one, the bottom border of the table is only counted for the
+  // last row of the model
+  void measure_model() {
+    table_ = source_->clone();
+    fixed_rows_ = table_->size();
+    auto rows = model_->num_rows();
+    auto last = std::min(sample_rows_, rows);
+    read_rows(0, last);
+    column_widths_ = Printer::compute_layout(*table_).column_widths;
+
+    offsets_.assign(1, 0);
+    while (true) {
+      auto layout = Printer::compute_layout(*table_, column_widths_);
+      auto offsets = Printer::compute_line_offsets(*table_, layout);
+      auto end = last == rows ? table_->size() : table_->size() - 1;
+      for (auto i = offsets_.size() == 1 ? 0 : fixed_rows_; i < end; ++i)
+        offsets_.push_back(offsets_.back() + offsets[i + 1] - offsets[i]);
+      if (last == rows)
+        break;
+
+      table_->erase_rows(fixed_rows_, table_->size() - 1);
+      auto next = std::min(last + sample_rows_, rows);
+      read_rows(last, next);
+      last = next;
+    }
+    table_->erase_rows(fixed_rows_, table_->size());
+  }
+
+  // Appends the rows [first, last) of the model to the table
+  void read_rows(size_t first, size_t last) {
+    std::vector<std::string> cells(model_->num_columns());
+    for (auto row = first; row < last; ++row) {
+      for (size_t column = 0; column < cells.size(); ++column)
+        cells[column] = model_->cell(row, column);
+      table_->insert_row(table_->size(), cells, table_->estimate_num_columns());
+    }
+  }
+
+  std::shared_ptr<TableInternal> table_;
+  std::shared_ptr<TableInternal> source_; // table copied into table_, with a model
+  const TableModel *model_{nullptr};      // rows read into table_ after its own rows
+  size_t sample_rows_{0};
+  size_t fixed_rows_{0};             // rows of table_ not read from the model
+  std::vector<size_t> column_widths_; // measured by refresh() for the rows of the model
+  TableLayout layout_;   // of the rows in the window while they are printed
+  BorderLines borders_; // top borders rendered for layout_
+  std::vector<size_t> offsets_; // first line of each row, then the number of lines
+  size_t height_;
+  size_t top_{0};     // first line in the window
+  size_t top_row_{0}; // row on which top_ is
+  size_t row_{0};     // row the window was last moved to, searches start from it
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+// #include <tabulate/table.hpp>
+// #include <tabulate/viewport.hpp>
+#include <vector>
+
+namespace tabulate {
+
+// Redraws a table in place on a terminal, e.g., a dashboard refreshed every
+// second, writing only what changed since the previous frame
+//
+//   LiveView view(std::cout);
+//   while (running) {
+//     update(table);
+//     view.render(table);
+//     std::this_thread::sleep_for(std::chrono::seconds(1));
+//   }
+//
+// The previous frame is kept, each line of the new frame is compared with the
+// line drawn before it and only the changed ones are rewritten using cursor
+// movements. Within an uncolored line only the changed characters are
+// rewritten. The frame has to fit on the screen, lines scrolled out of it can
+// no longer be reached by the cursor.
+class LiveView {
+public:
+  explicit LiveView(std::ostream &stream) : stream_(stream) {}
+
+  LiveView(const LiveView &) = delete;
+  LiveView &operator=(const LiveView &) = delete;
+
+  // Draws table over the previous frame, or below the cursor for the first
+  // frame. The cursor is left at the start of the line below the frame
+  void render(Table &table) {
+    std::string frame;
+    StyleState style = frame_style(frame);
+    Printer::print_table(frame, style, *table.table_);
+    draw(frame);
+  }
+
+  // Draws the lines in the window of viewport, e.g., after scrolling it
+  void render(Viewport &viewport) {
+    std::string frame;
+    StyleState style = frame_style(frame);
+    viewport.print(frame, style);
+    draw(frame);
+  }
+
+  // Forgets the previous frame, the next frame is drawn below the cursor
+  void reset() {
+    frame_.clear();
+    lines_.clear();
+    row_ = 0;
+  }
+
+  // Number of bytes written by the last render()
+  size_t last_update_size() const { return last_update_size_; }
+
+private:
+  struct Line {
+    size_t offset;
+    size_t length;
+  };
+
+  StyleState frame_style(std::string &frame) {
+#if defined(_WIN32) || defined(_WIN64)
+    // Colors are set through the console API there, which cannot be
+    // replayed from a frame, so frames are kept plain
+    return StyleState(frame);
+#else
+    return StyleState(frame, stream_);
+#endif
+  }
+
+  void draw(std::string &frame) {
+    std::vector<Line> lines;
+    size_t start{0};
+    while (start < frame.size()) {
+      auto end = frame.find('\n', start);
+      if (end == std::string::npos)
+        end = frame.size();
+      lines.push_back({start, end - start});
+      start = end + 1;
+    }
+
+    std::string output;
+    update(output, frame, lines);
+    stream_.write(output.data(), static_cast<std::streamsize>(output.size()));
+    stream_.flush();
+    last_update_size_ = output.size();
+
+    frame_.swap(frame);
+    lines_.swap(lines);
+  }
+
+  void update(std::string &output, const std::string &frame, const std::vector<Line> &lines) {
+    auto common_lines = std::min(lines.size(), lines_.size());
+    for (size_t i = 0; i < common_lines; ++i)
+      update_line(output, i, frame, lines[i]);
+
+    if (lines.size() > lines_.size()) {
+      // New lines are printed below the previous frame, scrolling if needed
+      move_to(output, lines_.size());
+      for (size_t i = lines_.size(); i < lines.size(); ++i) {
+        output.append(frame, lines[i].offset, lines[i].length);
+        output += '\n';
+      }
+      row_ = lines.size();
+    } else if (lines.size() < lines_.size()) {
+      // Erase the lines left from the previous frame
+      move_to(output, lines.size());
+      output += "\033[J";
+    }
+    // The cursor is still at the start of the line below the frame if
+    // nothing changed
+    if (!output.empty())
+      move_to(output, lines.size());
+  }
+
+  void update_line(std::string &output, size_t row, const std::string &frame, const Line &line) {
+    const char *text = frame.data() + line.offset;
+    const char *old_text = frame_.data() + lines_[row].offset;
+    auto size = line.length, old_size = lines_[row].length;
+    if (size == old_size && std::memcmp(text, old_text, size) == 0)
+      return;
+
+    move_to(output, row);
+    if (std::memchr(text, '\033', size) != nullptr ||
+        std::memchr(old_text, '\033', old_size) != nullptr) {
+      // Escape sequences have no width, the whole styled line is rewritten
+      output.append(text, size);
+      output += "\033[K";
+      return;
+    }
+
+    // Skip the unchanged characters at both ends of the line
+    auto is_continuation = [](char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; };
+    size_t prefix{0};
+    while (prefix < size && prefix < old_size && text[prefix] == old_text[prefix])
+      ++prefix;
+    while (prefix > 0 && ((prefix < size && is_continuation(text[prefix])) ||
+                          (prefix < old_size && is_continuation(old_text[prefix]))))
+      --prefix;
+    size_t suffix{0};
+    while (suffix < size - prefix && suffix < old_size - prefix &&
+           text[size - suffix - 1] == old_text[old_size - suffix - 1])
+      ++suffix;
+    while (suffix > 0 && (is_continuation(text[size - suffix]) ||
+                          is_continuation(old_text[old_size - suffix])))
+      --suffix;
+
+    auto column = get_sequence_length(text, prefix, true);
+    if (column > 0)
+      output += "\033[" + std::to_string(column + 1) + "G";
+
+    auto changed = size - suffix - prefix, old_changed = old_size - suffix - prefix;
+    if (get_sequence_length(text + prefix, changed, true) ==
+        get_sequence_length(old_text + prefix, old_changed, true)) {
+      // Same width, the end of the line stays where it is
+      output.append(text + prefix, changed);
+    } else {
+      output.append(text + prefix, size - prefix);
+      output += "\033[K";
+    }
+  }
+
+  // Moves the cursor to the start of a line of the frame
+  void move_to(std::string &output, size_t row) {
+    if (row < row_)
+      output += "\033[" + std::to_string(row_ - row) + "A";
+    else if (row > row_)
+      output += "\033[" + std::to_string(row - row_) + "B";
+    output += '\r';
+    row_ = row;
+  }
+
+  std::ostream &stream_;
+  std::string frame_;
+  std::vector<Line> lines_; // lines of frame_
+  size_t row_{0};           // line of the frame the cursor is on
+  size_t last_update_size_{0};
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+#include <ostream>
+#include <string>
+// #include <tabulate/table.hpp>
+
+namespace tabulate {
+
+class Exporter {
+public:
+  virtual ~Exporter() = default;
+
+  virtual std::string dump(Table &table) = 0;
+
+  // Writes the exported table to stream
+  virtual void dump(Table &table, std::ostream &stream) {
+    auto result = dump(table);
+    stream.write(result.data(), static_cast<std::streamsize>(result.size()));
+  }
+
+protected:
+  // Streaming exporters render into buffer and hand it to stream in chunks of
+  // this size; without a stream the buffer holds the whole result
+  static const size_t flush_size = 64 * 1024;
+
+  static void flush(std::string &buffer, std::ostream *stream, size_t threshold = 0) {
+    if (stream == nullptr || buffer.size() < threshold)
+      return;
+    stream->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+  }
+};
+
+} // namespace tabulate
+
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+// #include <tabulate/exporter.hpp>
+
+namespace tabulate {
+
+class MarkdownExporter : public Exporter {
+public:
+  using Exporter::dump;
+
+  // The markdown borders are applied to a copy of the table, which is left
+  // untouched and can be printed by other threads meanwhile
+  std::string dump(Table &table) override {
+    Table copy;
+    copy.table_ = table.table_->clone();
+    copy.rows_ = table.rows_;
+    copy.cols_ = table.cols_;
+    apply_markdown_format(copy);
+    return copy.str();
+  }
+
+private:
+  void add_alignment_header_row(Table &table) {
+    auto &storage = *table.table_;
+
+    if (storage.size() >= 1) {
+      // Create alignment header cells
+      std::vector<std::string> alignment_cells{};
+      for (auto &cell : table[0]) {
+        const Format &format = cell.resolved_format();
+        if (format.font_align_ == FontAlign::left) {
+          alignment_cells.push_back(":----");
+        } else if (format.font_align_ == FontAlign::center) {
+          alignment_cells.push_back(":---:");
+        } else if (format.font_align_ == FontAlign::right) {
+          alignment_cells.push_back("----:");
+        }
+      }
+
+      // Insert alignment header row
+      storage.insert_row(1, alignment_cells);
+      for (auto &cell : storage[1]) {
+        cell.format()
+            .hide_border_top()
+            .hide_border_bottom()
+            .border_left("|")
+            .border_right("|")
+            .column_separator("|")
+            .corner("|");
+        auto text = cell.get_text();
+        if (text == ":---:")
+          cell.format().font_align(FontAlign::center);
+        else if (text == "----:")
+          cell.format().font_align(FontAlign::right);
       }
     }
-    if (i + 1 < num_rows)
-      stream << termcolor::reset << "\n"; // Don't add newline after last row
   }
-}
 
-inline void Printer::print_row_in_cell(std::ostream &stream, TableInternal &table,
-                                       const std::pair<size_t, size_t> &index,
-                                       const std::pair<size_t, size_t> &dimension,
-                                       size_t num_columns, size_t row_index) {
-  auto column_width = dimension.second;
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  auto is_multi_byte_character_support_enabled = cell.is_multi_byte_character_support_enabled();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
-  auto text = cell.get_text();
-  auto word_wrapped_text =
-      Format::word_wrap(text, column_width, locale, is_multi_byte_character_support_enabled);
-  auto text_height = std::count(word_wrapped_text.begin(), word_wrapped_text.end(), '\n') + 1;
-  auto padding_top = *format.padding_top_;
-
-  if (*format.show_border_left_) {
-    apply_element_style(stream, *format.border_left_color_, *format.border_left_background_color_,
-                        {});
-    stream << *format.border_left_;
-    reset_element_style(stream);
-  }
-
-  apply_element_style(stream, *format.font_color_, *format.font_background_color_, {});
-  if (row_index < padding_top) {
-    // Padding top
-    stream << std::string(column_width, ' ');
-  } else if (row_index >= padding_top && (row_index <= (padding_top + text_height))) {
-    // // Row contents
-
-    // Retrieve padding left and right
-    // (column_width - padding_left - padding_right) is the amount of space
-    // available for cell text - Use this to word wrap cell contents
-    auto padding_left = *format.padding_left_;
-    auto padding_right = *format.padding_right_;
-
-    // Check if input text has embedded \n that are to be respected
-    auto newlines_in_input = Format::split_lines(text, "\n", cell.locale(),
-                                                 cell.is_multi_byte_character_support_enabled())
-                                 .size() -
-                             1;
-    std::string word_wrapped_text;
-
-    // If there are no embedded \n characters, then apply word wrap
-    if (newlines_in_input == 0) {
-      // Apply word wrapping to input text
-      // Then display one word-wrapped line at a time within cell
-      if (column_width > (padding_left + padding_right))
-        word_wrapped_text =
-            Format::word_wrap(text, column_width - padding_left - padding_right, cell.locale(),
-                              cell.is_multi_byte_character_support_enabled());
-      else {
-        // Configured column width cannot be lower than (padding_left + padding_right)
-        // This is a bad configuration
-        // E.g., the user is trying to force the column width to be 5
-        // when padding_left and padding_right are each configured to 3
-        // (padding_left + padding_right) = 6 > column_width
+  void apply_markdown_format(Table &table) {
+    // Apply markdown format to cells in each row
+    for (auto row : table) {
+      for (auto &cell : row) {
+        cell.format()
+            .hide_border_top()
+            .hide_border_bottom()
+            .border_left("|")
+            .border_right("|")
+            .column_separator("|")
+            .corner("|");
       }
-    } else {
-      word_wrapped_text = text; // repect the embedded '\n' characters
     }
+    // Add alignment header row at position 1
+    add_alignment_header_row(table);
+  }
+};
 
-    auto lines = Format::split_lines(word_wrapped_text, "\n", cell.locale(),
-                                     cell.is_multi_byte_character_support_enabled());
+} // namespace tabulate
 
-    if (row_index - padding_top < lines.size()) {
-      auto line = lines[row_index - padding_top];
+/*
+  __        ___.         .__          __
+_/  |______ \_ |__  __ __|  | _____ _/  |_  ____
+\   __\__  \ | __ \|  |  \  | \__  \\   __\/ __ \
+ |  |  / __ \| \_\ \  |  /  |__/ __ \|  | \  ___/
+ |__| (____  /___  /____/|____(____  /__|  \___  >
+           \/    \/                \/          \/
+Table Maker for Modern C++
+https://github.com/p-ranav/tabulate
 
-      // Print left padding characters
-      stream << std::string(padding_left, ' ');
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2019 Pranav Srinivas Kumar <pranav.srinivas.kumar@gmail.com>.
 
-      // Print word-wrapped line
-      line = Format::trim(line);
-      auto line_with_padding_size =
-          get_sequence_length(line, cell.locale(), cell.is_multi_byte_character_support_enabled()) +
-          padding_left + padding_right;
-      switch (*format.font_align_) {
-      case FontAlign::left:
-        print_content_left_aligned(stream, line, format, line_with_padding_size, column_width);
-        break;
-      case FontAlign::center:
-        print_content_center_aligned(stream, line, format, line_with_padding_size, column_width);
-        break;
-      case FontAlign::right:
-        print_content_right_aligned(stream, line, format, line_with_padding_size, column_width);
-        break;
-      }
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
 
-      // Print right padding characters
-      stream << std::string(padding_right, ' ');
-    } else
-      stream << std::string(column_width, ' ');
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
 
-  } else {
-    // Padding bottom
-    stream << std::string(column_width, ' ');
-  }
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#pragma once
+// #include <tabulate/exporter.hpp>
 
-  reset_element_style(stream);
+#if __cplusplus >= 201703L
+#include <optional>
+using std::optional;
+#else
+// #include <tabulate/optional_lite.hpp>
+using nonstd::optional;
+#endif
 
-  if (index.second + 1 == num_columns) {
-    // Print right border after last column
-    if (*format.show_border_right_) {
-      apply_element_style(stream, *format.border_right_color_,
-                          *format.border_right_background_color_, {});
-      stream << *format.border_right_;
-      reset_element_style(stream);
-    }
-  }
-}
+namespace tabulate {
 
-inline bool Printer::print_cell_border_top(std::ostream &stream, TableInternal &table,
-                                           const std::pair<size_t, size_t> &index,
-                                           const std::pair<size_t, size_t> &dimension,
-                                           size_t num_columns) {
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
-  auto column_width = dimension.second;
+class LatexExporter : public Exporter {
 
-  auto corner = *format.corner_top_left_;
-  auto corner_color = *format.corner_top_left_color_;
-  auto corner_background_color = *format.corner_top_left_background_color_;
-  auto border_top = *format.border_top_;
+  static const char new_line = '\n';
 
-  if ((corner == "" && border_top == "") || !*format.show_border_top_)
-    return false;
+public:
+  class ExportOptions {
+  public:
+    ExportOptions &indentation(std::size_t value) {
+      indentation_ = value;
+      return *this;
+    }
 
-  apply_element_style(stream, corner_color, corner_background_color, {});
-  stream << corner;
-  reset_element_style(stream);
+  private:
+    friend class LatexExporter;
+    optional<size_t> indentation_;
+  };
 
-  for (size_t i = 0; i < column_width; ++i) {
-    apply_element_style(stream, *format.border_top_color_, *format.border_top_background_color_,
-                        {});
-    stream << border_top;
-    reset_element_style(stream);
-  }
+  ExportOptions &configure() { return options_; }
 
-  if (index.second + 1 == num_columns) {
-    // Print corner after last column
-    corner = *format.corner_top_right_;
-    corner_color = *format.corner_top_right_color_;
-    corner_background_color = *format.corner_top_right_background_color_;
+  using Exporter::dump;
 
-    apply_element_style(stream, corner_color, corner_background_color, {});
-    stream << corner;
-    reset_element_style(stream);
-  }
-  return true;
-}
+  std::string dump(Table &table) override {
+    std::string result{"\\begin{tabular}"};
+    result += new_line;
 
-inline bool Printer::print_cell_border_bottom(std::ostream &stream, TableInternal &table,
-                                              const std::pair<size_t, size_t> &index,
-                                              const std::pair<size_t, size_t> &dimension,
-                                              size_t num_columns) {
-  auto cell = table[index.first][index.second];
-  auto locale = cell.locale();
-  std::locale::global(std::locale(locale));
-  auto format = cell.format();
-  auto column_width = dimension.second;
+    result += add_alignment_header(table);
+    result += new_line;
+    const auto rows = table.rows_;
+    // iterate content and put text into the table.
+    for (size_t i = 0; i < rows; i++) {
+      auto &row = table[i];
+      // apply row content indentation
+      if (options_.indentation_.has_value()) {
+        result += std::string(options_.indentation_.value(), ' ');
+      }
 
-  auto corner = *format.corner_bottom_left_;
-  auto corner_color = *format.corner_bottom_left_color_;
-  auto corner_background_color = *format.corner_bottom_left_background_color_;
-  auto border_bottom = *format.border_bottom_;
+      for (size_t j = 0; j < row.size(); j++) {
 
-  if ((corner == "" && border_bottom == "") || !*format.show_border_bottom_)
-    return false;
+        result += row[j].get_text();
 
-  apply_element_style(stream, corner_color, corner_background_color, {});
-  stream << corner;
-  reset_element_style(stream);
+        // check column position, need "\\" at the end of each row
+        if (j < row.size() - 1) {
+          result += " & ";
+        } else {
+          result += " \\\\";
+        }
+      }
+      result += new_line;
+    }
 
-  for (size_t i = 0; i < column_width; ++i) {
-    apply_element_style(stream, *format.border_bottom_color_,
-                        *format.border_bottom_background_color_, {});
-    stream << border_bottom;
-    reset_element_style(stream);
+    result += "\\end{tabular}";
+    return result;
   }
 
-  if (index.second + 1 == num_columns) {
-    // Print corner after last column
-    corner = *format.corner_bottom_right_;
-    corner_color = *format.corner_bottom_right_color_;
-    corner_background_color = *format.corner_bottom_right_background_color_;
+private:
+  std::string add_alignment_header(Table &table) {
+    std::string result{"{"};
 
-    apply_element_style(stream, corner_color, corner_background_color, {});
-    stream << corner;
-    reset_element_style(stream);
+    for (auto &cell : table[0]) {
+      const Format &format = cell.resolved_format();
+      if (format.font_align_ == FontAlign::left) {
+        result += 'l';
+      } else if (format.font_align_ == FontAlign::center) {
+        result += 'c';
+      } else if (format.font_align_ == FontAlign::right) {
+        result += 'r';
+      }
+    }
+
+    result += "}";
+    return result;
   }
-  return true;
-}
+  ExportOptions options_;
+};
 
 } // namespace tabulate
 
@@ -6962,118 +10424,102 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-// #include <tabulate/table_internal.hpp>
+#include <algorithm>
+#include <optional>
+#include <sstream>
+#include <string>
+// #include <tabulate/exporter.hpp>
 
-#if __cplusplus >= 201703L
-#include <variant>
-using std::get_if;
-using std::holds_alternative;
-using std::variant;
-using std::visit;
-#else
-// #include <tabulate/variant_lite.hpp>
-using nonstd::get_if;
-using nonstd::holds_alternative;
-using nonstd::variant;
-using nonstd::visit;
-#endif
+namespace tabulate {
 
-#include <utility>
+class AsciiDocExporter : public Exporter {
 
-namespace tabulate {
+  static const char new_line = '\n';
 
-class Table {
 public:
-  Table() : table_(TableInternal::create()) {}
-
-  Table &add_row(const std::vector<variant<std::string, const char *, Table>> &cells) {
+  using Exporter::dump;
 
-    if (rows_ == 0) {
-      // This is the first row added
-      // cells.size() is the number of columns
-      cols_ = cells.size();
-    }
+  std::string dump(Table &table) override {
+    std::stringstream ss;
+    ss << add_alignment_header(table);
+    ss << new_line;
 
-    std::vector<std::string> cell_strings;
-    if (cells.size() < cols_) {
-      cell_strings.resize(cols_);
-      std::fill(cell_strings.begin(), cell_strings.end(), "");
-    } else {
-      cell_strings.resize(cells.size());
-      std::fill(cell_strings.begin(), cell_strings.end(), "");
-    }
+    const auto rows = table.rows_;
+    // iterate content and put text into the table.
+    for (size_t row_index = 0; row_index < rows; row_index++) {
+      auto &row = table[row_index];
 
-    for (size_t i = 0; i < cells.size(); ++i) {
-      auto cell = cells[i];
-      if (holds_alternative<std::string>(cell)) {
-        cell_strings[i] = *get_if<std::string>(&cell);
-      } else if (holds_alternative<const char *>(cell)) {
-        cell_strings[i] = *get_if<const char *>(&cell);
-      } else {
-        auto table = *get_if<Table>(&cell);
-        std::stringstream stream;
-        table.print(stream);
-        cell_strings[i] = stream.str();
+      for (size_t cell_index = 0; cell_index < row.size(); cell_index++) {
+        ss << "|";
+        ss << add_formatted_cell(row[cell_index]);
+      }
+      ss << new_line;
+      if (row_index == 0) {
+        ss << new_line;
       }
     }
 
-    table_->add_row(cell_strings);
-    rows_ += 1;
-    return *this;
+    ss << "|===";
+    return ss.str();
   }
 
-  Row &operator[](size_t index) { return row(index); }
-
-  Row &row(size_t index) { return (*table_)[index]; }
-
-  Column column(size_t index) { return table_->column(index); }
+private:
+  std::string add_formatted_cell(Cell &cell) const {
+    std::stringstream ss;
+    const Format &format = cell.resolved_format();
+    std::string cell_string = cell.get_text();
 
-  Format &format() { return table_->format(); }
+    bool format_bold = (format.font_style_ & font_style_bit(FontStyle::bold)) != 0;
+    bool format_italic = (format.font_style_ & font_style_bit(FontStyle::italic)) != 0;
 
-  void print(std::ostream &stream) { table_->print(stream); }
+    if (format_bold) {
+      ss << '*';
+    }
+    if (format_italic) {
+      ss << '_';
+    }
 
-  std::string str() {
-    std::stringstream stream;
-    print(stream);
-    return stream.str();
+    ss << cell_string;
+    if (format_italic) {
+      ss << '_';
+    }
+    if (format_bold) {
+      ss << '*';
+    }
+    return ss.str();
   }
 
-  std::pair<size_t, size_t> shape() { return table_->shape(); }
-
-  class RowIterator {
-  public:
-    explicit RowIterator(std::vector<std::shared_ptr<Row>>::iterator ptr) : ptr(ptr) {}
+  std::string add_alignment_header(Table &table) {
+    std::stringstream ss;
+    ss << (R"([cols=")");
 
-    RowIterator operator++() {
-      ++ptr;
-      return *this;
-    }
-    bool operator!=(const RowIterator &other) const { return ptr != other.ptr; }
-    Row &operator*() { return **ptr; }
+    size_t column_count = table[0].size();
+    size_t column_index = 0;
+    for (auto &cell : table[0]) {
+      const Format &format = cell.resolved_format();
 
-  private:
-    std::vector<std::shared_ptr<Row>>::iterator ptr;
-  };
+      if (format.font_align_ == FontAlign::left) {
+        ss << '<';
+      } else if (format.font_align_ == FontAlign::center) {
+        ss << '^';
+      } else if (format.font_align_ == FontAlign::right) {
+        ss << '>';
+      }
 
-  auto begin() -> RowIterator { return RowIterator(table_->rows_.begin()); }
-  auto end() -> RowIterator { return RowIterator(table_->rows_.end()); }
+      ++column_index;
+      if (column_index != column_count) {
+        ss << ",";
+      }
+    }
 
-private:
-  friend class MarkdownExporter;
-  friend class LatexExporter;
-  friend class AsciiDocExporter;
+    ss << R"("])";
+    ss << new_line;
+    ss << "|===";
 
-  friend std::ostream &operator<<(std::ostream &stream, const Table &table);
-  size_t rows_{0};
-  size_t cols_{0};
-  std::shared_ptr<TableInternal> table_;
+    return ss.str();
+  }
 };
 
-inline std::ostream &operator<<(std::ostream &stream, const Table &table) {
-  const_cast<Table &>(table).print(stream);
-  return stream;
-}
-
 } // namespace tabulate
 
 /*
@@ -7109,14 +10555,78 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <string>
-// #include <tabulate/table.hpp>
+// #include <tabulate/exporter.hpp>
 
 namespace tabulate {
 
-class Exporter {
+// Comma-separated values as described in RFC 4180, one line per row.
+// Fields holding the delimiter, a quote or a line break are quoted.
+class CsvExporter : public Exporter {
 public:
-  virtual std::string dump(Table &table) = 0;
+  class ExportOptions {
+  public:
+    ExportOptions &delimiter(char value) {
+      delimiter_ = value;
+      return *this;
+    }
+
+  private:
+    friend class CsvExporter;
+    char delimiter_{','};
+  };
+
+  ExportOptions &configure() { return options_; }
+
+  std::string dump(Table &table) override {
+    std::string result;
+    write(*table.table_, result, nullptr);
+    return result;
+  }
+
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
+  }
+
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    for (size_t i = 0; i < table.size(); ++i) {
+      for (size_t j = 0; j < table.row_size(i); ++j) {
+        if (j > 0)
+          buffer += options_.delimiter_;
+        auto cell = table.cell_index(i, j);
+        table.visit_cell_text(cell, [&](const char *data, size_t size) {
+          add_field(buffer, data, size);
+        });
+      }
+      buffer += '\n';
+      flush(buffer, stream, flush_size);
+    }
+  }
+
+  void add_field(std::string &buffer, const char *data, size_t size) const {
+    bool quoted = false;
+    for (size_t i = 0; i < size && !quoted; ++i) {
+      quoted = data[i] == options_.delimiter_ || data[i] == '"' || data[i] == '\n' ||
+               data[i] == '\r';
+    }
+    if (!quoted) {
+      buffer.append(data, size);
+      return;
+    }
+
+    buffer += '"';
+    for (size_t i = 0; i < size; ++i) {
+      if (data[i] == '"')
+        buffer += '"';
+      buffer += data[i];
+    }
+    buffer += '"';
+  }
+
+  ExportOptions options_;
 };
 
 } // namespace tabulate
@@ -7158,101 +10668,60 @@ SOFTWARE.
 
 namespace tabulate {
 
-class MarkdownExporter : public Exporter {
+// Tab-separated values, one line per row. Tabs, line breaks and backslashes
+// inside a field are written as \t, \n, \r and \\ so every row stays on a
+// single line.
+class TsvExporter : public Exporter {
 public:
   std::string dump(Table &table) override {
-    std::string result{""};
-    apply_markdown_format(table);
-    result = table.str();
-    restore_table_format(table);
+    std::string result;
+    write(*table.table_, result, nullptr);
     return result;
   }
 
-private:
-  void add_alignment_header_row(Table &table) {
-    auto &rows = table.table_->rows_;
-
-    if (rows.size() >= 1) {
-      auto alignment_row = std::make_shared<Row>(table.table_->shared_from_this());
-
-      // Create alignment header cells
-      std::vector<std::string> alignment_cells{};
-      for (auto &cell : table[0]) {
-        auto format = cell.format();
-        if (format.font_align_.value() == FontAlign::left) {
-          alignment_cells.push_back(":----");
-        } else if (format.font_align_.value() == FontAlign::center) {
-          alignment_cells.push_back(":---:");
-        } else if (format.font_align_.value() == FontAlign::right) {
-          alignment_cells.push_back("----:");
-        }
-      }
-
-      // Add alignment header cells to alignment row
-      for (auto &c : alignment_cells) {
-        auto cell = std::make_shared<Cell>(alignment_row);
-        cell->format()
-            .hide_border_top()
-            .hide_border_bottom()
-            .border_left("|")
-            .border_right("|")
-            .column_separator("|")
-            .corner("|");
-        cell->set_text(c);
-        if (c == ":---:")
-          cell->format().font_align(FontAlign::center);
-        else if (c == "----:")
-          cell->format().font_align(FontAlign::right);
-        alignment_row->add_cell(cell);
-      }
-
-      // Insert alignment header row
-      if (rows.size() > 1)
-        rows.insert(rows.begin() + 1, alignment_row);
-      else
-        rows.push_back(alignment_row);
-    }
-  }
-
-  void remove_alignment_header_row(Table &table) {
-    auto &rows = table.table_->rows_;
-    table.table_->rows_.erase(rows.begin() + 1);
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
   }
 
-  void apply_markdown_format(Table &table) {
-    // Apply markdown format to cells in each row
-    for (auto row : table) {
-      for (auto &cell : row) {
-        auto format = cell.format();
-        formats_.push_back(format);
-        cell.format()
-            .hide_border_top()
-            .hide_border_bottom()
-            .border_left("|")
-            .border_right("|")
-            .column_separator("|")
-            .corner("|");
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    for (size_t i = 0; i < table.size(); ++i) {
+      for (size_t j = 0; j < table.row_size(i); ++j) {
+        if (j > 0)
+          buffer += '\t';
+        auto cell = table.cell_index(i, j);
+        table.visit_cell_text(cell, [&](const char *data, size_t size) {
+          add_field(buffer, data, size);
+        });
       }
+      buffer += '\n';
+      flush(buffer, stream, flush_size);
     }
-    // Add alignment header row at position 1
-    add_alignment_header_row(table);
   }
 
-  void restore_table_format(Table &table) {
-    // Remove alignment header row at position 1
-    remove_alignment_header_row(table);
-
-    // Restore original formatting for each cell
-    size_t format_index{0};
-    for (auto row : table) {
-      for (auto &cell : row) {
-        cell.format() = formats_[format_index];
-        format_index += 1;
+  static void add_field(std::string &buffer, const char *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      switch (data[i]) {
+      case '\t':
+        buffer += "\\t";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      default:
+        buffer += data[i];
       }
     }
   }
-
-  std::vector<Format> formats_;
 };
 
 } // namespace tabulate
@@ -7291,88 +10760,163 @@ SOFTWARE.
 */
 #pragma once
 // #include <tabulate/exporter.hpp>
-
-#if __cplusplus >= 201703L
-#include <optional>
-using std::optional;
-#else
-// #include <tabulate/optional_lite.hpp>
-using nonstd::optional;
-#endif
+// #include <tabulate/utf8.hpp>
 
 namespace tabulate {
 
-class LatexExporter : public Exporter {
-
-  static const char new_line = '\n';
-
+// A JSON array with one element per row. By default the first row holds the
+// keys and every following row becomes an object; without a header each row
+// becomes an array of strings.
+class JsonExporter : public Exporter {
 public:
   class ExportOptions {
   public:
-    ExportOptions &indentation(std::size_t value) {
-      indentation_ = value;
+    ExportOptions &header(bool value) {
+      header_ = value;
       return *this;
     }
 
   private:
-    friend class LatexExporter;
-    optional<size_t> indentation_;
+    friend class JsonExporter;
+    bool header_{true};
   };
 
+  JsonExporter() = default;
+
   ExportOptions &configure() { return options_; }
 
   std::string dump(Table &table) override {
-    std::string result{"\\begin{tabular}"};
-    result += new_line;
+    std::string result;
+    write(*table.table_, result, nullptr);
+    return result;
+  }
 
-    result += add_alignment_header(table);
-    result += new_line;
-    const auto rows = table.rows_;
-    // iterate content and put text into the table.
-    for (size_t i = 0; i < rows; i++) {
-      auto &row = table[i];
-      // apply row content indentation
-      if (options_.indentation_.has_value()) {
-        result += std::string(options_.indentation_.value(), ' ');
-      }
+  void dump(Table &table, std::ostream &stream) override {
+    std::string buffer;
+    buffer.reserve(flush_size);
+    write(*table.table_, buffer, &stream);
+    flush(buffer, &stream);
+  }
 
-      for (size_t j = 0; j < row.size(); j++) {
+protected:
+  // Newline-delimited JSON writes one row per line without the enclosing array
+  explicit JsonExporter(bool lines) : lines_(lines) {}
 
-        result += row[j].get_text();
+private:
+  void write(const TableInternal &table, std::string &buffer, std::ostream *stream) const {
+    if (!lines_)
+      buffer += '[';
+
+    size_t first_row = options_.header_ ? 1 : 0;
+    for (size_t i = first_row; i < table.size(); ++i) {
+      if (!lines_)
+        buffer += i > first_row ? ",\n" : "\n";
+      if (options_.header_)
+        add_object(buffer, table, i);
+      else
+        add_array(buffer, table, i);
+      if (lines_)
+        buffer += '\n';
+      flush(buffer, stream, flush_size);
+    }
 
-        // check column position, need "\\" at the end of each row
-        if (j < row.size() - 1) {
-          result += " & ";
+    if (!lines_)
+      buffer += table.size() > first_row ? "\n]\n" : "]\n";
+  }
+
+  static void add_object(std::string &buffer, const TableInternal &table, size_t row) {
+    buffer += '{';
+    for (size_t j = 0; j < table.row_size(row); ++j) {
+      if (j > 0)
+        buffer += ',';
+      // Columns without a header are keyed by their index
+      if (j < table.row_size(0)) {
+        auto key = table.cell_index(0, j);
+        table.visit_cell_text(key, [&](const char *data, size_t size) {
+          add_string(buffer, data, size);
+        });
+      } else {
+        auto key = std::to_string(j);
+        add_string(buffer, key.data(), key.size());
+      }
+      buffer += ':';
+      auto cell = table.cell_index(row, j);
+      table.visit_cell_text(cell, [&](const char *data, size_t size) {
+        add_string(buffer, data, size);
+      });
+    }
+    buffer += '}';
+  }
+
+  static void add_array(std::string &buffer, const TableInternal &table, size_t row) {
+    buffer += '[';
+    for (size_t j = 0; j < table.row_size(row); ++j) {
+      if (j > 0)
+        buffer += ',';
+      auto cell = table.cell_index(row, j);
+      table.visit_cell_text(cell, [&](const char *data, size_t size) {
+        add_string(buffer, data, size);
+      });
+    }
+    buffer += ']';
+  }
+
+  // Quotes text as a JSON string, valid UTF-8 is passed through as is and
+  // every byte of an invalid sequence is replaced by U+FFFD, so that the
+  // output stays valid JSON
+  static void add_string(std::string &buffer, const char *data, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    buffer += '"';
+    for (size_t i = 0; i < size; ++i) {
+      auto c = static_cast<unsigned char>(data[i]);
+      if (c >= 0x80) {
+        auto end = i;
+        char32_t code_point;
+        if (decode_utf8(data, size, end, code_point)) {
+          buffer.append(data + i, end - i);
+          i = end - 1;
         } else {
-          result += " \\\\";
+          buffer += "\xef\xbf\xbd";
         }
+        continue;
       }
-      result += new_line;
-    }
-
-    result += "\\end{tabular}";
-    return result;
-  }
-
-private:
-  std::string add_alignment_header(Table &table) {
-    std::string result{"{"};
-
-    for (auto &cell : table[0]) {
-      auto format = cell.format();
-      if (format.font_align_.value() == FontAlign::left) {
-        result += 'l';
-      } else if (format.font_align_.value() == FontAlign::center) {
-        result += 'c';
-      } else if (format.font_align_.value() == FontAlign::right) {
-        result += 'r';
+      switch (c) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\b':
+        buffer += "\\b";
+        break;
+      case '\f':
+        buffer += "\\f";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      case '\t':
+        buffer += "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          buffer += "\\u00";
+          buffer += hex[c >> 4];
+          buffer += hex[c & 0xf];
+        } else {
+          buffer += data[i];
+        }
       }
     }
-
-    result += "}";
-    return result;
+    buffer += '"';
   }
+
   ExportOptions options_;
+  bool lines_{false};
 };
 
 } // namespace tabulate
@@ -7410,107 +10954,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 #pragma once
-#include <algorithm>
-#include <optional>
-#include <sstream>
-#include <string>
-// #include <tabulate/exporter.hpp>
+// #include <tabulate/json_exporter.hpp>
 
 namespace tabulate {
 
-class AsciiDocExporter : public Exporter {
-
-  static const char new_line = '\n';
-
+// Newline-delimited JSON (NDJSON): one JSON value per row and per line, so
+// a consumer can process the rows as they arrive.
+class NdjsonExporter : public JsonExporter {
 public:
-  std::string dump(Table &table) override {
-    std::stringstream ss;
-    ss << add_alignment_header(table);
-    ss << new_line;
-
-    const auto rows = table.rows_;
-    // iterate content and put text into the table.
-    for (size_t row_index = 0; row_index < rows; row_index++) {
-      auto &row = table[row_index];
-
-      for (size_t cell_index = 0; cell_index < row.size(); cell_index++) {
-        ss << "|";
-        ss << add_formatted_cell(row[cell_index]);
-      }
-      ss << new_line;
-      if (row_index == 0) {
-        ss << new_line;
-      }
-    }
-
-    ss << "|===";
-    return ss.str();
-  }
-
-private:
-  std::string add_formatted_cell(Cell &cell) const {
-    std::stringstream ss;
-    auto format = cell.format();
-    std::string cell_string = cell.get_text();
-
-    auto font_style = format.font_style_.value();
-
-    bool format_bold = false;
-    bool format_italic = false;
-    std::for_each(font_style.begin(), font_style.end(), [&](FontStyle &style) {
-      if (style == FontStyle::bold) {
-        format_bold = true;
-      } else if (style == FontStyle::italic) {
-        format_italic = true;
-      }
-    });
-
-    if (format_bold) {
-      ss << '*';
-    }
-    if (format_italic) {
-      ss << '_';
-    }
-
-    ss << cell_string;
-    if (format_italic) {
-      ss << '_';
-    }
-    if (format_bold) {
-      ss << '*';
-    }
-    return ss.str();
-  }
-
-  std::string add_alignment_header(Table &table) {
-    std::stringstream ss;
-    ss << (R"([cols=")");
-
-    size_t column_count = table[0].size();
-    size_t column_index = 0;
-    for (auto &cell : table[0]) {
-      auto format = cell.format();
-
-      if (format.font_align_.value() == FontAlign::left) {
-        ss << '<';
-      } else if (format.font_align_.value() == FontAlign::center) {
-        ss << '^';
-      } else if (format.font_align_.value() == FontAlign::right) {
-        ss << '>';
-      }
-
-      ++column_index;
-      if (column_index != column_count) {
-        ss << ",";
-      }
-    }
-
-    ss << R"("])";
-    ss << new_line;
-    ss << "|===";
-
-    return ss.str();
-  }
+  NdjsonExporter() : JsonExporter(true) {}
 };
 
 } // namespace tabulate
@@ -0,0 +1,48 @@
+/*
+ * Font alignment of cell lines within their column
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+namespace {
+
+void
+testCenteredLineWiderThanColumn()
+{
+    // Natural lines are printed as they are, even when a fixed column width
+    // leaves them no room, a centered one must not crash
+    tabulate::Table table;
+    table.add_row({"abcdef\nx", "y"});
+    table.column(0).format().width(3).font_align(tabulate::FontAlign::center);
+    CHECK_TEXT(table.str(),
+               "+---+---+\n"
+               "| abcdef | y |\n"
+               "| x |   |\n"
+               "+---+---+");
+}
+
+void
+testCenteredLines()
+{
+    tabulate::Table table;
+    table.add_row({"ab", "abc"});
+    table.add_row({"abcde", "a"});
+    table.format().font_align(tabulate::FontAlign::center);
+    // The extra space of an odd spacing goes before the text
+    CHECK_TEXT(table.str(),
+               "+-------+-----+\n"
+               "|   ab  | abc |\n"
+               "+-------+-----+\n"
+               "| abcde |  a  |\n"
+               "+-------+-----+");
+}
+
+} // namespace
+
+int
+main()
+{
+    testCenteredLineWiderThanColumn();
+    testCenteredLines();
+    return failures();
+}
@@ -0,0 +1,74 @@
+/*
+ * Tables large enough to be laid out and rendered in bands of rows, which
+ * must render exactly what a single band does
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+const size_t rows = 4 * tabulate::min_band_rows + 17;
+
+// Colored, wrapped and nested cells over 4 bands of rows
+tabulate::Table
+largeTable()
+{
+    tabulate::Table table;
+    for (size_t i = 0; i < rows; ++i) {
+        if (i % 1000 == 0) {
+            tabulate::Table nested;
+            nested.add_row({"nested", std::to_string(i)});
+            nested[0][1].format().font_style({tabulate::FontStyle::italic});
+            table.add_row({std::to_string(i), "row with a nested table", nested});
+        } else {
+            table.add_row({std::to_string(i), "contact " + std::to_string(i) + " of the table",
+                           i % 3 == 0 ? "online" : "offline"});
+        }
+    }
+    table[0].format().font_style({tabulate::FontStyle::bold});
+    table.column(1).format().width(16);
+    for (size_t i = 3; i < rows; i += 7)
+        table[i][2].format().font_color(tabulate::Color::green).font_background_color(
+            tabulate::Color::red);
+    return table;
+}
+
+std::string
+render(const tabulate::Table& table)
+{
+    std::ostringstream stream;
+    stream << termcolor::colorize;
+    table.print(stream);
+    return stream.str();
+}
+
+void
+testBandsRenderLikeOneBand()
+{
+    auto table = largeTable();
+
+    tabulate::set_max_bands(1);
+    CHECK(tabulate::split_rows(rows).size() == 1);
+    auto expected = render(table);
+    auto shape = table.shape();
+    CHECK(expected.find("\033[32m") != std::string::npos);
+
+    tabulate::set_max_bands(4);
+    CHECK(tabulate::split_rows(rows).size() == 4);
+    CHECK_TEXT(render(table), expected);
+    CHECK(table.shape() == shape);
+
+    tabulate::set_max_bands(0);
+}
+
+} // namespace
+
+int
+main()
+{
+    testBandsRenderLikeOneBand();
+    return failures();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Reports a failed expectation and carries on, main() returns failures()
+inline int&
+failures()
+{
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" \
+                      << std::endl; \
+            ++failures(); \
+        } \
+    } while (false)
+
+// Compares rendered tables, printing both on a mismatch
+#define CHECK_TEXT(actual, expected) \
+    do { \
+        const std::string actual_ = (actual); \
+        const std::string expected_ = (expected); \
+        if (actual_ != expected_) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": got\n" \
+                      << actual_ << "\nexpected\n" \
+                      << expected_ << std::endl; \
+            ++failures(); \
+        } \
+    } while (false)
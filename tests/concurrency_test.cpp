@@ -0,0 +1,86 @@
+/*
+ * Concurrent layout and printing of tables, compared with single-threaded
+ * renders; build with -DTABULATE_TSAN=ON to run it under ThreadSanitizer
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const unsigned numThreads = 8;
+const int numRounds = 20;
+
+// A table with wrapped and colored cells and a nested table, whose formats
+// are only resolved when it is first laid out
+tabulate::Table
+makeTable(unsigned seed)
+{
+    tabulate::Table nested;
+    nested.add_row({"nested", "table " + std::to_string(seed)});
+    nested[0].format().font_color(tabulate::Color::green);
+
+    tabulate::Table table;
+    table.add_row({"id", "name", "status"});
+    for (unsigned i = 0; i < 40; ++i)
+        table.add_row({std::to_string(seed * 100 + i),
+                       "contact " + std::to_string(i) + " with a name long enough to wrap",
+                       i % 3 == 0 ? "online" : "offline"});
+    table.add_row({"", "", nested});
+    table[0].format().font_style({tabulate::FontStyle::bold});
+    table.column(1).format().width(20);
+    table.column(2).format().font_align(tabulate::FontAlign::center);
+    return table;
+}
+
+// What a thread checks of a table: its shape, computed from its layout, and
+// the table printed
+std::string
+render(const tabulate::Table& table)
+{
+    auto shape = table.shape();
+    return std::to_string(shape.first) + "x" + std::to_string(shape.second) + "\n" + table.str();
+}
+
+// Every thread lays out and prints a table of its own and the same shared
+// one, none of them printed before, several times over
+void
+testConcurrentRenders()
+{
+    std::vector<std::string> expected;
+    for (unsigned t = 0; t <= numThreads; ++t)
+        expected.push_back(render(makeTable(t)));
+
+    for (int round = 0; round < numRounds; ++round) {
+        const tabulate::Table shared = makeTable(numThreads);
+        std::atomic<int> mismatches {0};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                const tabulate::Table own = makeTable(t);
+                for (int i = 0; i < 3; ++i) {
+                    if (render(shared) != expected[numThreads])
+                        ++mismatches;
+                    if (render(own) != expected[t])
+                        ++mismatches;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        CHECK(mismatches == 0);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testConcurrentRenders();
+    return failures();
+}
@@ -0,0 +1,80 @@
+/*
+ * Formats changed through a Format& kept across prints
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+namespace {
+
+void
+testKeptCellFormat(bool cache_rows)
+{
+    tabulate::Table table;
+    table.cache_rows(cache_rows);
+    table.add_row({"a", "b"});
+    table.add_row({"c", "d"});
+    auto& format = table[0][0].format();
+    CHECK_TEXT(table.str(),
+               "+---+---+\n"
+               "| a | b |\n"
+               "+---+---+\n"
+               "| c | d |\n"
+               "+---+---+");
+
+    format.font_align(tabulate::FontAlign::right).width(8);
+    CHECK_TEXT(table.str(),
+               "+--------+---+\n"
+               "|      a | b |\n"
+               "+--------+---+\n"
+               "| c      | d |\n"
+               "+--------+---+");
+}
+
+void
+testKeptRowAndTableFormats(bool cache_rows)
+{
+    tabulate::Table table;
+    table.cache_rows(cache_rows);
+    table.add_row({"a", "b"});
+    table.add_row({"c", "d"});
+    auto& row = table[1].format();
+    auto& all = table.format();
+    table.str();
+
+    row.padding_left(3);
+    CHECK_TEXT(table.str(),
+               "+-----+-----+\n"
+               "| a   | b   |\n"
+               "+-----+-----+\n"
+               "|   c |   d |\n"
+               "+-----+-----+");
+
+    all.corner("*");
+    CHECK_TEXT(table.str(),
+               "*-----*-----*\n"
+               "| a   | b   |\n"
+               "*-----*-----*\n"
+               "|   c |   d |\n"
+               "*-----*-----*");
+
+    // Assigning a format changes it too
+    row = tabulate::Format();
+    CHECK_TEXT(table.str(),
+               "*---*---*\n"
+               "| a | b |\n"
+               "*---*---*\n"
+               "| c | d |\n"
+               "*---*---*");
+}
+
+} // namespace
+
+int
+main()
+{
+    testKeptCellFormat(false);
+    testKeptCellFormat(true);
+    testKeptRowAndTableFormats(false);
+    testKeptRowAndTableFormats(true);
+    return failures();
+}
@@ -0,0 +1,45 @@
+/*
+ * Strings written by the JSON and NDJSON exporters
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+namespace {
+
+void
+testEscapes()
+{
+    tabulate::Table table;
+    table.add_row({"key"});
+    table.add_row({"\"quoted\"\\\n\t\x01"});
+    tabulate::JsonExporter exporter;
+    CHECK_TEXT(exporter.dump(table), "[\n{\"key\":\"\\\"quoted\\\"\\\\\\n\\t\\u0001\"}\n]\n");
+}
+
+void
+testInvalidUtf8()
+{
+    // Valid sequences are kept, every byte of an invalid one becomes U+FFFD
+    tabulate::Table table;
+    table.add_row({"a\xff"
+                   "b",
+                   "\xe2\x82"
+                   "x\xc3\xa9\xf0\x9f\x98\x80",
+                   "\xed\xa0\x80"});
+    tabulate::NdjsonExporter exporter;
+    exporter.configure().header(false);
+    CHECK_TEXT(exporter.dump(table),
+               "[\"a\xef\xbf\xbd"
+               "b\",\"\xef\xbf\xbd\xef\xbf\xbd"
+               "x\xc3\xa9\xf0\x9f\x98\x80\",\"\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd\"]\n");
+}
+
+} // namespace
+
+int
+main()
+{
+    testEscapes();
+    testInvalidUtf8();
+    return failures();
+}
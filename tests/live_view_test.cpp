@@ -0,0 +1,53 @@
+/*
+ * Frames drawn by LiveView over the previous one
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <sstream>
+
+namespace {
+
+void
+testUnchangedFrame()
+{
+    std::ostringstream stream;
+    tabulate::LiveView view(stream);
+    tabulate::Table table;
+    table.add_row({"a", "b"});
+    view.render(table);
+    CHECK(view.last_update_size() > 0);
+
+    // Nothing at all is written for a frame identical to the previous one
+    stream.str("");
+    view.render(table);
+    CHECK(view.last_update_size() == 0);
+    CHECK_TEXT(stream.str(), "");
+}
+
+void
+testChangedCharacter()
+{
+    std::ostringstream stream;
+    tabulate::LiveView view(stream);
+    tabulate::Table table;
+    table.add_row({"a", "b"});
+    view.render(table);
+
+    // Only the changed character is rewritten, then the cursor goes back
+    // below the frame
+    stream.str("");
+    table[0][1].set_text("c");
+    view.render(table);
+    CHECK_TEXT(stream.str(), "\033[2A\r\033[7Gc\033[2B\r");
+}
+
+} // namespace
+
+int
+main()
+{
+    testUnchangedFrame();
+    testChangedCharacter();
+    return failures();
+}
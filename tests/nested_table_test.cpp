@@ -0,0 +1,105 @@
+/*
+ * Tables nested in cells, laid out for the width of their column
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+tabulate::Table
+innerTable()
+{
+    tabulate::Table inner;
+    inner.add_row({"alpha beta", "gamma"});
+    inner.add_row({"1", "delta epsilon"});
+    return inner;
+}
+
+void
+testNaturalWidth()
+{
+    tabulate::Table table;
+    table.add_row({"id", innerTable()});
+    CHECK_TEXT(table.str(),
+               "+----+--------------------------------+\n"
+               "| id | +------------+---------------+ |\n"
+               "|    | | alpha beta | gamma         | |\n"
+               "|    | +------------+---------------+ |\n"
+               "|    | | 1          | delta epsilon | |\n"
+               "|    | +------------+---------------+ |\n"
+               "+----+--------------------------------+");
+}
+
+void
+testNarrowColumn()
+{
+    // The widest columns of the nested table are narrowed until it fits
+    tabulate::Table table;
+    table.add_row({"id", innerTable()});
+    table.column(1).format().width(20);
+    CHECK_TEXT(table.str(),
+               "+----+--------------------+\n"
+               "| id | +-------+--------+ |\n"
+               "|    | | alpha | gamma  | |\n"
+               "|    | | beta  |        | |\n"
+               "|    | +-------+--------+ |\n"
+               "|    | | 1     | delta  | |\n"
+               "|    | |       | epsil- | |\n"
+               "|    | |       | on     | |\n"
+               "|    | +-------+--------+ |\n"
+               "+----+--------------------+");
+    auto shape = table.shape();
+    CHECK(shape.first == 27);
+    CHECK(shape.second == 10);
+}
+
+void
+testTooNarrowColumn()
+{
+    // Nested columns keep their padding and one character of text, the
+    // nested table then overflows the cell instead of losing its text
+    tabulate::Table inner;
+    inner.add_row({"alice", "bob", "carol"});
+    tabulate::Table table;
+    table.add_row({inner});
+    table.column(0).format().width(12);
+    auto text = table.str();
+    CHECK(text.find("| | a | b | c | |\n") != std::string::npos);
+    CHECK(text.find("| | e |   | l | |\n") != std::string::npos);
+
+    auto shape = table.shape();
+    auto width = tabulate::get_sequence_length(text.substr(0, text.find('\n')), "", true);
+    CHECK(shape.first == width);
+    CHECK(shape.second == static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+}
+
+void
+testAlignedInWideColumn()
+{
+    tabulate::Table inner;
+    inner.add_row({"in"});
+    tabulate::Table table;
+    table.add_row({inner});
+    table[0][0].format().width(12).font_align(tabulate::FontAlign::right);
+    CHECK_TEXT(table.str(),
+               "+------------+\n"
+               "|     +----+ |\n"
+               "|     | in | |\n"
+               "|     +----+ |\n"
+               "+------------+");
+}
+
+} // namespace
+
+int
+main()
+{
+    testNaturalWidth();
+    testNarrowColumn();
+    testTooNarrowColumn();
+    testAlignedInWideColumn();
+    return failures();
+}
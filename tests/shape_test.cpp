@@ -0,0 +1,121 @@
+/*
+ * The shape of tables, computed from their layout, against the width and the
+ * number of lines of what they print
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// Width of the first line printed and number of lines, the last one
+// included even if it is empty
+std::pair<size_t, size_t>
+measured(const tabulate::Table& table)
+{
+    auto text = table.str();
+    if (text.empty())
+        return {0, 0};
+    auto width = tabulate::get_sequence_length(text.substr(0, text.find('\n')), "", true);
+    return {width, static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1};
+}
+
+void
+testTabs()
+{
+    // Tabs are expanded to the next multiple of 8 columns of their line, in
+    // the layout and in what is printed alike
+    tabulate::Table table;
+    table.add_row({"a\tb", "c"});
+    table.add_row({"中\tx\n\ty", "d"});
+    CHECK(table.shape() == measured(table));
+    CHECK(table.str().find('\t') == std::string::npos);
+
+    table.format().multi_byte_characters(true);
+    CHECK(table.shape() == measured(table));
+}
+
+void
+testWideCharacters()
+{
+    tabulate::Table table;
+    table.add_row({"中文", "c"});
+    table.add_row({"ab", "文字文字"});
+    CHECK(table.shape() == measured(table));
+
+    table.format().multi_byte_characters(true);
+    CHECK(table.shape() == measured(table));
+}
+
+void
+testNestedTables()
+{
+    tabulate::Table nested;
+    nested.add_row({"a\tb", "中文"});
+    nested.add_row({"c", "d"});
+    nested.format().multi_byte_characters(true);
+
+    tabulate::Table table;
+    table.add_row({"x", nested});
+    table.add_row({"y\tz", "w"});
+    CHECK(table.shape() == measured(table));
+}
+
+void
+testEmptyLastLine()
+{
+    // A hidden bottom border leaves an empty last line, counted like print
+    // does
+    tabulate::Table table;
+    table.add_row({"x", "c"});
+    table.format().hide_border();
+    CHECK(table.shape() == measured(table));
+
+    tabulate::Table empty;
+    empty.add_row({"", ""});
+    empty.format().hide_border();
+    CHECK(empty.shape() == measured(empty));
+
+    tabulate::Table newline;
+    newline.add_row({"x\n", "c"});
+    CHECK(newline.shape() == measured(newline));
+    newline.format().border_bottom("").corner_bottom_left("").corner_bottom_right("");
+    CHECK(newline.shape() == measured(newline));
+}
+
+void
+testColumnNoWiderThanPadding()
+{
+    // Cells left no room for text by their padding are printed empty, their
+    // rows are not dropped
+    tabulate::Table table;
+    table.add_row({"ab", "cd"});
+    table.add_row({"", "e"});
+    table.format().width(2).padding_left(1).padding_right(1);
+    const std::string expected = "+--+--+\n"
+                                 "|  |  |\n"
+                                 "+--+--+\n"
+                                 "|  |  |\n"
+                                 "+--+--+";
+    CHECK_TEXT(table.str(), expected);
+    CHECK(table.shape() == measured(table));
+
+    table.format().overflow(tabulate::Overflow::truncate);
+    CHECK_TEXT(table.str(), expected);
+    CHECK(table.shape() == measured(table));
+}
+
+} // namespace
+
+int
+main()
+{
+    testTabs();
+    testWideCharacters();
+    testNestedTables();
+    testEmptyLastLine();
+    testColumnNoWiderThanPadding();
+    return failures();
+}
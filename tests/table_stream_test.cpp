@@ -0,0 +1,77 @@
+/*
+ * Tables printed row by row by a TableStream
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::vector<std::string>>
+listingRows()
+{
+    // The longest cells come after the rows the stream samples
+    return {{"alice", "ring:1"},
+            {"bob", "ring:2"},
+            {"carol", "ring:3"},
+            {"a much longer alias", "ring:0123456789abcdef"}};
+}
+
+void
+testMeasuredRows()
+{
+    // Every row of the model is measured, the stream prints what a Table of
+    // the same rows does, each line ending with '\n'
+    auto rows = listingRows();
+    auto model = tabulate::make_table_model(rows.size(), 2, [&](size_t row, size_t column) {
+        return rows[row][column];
+    });
+
+    std::ostringstream stream;
+    {
+        tabulate::TableStream table(stream, 2);
+        table.format().multi_byte_characters(true);
+        table.add_row({"alias", "uri"});
+        table.add_measured_rows(model);
+    }
+
+    tabulate::Table expected;
+    expected.format().multi_byte_characters(true);
+    expected.add_row({"alias", "uri"});
+    expected.add_rows(rows);
+    CHECK_TEXT(stream.str(), expected.str() + "\n");
+}
+
+void
+testMeasuredTypedRows()
+{
+    // Fixed width columns keep their width, the others are measured
+    using Uri = tabulate::Field<std::string, tabulate::FontAlign::right, 10>;
+    using Schema = tabulate::TableSchema<tabulate::BorderTheme::none, std::string, Uri>;
+    auto rows = listingRows();
+    auto model = tabulate::make_table_model<Schema>(rows.size(), [&](size_t row, size_t column) {
+        return rows[row][column];
+    });
+
+    std::ostringstream stream;
+    tabulate::TypedTable<Schema, tabulate::TableStream> listing(stream, 2);
+    listing.add_measured_rows(model);
+    listing.target().close();
+
+    tabulate::TypedTable<Schema> expected;
+    expected.add_rows(model);
+    CHECK_TEXT(stream.str(), expected.target().str() + "\n");
+}
+
+} // namespace
+
+int
+main()
+{
+    testMeasuredRows();
+    testMeasuredTypedRows();
+    return failures();
+}
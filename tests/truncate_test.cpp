@@ -0,0 +1,99 @@
+/*
+ * Cells cut to the width of their column by Overflow::truncate
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <string>
+
+namespace {
+
+// A single cell table of a column of the given width, padding included
+tabulate::Table
+truncated(const std::string& text, size_t width)
+{
+    tabulate::Table table;
+    table.add_row({text});
+    table.column(0).format().width(width).overflow(tabulate::Overflow::truncate);
+    return table;
+}
+
+void
+testExactWidth()
+{
+    // Text as wide as the column is left whole, one more character is cut
+    CHECK_TEXT(truncated("abcde", 7).str(),
+               "+-------+\n"
+               "| abcde |\n"
+               "+-------+");
+    CHECK_TEXT(truncated("abcdef", 7).str(),
+               "+-------+\n"
+               "| ab... |\n"
+               "+-------+");
+}
+
+void
+testWideCharacterAtTheCut()
+{
+    // 中 would end past the room left before the ellipsis, it is left out
+    // whole and the line is padded to the width of the column
+    auto table = truncated("ab中文", 6);
+    table.format().multi_byte_characters(true);
+    CHECK_TEXT(table.str(),
+               "+------+\n"
+               "| ab…  |\n"
+               "+------+");
+
+    // Without multi-byte character support, a sequence counts as wide as it
+    // is long, and is not split either
+    CHECK_TEXT(truncated("ab中文", 8).str(),
+               "+--------+\n"
+               "| ab...  |\n"
+               "+--------+");
+}
+
+void
+testMultiLineCell()
+{
+    // Only the first line is kept, ending with the ellipsis even though it
+    // fits on its own
+    CHECK_TEXT(truncated("first line\nsecond", 14).str(),
+               "+--------------+\n"
+               "| first lin... |\n"
+               "+--------------+");
+}
+
+void
+testMultiByteColumn()
+{
+    // A fixed width column of a listing with multi-byte character support
+    // cuts CJK and emoji text to the width of the column in display columns,
+    // so that its rows line up
+    using Message = tabulate::Field<std::string, tabulate::FontAlign::left, 12>;
+    using Schema = tabulate::TableSchema<tabulate::BorderTheme::ascii, std::string, Message>;
+    tabulate::TypedTable<Schema> listing;
+    listing.target().format().multi_byte_characters(true);
+    listing.add_row("alice", "hello there you");
+    listing.add_row("ボブ", "こんにちは世界");
+    listing.add_row("carol", "🙂🙂🙂🙂🙂🙂");
+    CHECK_TEXT(listing.target().str(),
+               "+-------+------------+\n"
+               "| alice | hello the… |\n"
+               "+-------+------------+\n"
+               "| ボブ  | こんにち…  |\n"
+               "+-------+------------+\n"
+               "| carol | 🙂🙂🙂🙂…  |\n"
+               "+-------+------------+");
+}
+
+} // namespace
+
+int
+main()
+{
+    testExactWidth();
+    testWideCharacterAtTheCut();
+    testMultiLineCell();
+    testMultiByteColumn();
+    return failures();
+}
@@ -0,0 +1,106 @@
+/*
+ * Searches and scrolling of a Viewport
+ */
+#include "check.h"
+#include "tabulate.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void
+testFindAcrossWrappedLines()
+{
+    tabulate::Table table;
+    for (int i = 0; i < 20; ++i)
+        table.add_row({std::to_string(i), "x"});
+    table[12][1].set_text("the quick brown fox jumps");
+    table.column(1).format().width(12);
+
+    // "quick brown" is word wrapped over two lines
+    tabulate::Viewport viewport(table, 5);
+    CHECK(viewport.find("quick brown"));
+    CHECK(viewport.top_row() == 12);
+    CHECK(!viewport.find("quick  brown"));
+    CHECK(viewport.top_row() == 12);
+}
+
+void
+testWindowOfTable()
+{
+    // The rows in the window are laid out on their own, for the columns
+    // measured on every row, and print the lines of the whole table
+    tabulate::Table table;
+    for (int i = 0; i < 1500; ++i) {
+        if (i % 97 == 0)
+            table.add_row({std::to_string(i), "a longer cell wrapped over lines\tend"});
+        else if (i % 89 == 0)
+            table.add_row({"first\nsecond", "x"});
+        else
+            table.add_row({std::to_string(i), "x"});
+    }
+    table.column(1).format().width(14);
+
+    std::vector<std::string> lines;
+    std::istringstream text(table.str());
+    for (std::string line; std::getline(text, line);)
+        lines.push_back(line);
+
+    tabulate::Viewport viewport(table, 3);
+    CHECK(viewport.num_lines() == lines.size());
+    for (size_t line = 0; line + 3 <= lines.size(); line += 7) {
+        viewport.scroll_to(line);
+        std::ostringstream window;
+        viewport.print(window);
+        CHECK_TEXT(window.str(), lines[line] + "\n" + lines[line + 1] + "\n" + lines[line + 2]);
+    }
+}
+
+void
+testModelRows()
+{
+    // The rows of a model follow the header of the table and are rendered
+    // like rows of the table itself
+    auto cell = [](size_t row, size_t column) {
+        return column == 0 ? std::to_string(row) : "contact " + std::to_string(row);
+    };
+    tabulate::Table full;
+    full.add_row({"id", "name"});
+    for (size_t i = 0; i < 30; ++i)
+        full.add_row({cell(i, 0), cell(i, 1)});
+    full.column(1).format().width(8);
+
+    tabulate::Table header;
+    header.add_row({"id", "name"});
+    header.column(1).format().width(8);
+    auto model = tabulate::make_table_model(30, 2, cell);
+
+    tabulate::Viewport expected(full, 6);
+    tabulate::Viewport viewport(header, model, 6, 4);
+    CHECK(viewport.num_lines() == expected.num_lines());
+    for (size_t line = 0; line < expected.num_lines(); line += 5) {
+        expected.scroll_to(line);
+        viewport.scroll_to(line);
+        std::ostringstream a, b;
+        expected.print(a);
+        viewport.print(b);
+        CHECK_TEXT(b.str(), a.str());
+    }
+
+    CHECK(viewport.find("contact 17"));
+    CHECK(viewport.top_row() == 18);
+    CHECK(header.shape().second == 3);
+}
+
+} // namespace
+
+int
+main()
+{
+    testFindAcrossWrappedLines();
+    testWindowOfTable();
+    testModelRows();
+    return failures();
+}